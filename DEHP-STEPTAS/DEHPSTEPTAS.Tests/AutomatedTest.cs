@@ -1288,8 +1288,9 @@ namespace DEHPSTEPTAS.AutomatedTests
             compareStepFilesViewModel.SetFiles(pathToStepTasFiles + "SCupdated.stp", pathToStepTasFiles + "SCupdated.stp");  // Same files
             Assert.IsTrue(compareStepFilesViewModel.Process());
 
-            compareStepFilesViewModel.SetFiles(pathToStepTasFiles + "SCbase.stp", pathToStepTasFiles + "SCupdated.stp");  // Same files
-            Assert.IsFalse(compareStepFilesViewModel.Process());
+            compareStepFilesViewModel.SetFiles(pathToStepTasFiles + "SCbase.stp", pathToStepTasFiles + "SCupdated.stp");  // Different files
+            Assert.IsTrue(compareStepFilesViewModel.Process());
+            Assert.IsTrue(compareStepFilesViewModel.Step3DHLR.Any(x => x.PartOf != StepTasDiffRowViewModel.PartOfKind.BOTH));
             
 
             // Dst Extraction test
@@ -41,6 +41,7 @@ namespace DEHPSTEPTAS
     using DEHPSTEPTAS.Services.DstHubService;
     using DEHPSTEPTAS.Services.FileStoreService;
     using DEHPSTEPTAS.Settings;
+    using DEHPSTEPTAS.StepTas;
     using DEHPSTEPTAS.ViewModel;
     using DEHPSTEPTAS.ViewModel.Dialogs;
     using DEHPSTEPTAS.ViewModel.Dialogs.Interfaces;
@@ -73,6 +74,7 @@ namespace DEHPSTEPTAS
         public App(ContainerBuilder containerBuilder = null)
         {
             this.LogAppStart();
+            NativeLogSink.Install();
 
             this.Exit += this.OnExit;
             AppDomain.CurrentDomain.UnhandledException += this.CurrentDomainUnhandledException;
@@ -130,6 +132,7 @@ namespace DEHPSTEPTAS
             this.logger.Info("--------------------------------------------------------");
             this.logger.Info("Leaving application");
             this.logger.Info("--------------------------------------------------------");
+            NativeLogSink.Uninstall();
         }
 
         /// <summary>
@@ -113,10 +113,12 @@ namespace DEHPSTEPTAS.Builds.HighLevelRepresentationBuilder
             if (steptasfile == null) return new List<StepTasRowData>();
             var entries = new List<StepTasRowData>();
             List<int> ids = new(); ;  // SPA: Why this structure?
-            foreach (var n in steptasfile.nodelist)
+            var table = steptasfile.NodeTable;
+            // row 0 is the file root, the rows start at the model root
+            for (int row = 1; row < table.Count; row++)
             {
 
-                var entry = new StepTasRowData(n);
+                var entry = new StepTasRowData(table, row);
                 ids.Add(entry.ID);
            
                 entries.Add(entry);
@@ -27,6 +27,7 @@
 
 using CDP4Common.EngineeringModelData;
 using DEHPSTEPTAS.StepTas;
+using NLog;
 using System;
 
 using System.Collections.Generic;
@@ -63,6 +64,8 @@ namespace DEHPSTEPTAS.Extraction
         }
 
 
+        private readonly Logger logger = LogManager.GetCurrentClassLogger();
+
         private List<node> ThermalNodeList = new();
         public List<node> nodes { get => ThermalNodeList; }
         public string name { get; private set; }
@@ -71,70 +74,56 @@ namespace DEHPSTEPTAS.Extraction
 
 
         /**
-         * <summary>Find the node referenced by the step-tas reference parameter</summary>
+         * <summary>Find the node referenced by the step-tas reference parameter; null if there is none</summary>
+         * <remarks>
+         * The path is the one of the row (named parents, '/' terminated) and is first resolved exactly by the
+         * native path index. A reference that does not resolve, for instance one written against an earlier
+         * layout of the tree, falls back to the former loose match: the path names in pre-order, not necessarily
+         * nested, then the first node named <paramref name="name"/>.
+         * </remarks>
          */
-
-        private TasNode FindReferenceNode(string name, string[] path, TasNode rootnode)
+        private TasNode FindReferenceNode(string name, string path, StepTasFile file)
         {
-            List<TasNode> subtree = StepTasFile.FlatTree(rootnode);
+            TasNode node = file.ResolvePath(path + "/" + name);
+            if (node != null)
+            {
+                return node;
+            }
+
+            string[] names = path.Split('/');
             int pindex = 0;
-            foreach (TasNode node in subtree)
+            foreach (TasNode candidate in StepTasFile.FlatTree(file.GetRootNode()))
             {
-                if (pindex < path.Length - 1 && node.name == path[pindex])
+                if (pindex < names.Length - 1 && candidate.name == names[pindex])
                 {
                     pindex++;
-
                 }
-                if (pindex == path.Length - 1 && node.name == name)
+
+                if (pindex == names.Length - 1 && candidate.name == name)
                 {
-                    return node;
+                    logger.Info("Step-Tas reference {0} is not at {1}, using the node found by name", name, path);
+                    return candidate;
                 }
             }
 
             return null;
-            /*if (path.Length == 1 && rootnode.name == name) return rootnode;
-            string childname = path.First();
-            for (int i = 0; i < rootnode.childrenCount(); i++)
-            {
-                TasNode node = rootnode.getChildNode(i);
-                TasNode parent = node.parent;
-                if (parent != null && childname == parent.name)
-                {
-                    path = path.Skip(1).ToArray();
-                    return FindReferenceNode(name, path, node);
-                }
-            }
-            return null;*/
         }
 
 
 
 
 
-        private void FindThermalNodes(TasNode rootnode)
+        private void FindThermalNodes(TasNode rootnode, StepTasFile file)
         {
-            List<TasNode> subtree = StepTasFile.FlatTree(rootnode);
-            string sname = "";
-            foreach (var node in subtree)
+            // range lookup in the native thermal node index, no walk of the subtree
+            ThermalNodeSet thermalNodes = file.GetThermalNodes(rootnode);
+            for (int i = 0; i < thermalNodes.size(); i++)
             {
-                if (node.getNodeType() == NodeType.BOUNDEDSURFACE)
-                {
-                    sname = node.name;
-                }
-
-                if (node is Face)
-                {
-                    Face af = (Face)node;
-                    string nodenumber = af.nrf_network_node;
-                    if (nodenumber != "")
-                    {
-                        node rnode = new();
-                        rnode.number = nodenumber;
-                        rnode.meshedsurface = sname;
-                        rnode.model = af.nrf_model;
-                        ThermalNodeList.Add(rnode);
-                    }
-                }
+                node rnode = new();
+                rnode.number = thermalNodes.getNetworkNodeName(i);
+                rnode.meshedsurface = thermalNodes.getMeshedSurfaceName(i);
+                rnode.model = thermalNodes.getModel(i);
+                ThermalNodeList.Add(rnode);
             }
             ThermalNodeList = ThermalNodeList.Distinct().ToList();
         }
@@ -150,15 +139,21 @@ namespace DEHPSTEPTAS.Extraction
 
             var valSet = stepTasParam.QueryParameterBaseValueSet(null, fsTasRef);
             string spath = valSet.ActualValue[1].ToString();
-            string[] path = spath.Split('/');
             string name = valSet.ActualValue[0].ToString();
 
             this.name = name;
 
             if (name != "-") // It means that the reference is not defined (--> impossible to retrieve the nodes)
             {
-                TasNode referencednode = FindReferenceNode(name, path, file.GetRootNode());
-                FindThermalNodes(referencednode);
+                TasNode referencednode = FindReferenceNode(name, spath, file);
+                if (referencednode != null)
+                {
+                    FindThermalNodes(referencednode, file);
+                }
+                else
+                {
+                    logger.Warn("Step-Tas reference {0} at {1} is not in the file, it has no thermal nodes", name, spath);
+                }
             }
 
             if (propertyParam is not null)
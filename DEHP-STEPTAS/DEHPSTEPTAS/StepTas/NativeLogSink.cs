@@ -0,0 +1,91 @@
+﻿// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="NativeLogSink.cs" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+// 
+//    Part of the code was based on the work performed by RHEA as result
+//    of the collaboration in the context of "Digital Engineering Hub Pathfinder"
+//    by Sam Gerené, Alex Vorobiev, Alexander van Delft and Nathanael Smiechowski.
+// 
+//    This file is part of DEHP STEP-TAS adapter project.
+// 
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+// 
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+// 
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+using NLog;
+
+namespace DEHPSTEPTAS.StepTas
+{
+    /**
+     * <summary>Forwards the diagnostics of the native STEP-TAS interface to NLog. The native side calls
+     * <see cref="write"/> from its log writer thread</summary>
+     */
+    public class NativeLogSink : LogSink
+    {
+        private static readonly Logger logger = LogManager.GetLogger("StepTasInterface");
+
+        // the native side only keeps a pointer, the proxy must stay reachable while installed
+        private static NativeLogSink installed;
+
+        public override void write(LogLevel level, string message)
+        {
+            logger.Log(ToNLog(level), message);
+        }
+
+        /**
+         * <summary>Routes the native messages to NLog. The native level follows the lowest level NLog has enabled
+         * for the StepTasInterface logger, so filtered messages are not even formatted</summary>
+         */
+        public static void Install()
+        {
+            installed ??= new NativeLogSink();
+            NativeLog.setSink(installed);
+            NativeLog.setLevel(NativeLevel());
+        }
+
+        /**
+         * <summary>Writes the pending native messages and restores the native stderr sink</summary>
+         */
+        public static void Uninstall()
+        {
+            NativeLog.flush();
+            NativeLog.setSink(null);
+            installed = null;
+        }
+
+        private static LogLevel NativeLevel()
+        {
+            if (logger.IsTraceEnabled) return LogLevel.LOG_TRACE;
+            if (logger.IsDebugEnabled) return LogLevel.LOG_DEBUG;
+            if (logger.IsInfoEnabled) return LogLevel.LOG_INFO;
+            if (logger.IsWarnEnabled) return LogLevel.LOG_WARNING;
+            if (logger.IsErrorEnabled) return LogLevel.LOG_ERROR;
+            return LogLevel.LOG_OFF;
+        }
+
+        private static NLog.LogLevel ToNLog(LogLevel level)
+        {
+            return level switch
+            {
+                LogLevel.LOG_TRACE => NLog.LogLevel.Trace,
+                LogLevel.LOG_DEBUG => NLog.LogLevel.Debug,
+                LogLevel.LOG_INFO => NLog.LogLevel.Info,
+                LogLevel.LOG_WARNING => NLog.LogLevel.Warn,
+                LogLevel.LOG_ERROR => NLog.LogLevel.Error,
+                _ => NLog.LogLevel.Off
+            };
+        }
+    }
+}
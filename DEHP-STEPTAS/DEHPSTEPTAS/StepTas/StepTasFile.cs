@@ -28,6 +28,7 @@
 
 using System;
 using System.Collections.Generic;
+using System.Threading.Tasks;
 
 namespace DEHPSTEPTAS.StepTas
 {
@@ -35,11 +36,26 @@ namespace DEHPSTEPTAS.StepTas
     {
         private FileData filed;
         private TasNode rootnode;
-        public List<TasNode> nodelist;
+        private StepTasNodeTable nodeTable;
+
+        /**
+         * <summary>Flat copy of the node tree, built on first use. With <see cref="LoadOptions.lazy"/> this reads the whole model</summary>
+         */
+        public StepTasNodeTable NodeTable => nodeTable ??= new StepTasNodeTable(filed);
         public bool HasFailed; // ADD GETTER
         public String ErrorMessage;
         public String FileName;
         public FileHeader HeaderInfo;
+
+        /**
+         * <summary>Instance counts per entity type of the file, from the native pre-scan</summary>
+         */
+        public FileStatistics Statistics => filed.getStatistics();
+
+        /**
+         * <summary>Phase times and processed entity counts of the load, only filled when <see cref="LoadOptions.collectStatistics"/> was set</summary>
+         */
+        public LoadStatistics LoadStatistics => filed.getLoadStatistics();
         /*
          * Method to transform the tree node structure into a flat list of nodes.
          */
@@ -56,15 +72,178 @@ namespace DEHPSTEPTAS.StepTas
             return nodes;
         }
 
-        public StepTasFile(String filename)
+        /**
+         * <summary>Header of a file without loading its model, for listings. Only the HEADER section is read</summary>
+         */
+        public static FileHeader ReadHeader(String filename)
+        {
+            return FileData.readHeaderOnly(filename);
+        }
+
+        public StepTasFile(String filename) : this(filename, new LoadOptions())
+        {
+        }
+
+        /**
+         * <summary>Loads a file with explicit native options, e.g. <see cref="LoadOptions.threadCount"/> to build the tree in parallel</summary>
+         */
+        public StepTasFile(String filename, LoadOptions options)
         {
             this.FileName = filename;
-            filed = new FileData(filename);
-            rootnode = filed.getRoot().getChildNode(0);rootnode.parent = null;            
-            HeaderInfo = filed.header;
-            nodelist = FlatTree(rootnode);
+            filed = new FileData(filename, options);
+            rootnode = filed.getRoot().getChildNode(0);
+            HeaderInfo = filed.getHeader();
+
+        }
 
+        private StepTasFile(String filename, FileData loaded)
+        {
+            this.FileName = filename;
+            filed = loaded;
+            rootnode = filed.getRoot().getChildNode(0);
+            HeaderInfo = filed.getHeader();
         }
+
+        private StepTasFile(String filename, String error)
+        {
+            this.FileName = filename;
+            HasFailed = true;
+            ErrorMessage = error;
+        }
+
+        /**
+         * <summary>Loads several files concurrently on <paramref name="threadCount"/> native workers (0 for one per core),
+         * starting a file only while the estimated footprint of the running loads stays under <paramref name="memoryBudget"/>
+         * bytes (0 for no limit). The files are returned as each one finishes; those that could not be loaded have <see cref="HasFailed"/> set</summary>
+         */
+        public static IEnumerable<StepTasFile> LoadEach(IList<String> filenames, int threadCount, long memoryBudget)
+        {
+            foreach (var loaded in LoadIndexed(filenames, threadCount, memoryBudget))
+            {
+                yield return loaded.Value;
+            }
+        }
+
+        /**
+         * <summary>Same as <see cref="LoadEach"/>, the files are returned in the order of <paramref name="filenames"/> once all are loaded</summary>
+         */
+        public static StepTasFile[] LoadAll(IList<String> filenames, int threadCount, long memoryBudget)
+        {
+            var files = new StepTasFile[filenames.Count];
+
+            foreach (var loaded in LoadIndexed(filenames, threadCount, memoryBudget))
+            {
+                files[loaded.Key] = loaded.Value;
+            }
+
+            return files;
+        }
+
+        private static IEnumerable<KeyValuePair<int, StepTasFile>> LoadIndexed(IList<String> filenames, int threadCount, long memoryBudget)
+        {
+            using var loader = new FileLoader(threadCount, memoryBudget);
+
+            foreach (var filename in filenames)
+            {
+                loader.add(filename);
+            }
+
+            for (var index = loader.waitNext(); index >= 0; index = loader.waitNext())
+            {
+                var loaded = loader.takeResult(index);
+
+                yield return new KeyValuePair<int, StepTasFile>(index, loaded == null
+                    ? new StepTasFile(filenames[index], $"cannot load {filenames[index]} ({loader.getStatus(index)})")
+                    : new StepTasFile(filenames[index], loaded));
+            }
+        }
+
+        /**
+         * <summary>Forwards the native progress reports, which arrive on the loading thread</summary>
+         */
+        private class LoadProgress : ProgressCallback
+        {
+            private readonly Action<LoadPhase, int> progress;
+
+            public LoadProgress(Action<LoadPhase, int> progress)
+            {
+                this.progress = progress;
+            }
+
+            public override void onProgress(LoadPhase phase, int percent, int processed, int total)
+            {
+                progress?.Invoke(phase, percent);
+            }
+        }
+
+        /**
+         * <summary>Loads a file on a native background thread. <paramref name="progress"/> gets the percentage of each
+         * <see cref="LoadPhase"/> and is called from that thread. Cancelling stops the load at the next entity and releases
+         * what was built so far; the task then throws <see cref="OperationCanceledException"/></summary>
+         */
+        public static Task<StepTasFile> LoadAsync(String filename, LoadOptions options, Action<LoadPhase, int> progress, System.Threading.CancellationToken cancellationToken)
+        {
+            return Task.Run(() =>
+            {
+                var callback = new LoadProgress(progress);
+                using var job = new LoadJob(filename, options, callback);
+                using (cancellationToken.Register(job.cancel))
+                {
+                    job.start();
+                    var status = job.wait();
+                    GC.KeepAlive(callback);
+
+                    if (status == LoadStatus.LOAD_CANCELLED)
+                    {
+                        throw new OperationCanceledException(cancellationToken);
+                    }
+
+                    var loaded = job.takeResult();
+
+                    if (loaded == null)
+                    {
+                        throw new InvalidOperationException($"Error loading STEP file: {filename}");
+                    }
+
+                    return new StepTasFile(filename, loaded);
+                }
+            });
+        }
+        /**
+         * <summary>Node with the given Step id, null if there is none</summary>
+         */
+        public TasNode FindById(int id)
+        {
+            return filed.findById(id);
+        }
+
+        /**
+         * <summary>Node at a '/' separated path of node names, as in <see cref="ViewModel.Rows.StepTasRowData.Path"/>; null if there is none</summary>
+         */
+        public TasNode ResolvePath(string path)
+        {
+            return filed.resolvePath(path);
+        }
+
+        /**
+         * <summary>Distinct thermal network nodes of the faces under a node, computed once per node by the native index</summary>
+         */
+        public ThermalNodeSet GetThermalNodes(TasNode element)
+        {
+            return filed.getThermalNodeIndex().getThermalNodes(element);
+        }
+
+        /**
+         * <summary>Native hashed diff from this file to <paramref name="other"/>; sets the <see cref="DataStatus"/> of the nodes of both files</summary>
+         */
+        public TreeDiff Diff(StepTasFile other)
+        {
+            // the statuses change: the next NodeTable access copies them again
+            nodeTable = null;
+            other.nodeTable = null;
+            return filed.diff(other.filed);
+        }
+
         public TasNode GetRootNode()
         {
 
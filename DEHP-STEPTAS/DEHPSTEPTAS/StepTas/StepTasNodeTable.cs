@@ -0,0 +1,100 @@
+﻿// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="StepTasNodeTable.cs" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+// 
+//    Part of the code was based on the work performed by RHEA as result
+//    of the collaboration in the context of "Digital Engineering Hub Pathfinder"
+//    by Sam Gerené, Alex Vorobiev, Alexander van Delft and Nathanael Smiechowski.
+// 
+//    This file is part of DEHP STEP-TAS adapter project.
+// 
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+// 
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+// 
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+using System.Text;
+
+namespace DEHPSTEPTAS.StepTas
+{
+    /// <summary>
+    /// Managed copy of the native <see cref="NodeTable"/>: the whole node tree in pre-order,
+    /// fetched with one bulk copy per column instead of one P/Invoke per node and per field.
+    /// </summary>
+    public class StepTasNodeTable
+    {
+        private readonly NodeTable table;
+        private readonly int[] ids;
+        private readonly int[] parents;
+        private readonly int[] types;
+        private readonly int[] status;
+        private readonly int[] offsets;
+        private readonly byte[] blob;
+
+        /// <summary>
+        /// Number of rows, row 0 is the root of the tree
+        /// </summary>
+        public int Count { get; }
+
+        public StepTasNodeTable(FileData file)
+        {
+            table = file.getNodeTable();
+            Count = table.size();
+
+            ids = new int[Count];
+            parents = new int[Count];
+            types = new int[Count];
+            status = new int[Count];
+            offsets = new int[Count * (int)NodeTableField.FIELD_COUNT + 1];
+            blob = new byte[table.blobSize()];
+
+            table.copyIds(ids);
+            table.copyParents(parents);
+            table.copyNodeTypes(types);
+            table.copyStatus(status);
+            table.copyStringOffsets(offsets);
+            table.copyBlob(blob);
+        }
+
+        public int GetId(int row) => ids[row];
+
+        /// <summary>
+        /// Gets the parent row, -1 for the root
+        /// </summary>
+        public int GetParent(int row) => parents[row];
+
+        public NodeType GetNodeType(int row) => (NodeType)types[row];
+
+        public DataStatus GetStatus(int row) => (DataStatus)status[row];
+
+        public string GetString(int row, NodeTableField field)
+        {
+            int index = row * (int)NodeTableField.FIELD_COUNT + (int)field;
+            return Encoding.UTF8.GetString(blob, offsets[index], offsets[index + 1] - offsets[index]);
+        }
+
+        public string GetName(int row) => GetString(row, NodeTableField.FIELD_NAME);
+
+        public string GetLabel(int row) => GetString(row, NodeTableField.FIELD_LABEL);
+
+        public string GetClassType(int row) => GetString(row, NodeTableField.FIELD_CLASSTYPE);
+
+        public string GetDescription(int row) => GetString(row, NodeTableField.FIELD_DESCRIPTION);
+
+        /// <summary>
+        /// Gets the native node proxy of a row, only needed for node specific data
+        /// </summary>
+        public TasNode GetNode(int row) => table.getNode(row);
+    }
+}
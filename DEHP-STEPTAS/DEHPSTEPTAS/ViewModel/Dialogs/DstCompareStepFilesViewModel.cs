@@ -42,12 +42,6 @@ namespace DEHPSTEPTAS.Dialogs
 {
     public class DstCompareStepFilesViewModel : ReactiveObject, IDstCompareStepFilesViewModel
     {
-        /** <summary>
-         * A list used to store the nodes from both files. Used to initialize the fullNodeLookUp
-         * </summary>
-         */
-
-        private readonly List<StepTasDiffRowViewModel> fullNodeList = new();
         /// <summary>
         /// The <see cref="IStatusBarControlViewModel"/> instance
         /// </summary>
@@ -89,18 +83,6 @@ namespace DEHPSTEPTAS.Dialogs
          **/
         private readonly IDstController dstController;
 
-        /* *<summary>
-         * Use to the the HLR data for the first file
-         * </summary>
-         * */
-        private List<StepTasRowData> FirstStepData;
-
-        /* *<summary>
-     * Use to the the HLR data for the second file
-     * </summary>
-     * */
-        private List<StepTasRowData> SecondStepData;
-
         private List<StepTasDiffRowViewModel> step3DHLR = new();
 
         /// <summary>
@@ -113,181 +95,6 @@ namespace DEHPSTEPTAS.Dialogs
             private set => this.RaiseAndSetIfChanged(ref this.step3DHLR, value);
         }
 
-        #region Private tree management methods
-        /**<summary>
-         * Retrieve the children of a node (using the list in StepTasTree) filtering out the node that are not PartOf the given kind.
-         * </summary>
-         */
-
-        private List<StepTasDiffRowViewModel> GetVmChildren(int parentID, PartOfKind kind)
-        {
-            List<StepTasDiffRowViewModel> returnList = new();
-            foreach (var node in Step3DHLR)
-            {
-                if (node.ParentID == parentID && node.PartOf == kind)
-                {
-                    returnList.Add(node);
-                }
-            }
-            return returnList;
-        }
-
-        /**<summary>
-        * This method is use to change the "PartOf" member of a complete subtree that has been relocated.
-        </summary>
-
-        */
-
-        private void TagSubTree(StepTasDiffRowViewModel root, PartOfKind kind)
-        {
-            int parentID = root.ID;
-            root.PartOf = kind;
-            List<StepTasDiffRowViewModel> children = GetVmChildren(parentID, PartOfKind.SECONDTORELOCATE);
-            foreach (var child in children)
-            {
-                TagSubTree(child, kind);
-            }
-        }
-
-        /**<summary>
-         * Connect the newnode as a chid of rootnote then change all the new subtree as belonging to the Second file.
-         * </summary>
-         */
-
-        private void AddNode(StepTasDiffRowViewModel rootnode, StepTasDiffRowViewModel newnode)
-        {
-  //temp remov comment          newnode.ParentID = rootnode.ID; // we just change the parent ID
-            TagSubTree(newnode, PartOfKind.SECOND);
-        }
-
-        private bool RelocateNode(StepTasDiffRowViewModel node)
-        {
-            string parentSignature = node.Signature.Substring(0, node.Signature.LastIndexOf('/'));
-
-            StepTasDiffRowViewModel targetNode = null;
-            foreach (var treenode in Step3DHLR)
-            {
-                if (treenode.Signature == parentSignature && treenode.PartOf == PartOfKind.BOTH)
-                {
-                    logger.Info("Step Diff: relocating the branch {0} from the second file to {1}", node.Signature, treenode.Signature);
-                    targetNode = treenode;
-                    break;
-                }
-            }
-            if (targetNode == null)
-            {
-                return false;// cannot relocate... there is a problem
-            }
-
-            AddNode(targetNode, node);
-            return true;
-        }
-
-        /**<summary>
-         * This method try to relocate a nodes whose signature is one of  shortest one among the nodes to relocate.
-         * We then reconnect all of its children to the reallocated nodes. (From shortest descending the tree towards the leafs)
-         * This method will be called repeatedly until there no nodes tagged with the type SECONDTORELOCATE
-         * </summary>
-         */
-
-        private bool TryToRelocateShortestPath()
-        {
-            StepTasDiffRowViewModel shortest = null;
-            int min = Int32.MaxValue;
-            foreach (var node in step3DHLR)
-            {
-                // Nodes that belongs only to the first file are tagged as being part of the first
-                // file we need only to relocate nodes from the second file.
-                if (node.PartOf == PartOfKind.SECONDTORELOCATE)
-                {
-                    int pathLenght = node.Signature.Split('/').Count();
-                    if (pathLenght < min)
-                    {
-                        shortest = node;
-                        min = pathLenght;
-                        logger.Info("Step Diff: relocating the branch {0} from the second file", node.Signature);
-                    }
-                }
-            }
-            if (min == Int32.MaxValue)
-            {
-                return false;// we do not have a node to relocate
-            }
-            return RelocateNode(shortest);
-        }
-
-        /** <summary>
-         * Main method the build the diff in itself.
-         * The algorithm is based on the nodes signature wich is a string that contains the path of the nodes.
-         * This current version is based on unique signature for each file. All the nodes names are unique.
-         * If the files contain a lot of duplicate names with some big structures modification this could trigger the detection of
-         * more differences that there actually is.
-         *
-         * </summary>
-         */
-
-        private bool BuildDiff()
-        {
-         ILookup<string, StepTasDiffRowViewModel> fullNodeLookup= fullNodeList.ToLookup(x => (x).Signature, x => x);
-            // first we consider that all the nodes that have the same signature are equivalent.
-                        
-            bool noCommonRoot = false;
-            bool onlyBoth = true;
-
-            foreach (var values in fullNodeLookup)
-            {
-                if (values.AsEnumerable().Count() > 1)
-                {
-                    values.AsEnumerable().First().PartOf = PartOfKind.BOTH;
-                    Step3DHLR.Add(values.AsEnumerable().First());
-                }
-                else
-                {
-                    if (values.AsEnumerable().First().Signature.Split('/').Count() == 1)
-                    {
-                        noCommonRoot = true; 
-                        
-                    }
-                    Step3DHLR.Add(values.AsEnumerable().First());
-                }
-            }
-
-            if (noCommonRoot)
-            {
-                if (Application.ResourceAssembly != null)
-                {
-                    Application.Current.Dispatcher.Invoke(() => statusBar.Append("Both step files looks completely different."));
-                }
-                logger.Info("Step Diff: the two files have no common root node.");
-            }
-            else
-            {
-                foreach (var node in step3DHLR)
-                {
-                    if (node.PartOf == PartOfKind.SECOND)
-                    {
-                        onlyBoth = false;
-                        node.PartOf = PartOfKind.SECONDTORELOCATE;   // UNCOMMENT!!!
-                    }
-                }
-                if (onlyBoth  )                  
-                {
-                    if( Application.ResourceAssembly != null){
-
-                        Application.Current.Dispatcher.Invoke(() => statusBar.Append("Both step files looks the same.")); 
-                    }
-                    logger.Info("Step Diff: the two files are the same.");
-                    
-                }
-                while (!onlyBoth && TryToRelocateShortestPath()) { };
-            }
-            // we check if we have some duplicate keys. If we have duplicate we should no try to
-            // display the dialog box as it will crash. We normally have no duplicates but this is a
-            // security check.
-            bool anyDuplicate = step3DHLR.GroupBy(x => x.ID).Any(g => g.Count() > 1);
-            return anyDuplicate;
-        }
-        #endregion Private tree management methods
         #region consructor
         /**<summary>
          * The constructor.
@@ -300,6 +107,14 @@ namespace DEHPSTEPTAS.Dialogs
         }
         #endregion constructor
 
+        private void ShowStatus(string message)
+        {
+            if (Application.ResourceAssembly != null)
+            {
+                Application.Current.Dispatcher.Invoke(() => statusBar.Append(message));
+            }
+        }
+
         /** <summary>
          * Sets the path of the files to compare then read them and update the header viewmodel.
          * </summary>
@@ -307,8 +122,9 @@ namespace DEHPSTEPTAS.Dialogs
         #region Public methods
         public bool SetFiles(string path1, string path2)
         {
-            FirstFile = new StepTasFile(path1);
-            SecondFile = new StepTasFile(path2);
+            var files = StepTasFile.LoadAll(new[] { path1, path2 }, 2, 0);
+            FirstFile = files[0];
+            SecondFile = files[1];
             if (FirstFile.HasFailed || SecondFile.HasFailed)
             {
                 return false;
@@ -321,49 +137,83 @@ namespace DEHPSTEPTAS.Dialogs
 
             FirstFileHeader.UpdateHeader();
             SecondFileHeader.UpdateHeader();
-            var hlr1 = new HighLevelRepresentationBuilder();
-            var hlr2 = new HighLevelRepresentationBuilder();
-            var firstHlrData = hlr1.CreateHLR(FirstFile, 1);
-            var secondHlrData = hlr2.CreateHLR(SecondFile, firstHlrData.Count + 2);
-            SetHlrData(firstHlrData, secondHlrData);
             return true;
         }
 
         /** <summary>
-         * Set the HLR data for both files
-         * </summary>
-         */
-
-        public void SetHlrData(List<StepTasRowData> first, List<StepTasRowData> second)
-        {
-            this.FirstStepData = first;
-            this.SecondStepData = second;
-        }
-
-        /** <summary>
-         * Do the file comparison in itself.
+         * Do the file comparison in itself, with the native diff of the two trees (<see cref="StepTasFile.Diff"/>).
+         * The rows of the first file are in both files unless they were deleted or moved away. The subtrees
+         * added to the second file, or moved to another place in it, hang under the row of their parent in
+         * the first file.
          * </summary>
          */
 
         public bool Process()
         {
-            Step3DHLR?.Clear();
+            var diff = FirstFile.Diff(SecondFile);
 
-            fullNodeList.Clear();
+            // the node tables are copied after the diff, with its statuses
+            var first = new HighLevelRepresentationBuilder().CreateHLR(FirstFile);
+            var second = new HighLevelRepresentationBuilder().CreateHLR(SecondFile);
+            var rows = new List<StepTasDiffRowViewModel>();
 
+            var onlyFirst = new HashSet<int>();
+            var firstBySignature = new Dictionary<string, int>();
+            int nextId = 1;
+            foreach (var data in first)
+            {
+                if (data.Status == DataStatus.Deleted || data.Status == DataStatus.Moved || onlyFirst.Contains(data.ParentRow))
+                {
+                    onlyFirst.Add(data.Row);
+                }
+                rows.Add(new StepTasDiffRowViewModel(data, onlyFirst.Contains(data.Row) ? PartOfKind.FIRST : PartOfKind.BOTH));
+                string signature = data.GetSignature();
+                if (!firstBySignature.ContainsKey(signature))
+                {
+                    firstBySignature[signature] = data.ID;
+                }
+                nextId = Math.Max(nextId, data.ID + 1);
+            }
 
-           
+            // the STEP ids of the second file overlap the first ones, its rows get keys above them
+            var secondByRow = second.ToDictionary(x => x.Row);
+            var secondKeys = new Dictionary<int, int>();
+            foreach (var data in second)
+            {
+                if (!secondKeys.TryGetValue(data.ParentRow, out int parentKey))
+                {
+                    if (data.Status != DataStatus.Added && data.Status != DataStatus.Moved) continue;
+                    // the paired parent in the first file, the top of the tree when there is none
+                    parentKey = 0;
+                    if (secondByRow.TryGetValue(data.ParentRow, out var parent))
+                    {
+                        firstBySignature.TryGetValue(parent.GetSignature(), out parentKey);
+                    }
+                }
+                secondKeys[data.Row] = nextId;
+                rows.Add(new StepTasDiffRowViewModel(data, PartOfKind.SECOND, nextId++, parentKey));
+            }
+            Step3DHLR = rows;
 
-            foreach (var dataNode in FirstStepData)
+            if (first.Count > 0 && first[0].Status == DataStatus.Deleted)
             {
-                fullNodeList.Add(new StepTasDiffRowViewModel(dataNode, PartOfKind.FIRST));
+                ShowStatus("Both step files looks completely different.");
+                logger.Info("Step Diff: the two files have no common root node.");
             }
-            foreach (var dataNode in SecondStepData)
+            else if (diff.size() == 0)
             {
-                fullNodeList.Add(new StepTasDiffRowViewModel(dataNode, PartOfKind.SECOND));
+                ShowStatus("Both step files looks the same.");
+                logger.Info("Step Diff: the two files are the same.");
             }
-            return !BuildDiff();// we have duplicates that's bad.
+            else
+            {
+                logger.Info("Step Diff: {0} changed subtrees, {1} identical subtrees skipped", diff.size(), diff.identicalSubtrees());
+            }
+
+            // a duplicate key would crash the tree control, it should not happen but this is a security check
+            bool anyDuplicate = rows.GroupBy(x => x.ID).Any(g => g.Count() > 1);
+            return !anyDuplicate;
         }
         #endregion Public Methods
     }
-}
\ No newline at end of file
+}
@@ -44,10 +44,14 @@ namespace DEHPSTEPTAS.ViewModel.Rows
     public class StepTasDiffRowViewModel : ReactiveObject
     {
        
-        public enum PartOfKind {  BOTH,FIRST,SECOND,SECONDTORELOCATE}
+        public enum PartOfKind {  BOTH,FIRST,SECOND}
 
         private readonly StepTasRowData stepRowData;
 
+        private readonly int id;
+
+        private readonly int parentId;
+
         #region HLR Tree Indexes
 
         /// <summary>
@@ -97,10 +101,13 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         /// </summary>
         public int StepId { get => stepRowData.ID; }
 
-        public int ID { get => stepRowData.ID; }
+        /// <summary>
+        /// Key of the row in the comparison tree. The rows of the second file are renumbered,
+        /// the STEP ids of the two files overlap.
+        /// </summary>
+        public int ID { get => id; }
 
-        
-        public int ParentID { get => stepRowData.ParentID; }
+        public int ParentID { get => parentId; }
 
         /// <summary>
         /// Compose a reduced description of the <see cref="STNode"/>
@@ -130,10 +137,16 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         #region Constructor
 
         public StepTasDiffRowViewModel(StepTasRowData rowdata, PartOfKind partOf)
+            : this(rowdata, partOf, rowdata.ID, rowdata.ParentID)
+        {
+        }
+
+        public StepTasDiffRowViewModel(StepTasRowData rowdata, PartOfKind partOf, int id, int parentId)
         {
             this.stepRowData = rowdata;
             this.PartOf = partOf;
-          
+            this.id = id;
+            this.parentId = parentId;
         }
 
         #endregion Constructor
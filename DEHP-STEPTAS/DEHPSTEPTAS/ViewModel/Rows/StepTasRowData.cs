@@ -26,15 +26,37 @@
 // </copyright>
 // --------------------------------------------------------------------------------------------------------------------
 //using STEP3DAdapter;
+using DEHPSTEPTAS.StepTas;
 using System;
 
 namespace DEHPSTEPTAS.ViewModel.Rows
 {
     public class StepTasRowData
     {
-        public TasNode Node { get; }
+        private readonly StepTasNodeTable table;
 
-        public int ID { get => (int)Node.id; }
+        private readonly int row;
+
+        private TasNode node;
+
+        /// <summary>
+        /// The native node, only fetched when node specific data is needed
+        /// </summary>
+        public TasNode Node { get => node ??= table.GetNode(row); }
+
+        public int ID { get => table.GetId(row); }
+
+        /// <summary>
+        /// Row in the <see cref="StepTasNodeTable"/>, and the row of the parent (-1 for the root)
+        /// </summary>
+        public int Row { get => row; }
+
+        public int ParentRow { get => table.GetParent(row); }
+
+        /// <summary>
+        /// Status set by the last <see cref="StepTasFile.Diff"/> before the table was copied
+        /// </summary>
+        public DataStatus Status { get => table.GetStatus(row); }
 
         /// <summary>
         /// Auxiliary parent index for tree control.
@@ -43,8 +65,15 @@ namespace DEHPSTEPTAS.ViewModel.Rows
 
         private int getParentId()
         {
-            if (Node.parent == null) return 0;
-            return Node.parent.id;
+            // the model root has no parent row in the HLR
+            int parent = table.GetParent(row);
+            if (parent <= 0) return 0;
+            return table.GetId(parent);
+        }
+
+        private static bool IsBoundedSurface(NodeType type)
+        {
+            return type == NodeType.BOUNDEDSURFACE || type >= NodeType.RECTANGLE;
         }
 
         /// <summary>
@@ -70,13 +99,13 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         /// <summary>
         /// Get Part name.
         /// </summary>
-        public string Name { get => Node.name; }
+        public string Name { get; }
 
         public string Sides { get => getSides(); }
 
         private String getSides()
         {
-            if (Node is BoundedSurface)
+            if (IsBoundedSurface(table.GetNodeType(row)))
             {
                 return ((BoundedSurface)Node).activeside.ToString();
             }
@@ -86,7 +115,7 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         /// <summary>
         /// Get short entity type.
         /// </summary>
-        public string Type { get => Node.classType; }
+        public string Type { get; }
 
         public string ThermalNodes { get => getNodes(); }
 
@@ -100,17 +129,17 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         /// <summary>
         /// Get STEP entity type.
         /// </summary>
-        public string RepresentationType { get => Node.description; }
+        public string RepresentationType { get => description; }
 
         /// <summary>
         /// Get STEP entity file Id.
         /// </summary>
-        public String StepId { get => (Node.entity < 0) ? "" : $"{Node.classType}(#{Node.entity})"; }
+        public String StepId { get => (ID < 0) ? "" : $"{Type}(#{ID})"; }
 
         /// <summary>
         /// Compose a reduced description of the <see cref="STNode"/>
         /// </summary>
-        public string Description => (Node.description == "") ? $"{Node.label}" : $"{Node.description}";
+        public string Description => (description == "") ? $"{label}" : $"{description}";
 
         /// <summary>
         /// Gets a label of association
@@ -123,13 +152,13 @@ namespace DEHPSTEPTAS.ViewModel.Rows
 
         public string RelationLabel
         {
-            get => $"{Node?.label}";
+            get => $"{label}";
         }
 
         /// <summary>
         /// Gets the Get STEP entity file Id of the relation (NAUO)
         /// </summary>
-        public string RelationId { get => $"{Node?.label}"; }
+        public string RelationId { get => $"{label}"; }
 
         /** <summary>
          * Retrieves the signature of the node. It is basically the full path of the node, made using uniquenames.
@@ -138,7 +167,7 @@ namespace DEHPSTEPTAS.ViewModel.Rows
 
         public string GetSignature()
         {
-            return getPath() + "/" + Node.name;
+            return getPath() + "/" + Name;
 
             //return getPath() + Node.name;
         }
@@ -147,14 +176,15 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         private string getPath()
         {
             string path = "";
-            TasNode curnode = Node;
-            while (curnode.parent != null)
+            int parent = table.GetParent(row);
+            while (parent > 0)
             {
-                if (curnode.parent.name.Length > 0)
+                string parentName = table.GetName(parent);
+                if (parentName.Length > 0)
                 {
-                    path = curnode.parent.name + "/" + path;
+                    path = parentName + "/" + path;
                 }
-                curnode = curnode.parent;
+                parent = table.GetParent(parent);
             }
 
             return path;
@@ -164,8 +194,9 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         {
 
             
-            if(Node is Face)
-                return ((Face)Node).nrf_network_node;
+            // the name of a face row is its network node, read from the table so the Face is not built
+            if(table.GetNodeType(row) == NodeType.FACE)
+                return table.GetName(row);
             else return "";
         }
 
@@ -173,15 +204,15 @@ namespace DEHPSTEPTAS.ViewModel.Rows
         private string getMaterialName()
         {
 
-            if (Node.classType.Contains("/Side"))
+            if (Type.Contains("/Side"))
             {
                 
-                TasNode parent = Node.getParent();
-                if (parent is BoundedSurface)    // SPA: add "bs" in order to avoid first line in the block? 
+                int parent = table.GetParent(row);
+                if (parent >= 0 && IsBoundedSurface(table.GetNodeType(parent)))    // SPA: add "bs" in order to avoid first line in the block? 
                 {
-                    BoundedSurface bs = (BoundedSurface)parent;
-                    if (Node.classType.Contains("/Side1")) return bs.side1_material_name;
-                    if (Node.classType.Contains("/Side2")) return bs.side2_material_name;
+                    BoundedSurface bs = (BoundedSurface)table.GetNode(parent);
+                    if (Type.Contains("/Side1")) return bs.side1_material_name;
+                    if (Type.Contains("/Side2")) return bs.side2_material_name;
 
                 }
 
@@ -199,17 +230,15 @@ namespace DEHPSTEPTAS.ViewModel.Rows
             {
                 return localnodes;
             }
-            if (Node.classType.Contains("/Side"))
+            if (Type.Contains("/Side"))
             {
                 string subnodes = "";                 // SPA: It looks that we create this string but it is never used....
-                for(int i = 0; i < Node.childrenCount(); i++)
+                FaceTable faces = Node.getFaceTable();
+                int count = faces != null ? faces.size() : 0;
+                for(int i = 0; i < count; i++)
                 {
-                    TasNode tn = Node.getChildNode(i);
-                    if (tn is Face)
-                    {
-                        subnodes+= ((Face)tn).nrf_network_node;
-                    }
-                    if (i < (Node.childrenCount() - 1)) subnodes = subnodes + ",";
+                    subnodes+= faces.getNetworkNode(i);
+                    if (i < (count - 1)) subnodes = subnodes + ",";
 
                 }
             }
@@ -218,12 +247,20 @@ namespace DEHPSTEPTAS.ViewModel.Rows
 
 
 
-        public StepTasRowData(TasNode node)
+        private readonly string label;
+
+        private readonly string description;
+
+        public StepTasRowData(StepTasNodeTable table, int row)
         {
-            this.Node = node;
+            this.table = table;
+            this.row = row;
+            this.Name = table.GetName(row);
+            this.Type = table.GetClassType(row);
+            this.label = table.GetLabel(row);
+            this.description = table.GetDescription(row);
             //    this.Relation = relation;
             this.UniqueName = this.Name;
-            node.entity = node.id;
 
             //this.InstanceName; = string.IsNullOrWhiteSpace(this.RelationLabel) ?this.Name : $"{this.Name}({this.RelationLabel})";
             // this.InstancePath = string.IsNullOrWhiteSpace(parentPath) ? this.InstanceName : $"{parentPath}.{this.InstanceName}";
@@ -0,0 +1,257 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="conductorgraph.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "conductorgraph.hxx"
+#include "thermalnodeindex.hxx"
+
+using namespace sti;
+
+int ConductorGraph::addNode(const std::string& model, const std::string& name)
+{
+	auto inserted = m_nodes.emplace(model + '\n' + name, (int)m_names.size());
+	if (inserted.second)
+	{
+		m_names.push_back(name);
+		m_models.push_back(model);
+	}
+	return inserted.first->second;
+}
+
+void ConductorGraph::addConductor(int from, int to, double value)
+{
+	if (!valid(from) || !valid(to)) return;
+	m_from.push_back(from);
+	m_to.push_back(to);
+	m_conductor_values.push_back(value);
+	m_linked = false;
+}
+
+// Counting sort of the edges by source node, then each row is sorted by neighbour. The conductor
+// number breaks ties so the order does not depend on the sort implementation. A conductor from a
+// node to itself is a single edge.
+//
+void ConductorGraph::finalize()
+{
+	size_t nodes = m_names.size();
+	m_offsets.assign(nodes + 1, 0);
+	for (size_t conductor = 0; conductor < m_from.size(); conductor++)
+	{
+		m_offsets[m_from[conductor] + 1]++;
+		if (m_to[conductor] != m_from[conductor]) m_offsets[m_to[conductor] + 1]++;
+	}
+	std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+	size_t edges = (size_t)m_offsets[nodes];
+	m_neighbours.resize(edges);
+	m_values.resize(edges);
+	m_edge_conductors.resize(edges);
+	std::vector<int> cursor(m_offsets.begin(), m_offsets.end() - 1);
+	for (size_t conductor = 0; conductor < m_from.size(); conductor++)
+	{
+		int from = m_from[conductor], to = m_to[conductor];
+		int edge = cursor[from]++;
+		m_neighbours[edge] = to;
+		m_edge_conductors[edge] = (int)conductor;
+		if (to != from)
+		{
+			edge = cursor[to]++;
+			m_neighbours[edge] = from;
+			m_edge_conductors[edge] = (int)conductor;
+		}
+	}
+
+	std::vector<int> order;
+	for (size_t node = 0; node < nodes; node++)
+	{
+		int first = m_offsets[node], last = m_offsets[node + 1];
+		if (last - first < 2) continue;
+		order.resize(last - first);
+		for (int edge = first; edge < last; edge++) order[edge - first] = m_edge_conductors[edge];
+		// the conductors of a row are distinct, so sorting them by (neighbour, conductor) is a total order
+		std::sort(order.begin(), order.end(), [this, node](int a, int b)
+			{
+				int na = (m_from[a] == (int)node) ? m_to[a] : m_from[a];
+				int nb = (m_from[b] == (int)node) ? m_to[b] : m_from[b];
+				return na != nb ? na < nb : a < b;
+			});
+		for (int edge = first; edge < last; edge++)
+		{
+			int conductor = order[edge - first];
+			m_edge_conductors[edge] = conductor;
+			m_neighbours[edge] = (m_from[conductor] == (int)node) ? m_to[conductor] : m_from[conductor];
+		}
+	}
+	for (size_t edge = 0; edge < edges; edge++)
+	{
+		m_values[edge] = m_conductor_values[m_edge_conductors[edge]];
+	}
+}
+
+void ConductorGraph::link(ThermalNodeIndex& index)
+{
+	m_network_nodes.resize(m_names.size());
+	m_by_network_node.clear();
+	for (size_t node = 0; node < m_names.size(); node++)
+	{
+		int networkNode = index.findNetworkNode(m_models[node], m_names[node]);
+		m_network_nodes[node] = networkNode;
+		if (networkNode >= 0) m_by_network_node.emplace(networkNode, (int)node);
+	}
+	m_linked = true;
+}
+
+int ConductorGraph::nodeCount()
+{
+	return (int)m_names.size();
+}
+
+std::string ConductorGraph::getNodeName(int node)
+{
+	return valid(node) ? m_names[node] : "";
+}
+
+std::string ConductorGraph::getNodeModel(int node)
+{
+	return valid(node) ? m_models[node] : "";
+}
+
+int ConductorGraph::findNode(const std::string& model, const std::string& name)
+{
+	auto it = m_nodes.find(model + '\n' + name);
+	return it == m_nodes.end() ? -1 : it->second;
+}
+
+int ConductorGraph::getNetworkNode(int node)
+{
+	return (valid(node) && node < (int)m_network_nodes.size()) ? m_network_nodes[node] : -1;
+}
+
+int ConductorGraph::findByNetworkNode(int networkNode)
+{
+	auto it = m_by_network_node.find(networkNode);
+	return it == m_by_network_node.end() ? -1 : it->second;
+}
+
+int ConductorGraph::conductorCount()
+{
+	return (int)m_from.size();
+}
+
+int ConductorGraph::getConductorFrom(int conductor)
+{
+	return (conductor < 0 || conductor >= conductorCount()) ? -1 : m_from[conductor];
+}
+
+int ConductorGraph::getConductorTo(int conductor)
+{
+	return (conductor < 0 || conductor >= conductorCount()) ? -1 : m_to[conductor];
+}
+
+double ConductorGraph::getConductorValue(int conductor)
+{
+	return (conductor < 0 || conductor >= conductorCount()) ? 0.0 : m_conductor_values[conductor];
+}
+
+int ConductorGraph::edgeCount()
+{
+	return (int)m_neighbours.size();
+}
+
+int ConductorGraph::degree(int node)
+{
+	return (valid(node) && node + 1 < (int)m_offsets.size()) ? m_offsets[node + 1] - m_offsets[node] : 0;
+}
+
+int ConductorGraph::firstEdge(int node)
+{
+	return (valid(node) && node < (int)m_offsets.size()) ? m_offsets[node] : 0;
+}
+
+int ConductorGraph::getNeighbour(int edge)
+{
+	return (edge < 0 || edge >= edgeCount()) ? -1 : m_neighbours[edge];
+}
+
+double ConductorGraph::getValue(int edge)
+{
+	return (edge < 0 || edge >= edgeCount()) ? 0.0 : m_values[edge];
+}
+
+int ConductorGraph::getEdgeConductor(int edge)
+{
+	return (edge < 0 || edge >= edgeCount()) ? -1 : m_edge_conductors[edge];
+}
+
+// the row is sorted by neighbour, the conductors to the other node are one run found by binary search
+double ConductorGraph::getCoupling(int node, int other)
+{
+	if (degree(node) == 0 || !valid(other)) return 0.0;
+	auto first = m_neighbours.begin() + m_offsets[node];
+	auto last = m_neighbours.begin() + m_offsets[node + 1];
+	auto range = std::equal_range(first, last, other);
+	double total = 0.0;
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		double value = m_values[it - m_neighbours.begin()];
+		if (!std::isnan(value)) total += value;
+	}
+	return total;
+}
+
+double ConductorGraph::getTotalCoupling(int node)
+{
+	double total = 0.0;
+	for (int edge = firstEdge(node); edge < firstEdge(node) + degree(node); edge++)
+	{
+		if (!std::isnan(m_values[edge])) total += m_values[edge];
+	}
+	return total;
+}
+
+void ConductorGraph::copyOffsets(int* offsets)
+{
+	if (!m_offsets.empty() && offsets != nullptr)
+	{
+		std::memcpy(offsets, m_offsets.data(), m_offsets.size() * sizeof(int));
+	}
+}
+
+void ConductorGraph::copyNeighbours(int* neighbours)
+{
+	if (!m_neighbours.empty() && neighbours != nullptr)
+	{
+		std::memcpy(neighbours, m_neighbours.data(), m_neighbours.size() * sizeof(int));
+	}
+}
+
+void ConductorGraph::copyValues(double* values)
+{
+	if (!m_values.empty() && values != nullptr)
+	{
+		std::memcpy(values, m_values.data(), m_values.size() * sizeof(double));
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="conductorgraph.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Conductor graph
+// The couplings of the network models other than the meshed geometric model, as a graph over the network
+// nodes. The nodes are numbered in order of first appearance and keyed like the faces' network nodes, by
+// containing model name and node id, so a node is linked to the same network node of the ThermalNodeIndex.
+// The conductors are kept as read, and in compressed sparse row form: every conductor is an edge from each of
+// its two nodes, the edges of a node are consecutive and sorted by neighbour, with a parallel value array.
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sti
+{
+	class ThermalNodeIndex;
+
+	class ConductorGraph
+	{
+	public:
+		int nodeCount();
+		std::string getNodeName(int node);
+		std::string getNodeModel(int node);
+		// -1 when unknown
+		int findNode(const std::string& model, const std::string& name);
+		// the same node in the ThermalNodeIndex, -1 when no face carries it
+		int getNetworkNode(int node);
+		// -1 when the network node has no conductor and is not listed by a network model
+		int findByNetworkNode(int networkNode);
+
+		// conductors in file order
+		int conductorCount();
+		int getConductorFrom(int conductor);
+		int getConductorTo(int conductor);
+		double getConductorValue(int conductor); // NaN when the file gives no value
+
+		// edges of node n are [firstEdge(n), firstEdge(n) + degree(n))
+		int edgeCount();
+		int degree(int node);
+		int firstEdge(int node);
+		int getNeighbour(int edge);
+		double getValue(int edge);
+		int getEdgeConductor(int edge);
+		// sum of the conductor values between two nodes, conductors without a value count as 0
+		double getCoupling(int node, int other);
+		// sum of the conductor values of a node
+		double getTotalCoupling(int node);
+
+		// nodeCount() + 1 offsets, edgeCount() neighbours and values
+		void copyOffsets(int* offsets);
+		void copyNeighbours(int* neighbours);
+		void copyValues(double* values);
+
+#ifndef SWIG
+		// parser side
+		int addNode(const std::string& model, const std::string& name);
+		void addConductor(int from, int to, double value);
+		// builds the rows, after the last conductor
+		void finalize();
+		// numbers of the same nodes in the ThermalNodeIndex, which must be finalized
+		void link(ThermalNodeIndex& index);
+		bool isLinked() const { return m_linked; }
+	private:
+		bool valid(int node) const { return node >= 0 && node < (int)m_names.size(); }
+
+		std::vector<std::string> m_names;
+		std::vector<std::string> m_models;
+		std::unordered_map<std::string, int> m_nodes; // model + '\n' + name -> node
+		std::vector<int> m_from;
+		std::vector<int> m_to;
+		std::vector<double> m_conductor_values;
+		std::vector<int> m_offsets;
+		std::vector<int> m_neighbours;
+		std::vector<double> m_values;
+		std::vector<int> m_edge_conductors;
+		std::vector<int> m_network_nodes;
+		std::unordered_map<int, int> m_by_network_node;
+		bool m_linked = false;
+#endif
+	};
+}
@@ -0,0 +1,41 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="entitykind.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <unordered_map>
+
+#include "entitykind.hxx"
+
+EntityKind entityKind(std::string_view typeName)
+{
+	// the names are literals, the views stay valid for the lifetime of the library
+	static const std::unordered_map<std::string_view, EntityKind> kinds = [] {
+		std::unordered_map<std::string_view, EntityKind> map;
+		for (const EntityKindName& entry : EntityKindNames)
+		{
+			map.emplace(entry.name, entry.kind);
+		}
+		return map;
+	}();
+
+	auto it = kinds.find(typeName);
+	return it == kinds.end() ? EntityKind::UNKNOWN : it->second;
+}
@@ -0,0 +1,98 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="entitykind.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// Entity kinds
+// The parser dispatches on a small integer instead of comparing type() strings. A type name is turned into its
+// EntityKind once per entity by a hash lookup on a string_view (no allocation), the handlers then downcast the
+// entity they were given instead of fetching it again from the data set.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <string_view>
+#include "logger.hxx"
+
+enum class EntityKind
+{
+	UNKNOWN,
+	MESHED_GEOMETRIC_MODEL,
+	COMPOUND_MESHED_GEOMETRIC_ITEM,
+	MESHED_PRIMITIVE_BOUNDED_SURFACE,
+	RECTANGLE,
+	QUADRILATERAL,
+	SPHERE,
+	CONE,
+	CYLINDER,
+	DISC,
+	PARABOLOID,
+	TRIANGLE,
+	AXIS_TRANSFORMATION_SEQUENCE,
+	ROTATION_WITH_AXES_FIXED,
+	TRANSLATION,
+	COUNT
+};
+
+struct EntityKindName
+{
+	EntityKind kind;
+	std::string_view name; // as returned by type()
+};
+
+constexpr EntityKindName EntityKindNames[] = {
+	{ EntityKind::MESHED_GEOMETRIC_MODEL, "Mgm_meshed_geometric_model" },
+	{ EntityKind::COMPOUND_MESHED_GEOMETRIC_ITEM, "Mgm_compound_meshed_geometric_item" },
+	{ EntityKind::MESHED_PRIMITIVE_BOUNDED_SURFACE, "Mgm_meshed_primitive_bounded_surface" },
+	{ EntityKind::RECTANGLE, "Mgm_rectangle" },
+	{ EntityKind::QUADRILATERAL, "Mgm_quadrilateral" },
+	{ EntityKind::SPHERE, "Mgm_sphere" },
+	{ EntityKind::CONE, "Mgm_cone" },
+	{ EntityKind::CYLINDER, "Mgm_cylinder" },
+	{ EntityKind::DISC, "Mgm_disc" },
+	{ EntityKind::PARABOLOID, "Mgm_paraboloid" },
+	{ EntityKind::TRIANGLE, "Mgm_triangle" },
+	{ EntityKind::AXIS_TRANSFORMATION_SEQUENCE, "Mgm_axis_transformation_sequence" },
+	{ EntityKind::ROTATION_WITH_AXES_FIXED, "Mgm_rotation_with_axes_fixed" },
+	{ EntityKind::TRANSLATION, "Mgm_translation" },
+};
+
+// UNKNOWN for a type the parser has no handler for
+EntityKind entityKind(std::string_view typeName);
+
+// the kind of an SDK entity, T is any tas_arm entity
+template <class T>
+EntityKind entityKindOf(T* entity)
+{
+	return entity == nullptr ? EntityKind::UNKNOWN : entityKind(entity->type());
+}
+
+// Downcast an entity whose kind has been checked. The kinds come from type names, so the cast is still
+// checked: an entity of a misclassified type gives nullptr, which the callers skip with an error.
+template <class T, class B>
+T* entityCast(B* entity)
+{
+	T* cast = dynamic_cast<T*>(entity);
+	if (cast == nullptr && entity != nullptr)
+	{
+		STI_LOG(sti::LOG_ERROR, "entity #" << entity->getKey() << " of type " << entity->type()
+			<< " does not match its entity kind, skipped");
+	}
+	return cast;
+}
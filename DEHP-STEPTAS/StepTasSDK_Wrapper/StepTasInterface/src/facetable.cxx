@@ -0,0 +1,148 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="facetable.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "facetable.hxx"
+
+using namespace sti;
+
+namespace
+{
+	template <class T>
+	void copyColumn(const std::vector<T>& column, T* buffer)
+	{
+		if (buffer != nullptr && !column.empty())
+		{
+			std::memcpy(buffer, column.data(), column.size() * sizeof(T));
+		}
+	}
+}
+
+int FaceTable::size()
+{
+	return (int)m_ids.size();
+}
+
+long FaceTable::getFaceId(int row)
+{
+	if (row < 0 || row >= size()) return 0;
+	return m_ids[row];
+}
+
+int FaceTable::getNetworkNodeId(int row)
+{
+	if (row < 0 || row >= size()) return -1;
+	return m_network_nodes[row];
+}
+
+int FaceTable::getModelId(int row)
+{
+	if (row < 0 || row >= size()) return -1;
+	return m_models[row];
+}
+
+int FaceTable::getClassTypeId(int row)
+{
+	if (row < 0 || row >= size()) return -1;
+	return m_class_types[row];
+}
+
+std::string FaceTable::getString(int id)
+{
+	return text(id);
+}
+
+std::string FaceTable::getNetworkNode(int row)
+{
+	return text(getNetworkNodeId(row));
+}
+
+std::string FaceTable::getModel(int row)
+{
+	return text(getModelId(row));
+}
+
+std::string FaceTable::getClassType(int row)
+{
+	return text(getClassTypeId(row));
+}
+
+void FaceTable::copyFaceIds(long* ids)
+{
+	copyColumn(m_ids, ids);
+}
+
+void FaceTable::copyNetworkNodeIds(int* networkNodes)
+{
+	copyColumn(m_network_nodes, networkNodes);
+}
+
+void FaceTable::copyModelIds(int* models)
+{
+	copyColumn(m_models, models);
+}
+
+void FaceTable::copyClassTypeIds(int* classTypes)
+{
+	copyColumn(m_class_types, classTypes);
+}
+
+void FaceTable::reserve(size_t rows)
+{
+	m_ids.reserve(rows);
+	m_network_nodes.reserve(rows);
+	m_models.reserve(rows);
+	m_class_types.reserve(rows);
+}
+
+void FaceTable::add(long faceId, int networkNode, int model, int classType)
+{
+	m_ids.push_back(faceId);
+	m_network_nodes.push_back(networkNode);
+	m_models.push_back(model);
+	m_class_types.push_back(classType);
+}
+
+PooledString FaceTable::text(int id) const
+{
+	if (m_strings == nullptr) return PooledString();
+	return m_strings->get(id);
+}
+
+void FaceTable::moveStrings(StringPool* strings, std::unordered_map<int, int>& ids)
+{
+	auto move = [&](std::vector<int>& column)
+	{
+		for (int& id : column)
+		{
+			if (id < 0) continue;
+			auto it = ids.find(id);
+			if (it == ids.end()) it = ids.emplace(id, strings->internId(m_strings->get(id).str())).first;
+			id = it->second;
+		}
+	};
+	move(m_network_nodes);
+	move(m_models);
+	move(m_class_types);
+	m_strings = strings;
+}
@@ -0,0 +1,81 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="facetable.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Face tables
+// The faces of one side of a meshed bounded surface, stored as columns: face id and the string ids of the
+// network node, its model and the face class type. The strings are in the StringPool of the file, an id
+// is resolved with getString. A side node keeps its faces in such a table; Face nodes are only created
+// when the children of the side are asked for, the NodeTable, the node index and the thermal node index
+// read the table directly.
+
+#include <string>
+#include <vector>
+#ifndef SWIG
+#include <unordered_map>
+#include "stringpool.hxx"
+#endif
+
+namespace sti
+{
+	class FaceTable
+	{
+	public:
+		int size();
+		long getFaceId(int row);
+		// string ids, -1 when the face has no corresponding network node (or the model no name)
+		int getNetworkNodeId(int row);
+		int getModelId(int row);
+		int getClassTypeId(int row);
+		// "" for -1
+		std::string getString(int id);
+		std::string getNetworkNode(int row);
+		std::string getModel(int row);
+		std::string getClassType(int row);
+
+		// copies into a buffer of size() entries
+		void copyFaceIds(long* ids);
+		void copyNetworkNodeIds(int* networkNodes);
+		void copyModelIds(int* models);
+		void copyClassTypeIds(int* classTypes);
+
+#ifndef SWIG
+		FaceTable() : m_strings(nullptr) {}
+		void setStrings(StringPool* strings) { m_strings = strings; }
+		StringPool* strings() const { return m_strings; }
+		void reserve(size_t rows);
+		void add(long faceId, int networkNode, int model, int classType);
+		long& faceId(int row) { return m_ids[row]; }
+		PooledString text(int id) const;
+		// moves the table to another pool, ids maps the ids of the current pool to those of the new one
+		void moveStrings(StringPool* strings, std::unordered_map<int, int>& ids);
+		bool hasNetworkNode(int row) const { return m_network_nodes[row] >= 0; }
+	private:
+		StringPool* m_strings;
+		std::vector<long> m_ids;
+		std::vector<int> m_network_nodes;
+		std::vector<int> m_models;
+		std::vector<int> m_class_types;
+#endif
+	};
+}
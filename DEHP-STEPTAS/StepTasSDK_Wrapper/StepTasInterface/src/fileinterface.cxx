@@ -27,14 +27,20 @@
 #include <tas_arm_support/ExpressDataSet_tas_arm_support.h>
 #include <tas_arm_support/MaterialPropertiesTable.h>
 
-#include <cstdio>
-#include <iostream>
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <memory>
 #include <string>
 //#include <sys/types.h>
 //#include <sys/stat.h>
 
 #include "interface.hxx"
 #include "fileinterface.hxx"
+#include "threadpool.hxx"
+#include "mappedfile.hxx"
+#include "part21.hxx"
+#include "logger.hxx"
 
 using namespace std;
 
@@ -83,12 +89,70 @@ namespace
 		return os;
 	};
 
+	// Nothing documents the SDK parser, the instantiation or the process wide dataset registry as
+	// reentrant, so every call that builds, registers or releases a dataset holds this lock. The
+	// processing holds it too, from the registration to the end: it reads the registered dataset.
+	std::mutex& sdkMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
 	void Trace(string name)
 	{
-		cout << name << endl;
+		STI_LOG(LOG_DEBUG, name);
+	}
+
+	PooledString reintern(StringPool& strings, const PooledString& text)
+	{
+		return text.empty() ? PooledString() : strings.intern(text.str());
+	}
+
+	// A fragment subtree built by a task takes its text from the file pool when it is stitched,
+	// the pool of the fragment goes away with the fragment.
+	void moveStrings(TasNode* node, StringPool& strings, std::unordered_map<int, int>& ids)
+	{
+		node->name = reintern(strings, node->name);
+		node->label = reintern(strings, node->label);
+		node->description = reintern(strings, node->description);
+		node->classType = reintern(strings, node->classType);
+		if (BoundedSurface* surface = dynamic_cast<BoundedSurface*>(node))
+		{
+			surface->side1_material_name = reintern(strings, surface->side1_material_name);
+			surface->side2_material_name = reintern(strings, surface->side2_material_name);
+		}
+		else if (Side* side = dynamic_cast<Side*>(node))
+		{
+			side->faces.moveStrings(&strings, ids);
+		}
+		// the raw children: a side is still pending, its faces are only in its table
+		for (TasNode* child : node->Children)
+		{
+			moveStrings(child, strings, ids);
+		}
+	}
+}
+
+
+void BuildContext::assignId(long& id)
+{
+	if (deferredIds != nullptr)
+	{
+		id = 0;
+		deferredIds->push_back(&id);
+		return;
 	}
+	id = owner->getNewId();
 }
 
+FileInterface::FileInterface() : FileInterface(LoadOptions())
+{
+}
+
+FileInterface::FileInterface(const LoadOptions& options)
+	: m_options(options), m_context{ m_arena, m_geometry, m_thermal_index, m_strings, this, nullptr, nullptr }
+{
+}
 
 std::string FileInterface::stringNrfRealQuantityType_unit(
 	tas_arm::Nrf_real_quantity_type* nrfRealQuantityType)
@@ -121,13 +185,57 @@ double FileInterface::QuantityValuePrescription_value(
 	return value;
 }
 
+// Factor from an angle unit to radians, matched on the unit entity rather than on its name: an SI unit
+// is the radian, a conversion based unit (the degree) is its factor times its base unit. False for any
+// other unit, the caller keeps its own default then.
+//
+bool FileInterface::angleUnitToRadians(
+	tas_arm::Nrf_any_unit* unit, double& factor, int depth)
+{
+	if (unit == nullptr || depth > 8) return false;
+	if (dynamic_cast<tas_arm::Nrf_si_unit*>(unit) != nullptr)
+	{
+		factor = 1.0;
+		return true;
+	}
+	if (tas_arm::Nrf_conversion_based_unit* converted = dynamic_cast<tas_arm::Nrf_conversion_based_unit*>(unit))
+	{
+		double base = 1.0;
+		if (!converted->testConversion_factor() || !converted->testBase_unit()
+			|| !angleUnitToRadians(converted->getBase_unit(), base, depth + 1))
+		{
+			return false;
+		}
+		factor = converted->getConversion_factor() * base;
+		return true;
+	}
+	STI_LOG(LOG_WARNING, "angle unit #" << unit->getKey() << ": not an SI or conversion based unit, ignored");
+	return false;
+}
+
+// A primitive angle in degrees, the unit of the geometry columns. Degrees unless the unit says otherwise.
+//
+double FileInterface::angleInDegrees(
+	tas_arm::Nrf_real_quantity_value_prescription* nrfRealQuantityValuePrescription)
+{
+	double value = QuantityValuePrescription_value(nrfRealQuantityValuePrescription);
+	tas_arm::Nrf_real_quantity_type* quantityType = nrfRealQuantityValuePrescription->getQuantity_type();
+	double factor = 1.0;
+	if (quantityType && quantityType->testUnit() && angleUnitToRadians(quantityType->getUnit(), factor))
+	{
+		value *= factor / DegreesToRadians;
+	}
+	return value;
+}
+
 
 void FileInterface::processNrfNamedObservableItem(
-	tas_arm::Nrf_named_observable_item* namedObservableItem, sti::TasNode* node)
+	tas_arm::Nrf_named_observable_item* namedObservableItem, sti::TasNode* node, BuildContext& ctx, bool markProcessed)
 {
 	node->id = namedObservableItem->getKey();
+	ctx.countEntity(namedObservableItem);
 
-	Already(node->id);
+	if (markProcessed) Already(node->id);
 	if (namedObservableItem->testId())
 
 	{
@@ -135,14 +243,14 @@ void FileInterface::processNrfNamedObservableItem(
 
 		string latin = id.toLatin1();
 
-		node->name = latin;
+		node->name = ctx.strings.intern(latin);
 	}
 
 	if (namedObservableItem->testName())
 	{
 		tas_arm::nrf_label name = namedObservableItem->getName();
 		string latin = name.toLatin1();
-		node->label = latin;
+		node->label = ctx.strings.intern(latin);
 	}
 
 	if (namedObservableItem->testDescription())
@@ -150,7 +258,7 @@ void FileInterface::processNrfNamedObservableItem(
 	{
 		tas_arm::nrf_text description = namedObservableItem->getDescription();
 		string latin = description.toLatin1();
-		node->description = latin;
+		node->description = ctx.strings.intern(latin);
 	}
 
 	if (namedObservableItem->testItem_class())
@@ -159,7 +267,7 @@ void FileInterface::processNrfNamedObservableItem(
 		itemClass = namedObservableItem->getItem_class();
 		tas_arm::nrf_non_blank_label name = itemClass->getName();
 		std::string latin = name.toLatin1();
-		node->classType = latin;
+		node->classType = ctx.strings.intern(latin);
 	}
 }
 
@@ -169,7 +277,7 @@ void FileInterface::processNrfNetworkNode(
 	tas_arm::Nrf_network_node* nrfNetworkNode, TasNode* node)
 
 {
-	processNrfNamedObservableItem(nrfNetworkNode, node);
+	processNrfNamedObservableItem(nrfNetworkNode, node, m_context);
 }
 
 // process attributes of an Mgm_any_meshed_geometric_item
@@ -192,31 +300,44 @@ void FileInterface::processMgmCompoundMeshedGeometricItem(
 	// mgm_compound_meshed_geometric_item.geometric_items : LIST [1:?] of UNIQUE mgm_any_meshed_geometric_items
 	//
 
-	TasNode* cpnode = new TasNode();
-	processNrfNamedObservableItem(mgmCompoundMeshedGeometricItem, cpnode);
+	TasNode* cpnode = m_arena.create<TasNode>();
+	processNrfNamedObservableItem(mgmCompoundMeshedGeometricItem, cpnode, m_context);
 	geo->addChild(cpnode);
+	placeCompound(mgmCompoundMeshedGeometricItem, geo, cpnode);
+
+	if (m_options.lazy)
+	{
+		// only this level is built now, the items are read on the first access to the children
+		collectLazyChildren(mgmCompoundMeshedGeometricItem);
+		cpnode->pendingExpansion = this;
+		return;
+	}
 
 	if (mgmCompoundMeshedGeometricItem->testGeometric_items())
 	{
 		tas_arm::List_Mgm_any_meshed_geometric_item_1_n& items = mgmCompoundMeshedGeometricItem->getGeometric_items();
 
 		for (auto geoitem : items) {
+			throwIfCancelled();
 			Step::Id id = geoitem->getKey();
 			if (isAlready(id))continue;
 			Already(id);
-			std::string nodeType = geoitem->type();
-			if (nodeType == "Mgm_compound_meshed_geometric_item")
+			switch (entityKindOf(geoitem.get()))
 			{
-				tas_arm::Mgm_compound_meshed_geometric_item* item = m_dataSet->getMgm_compound_meshed_geometric_item(id);
-				processMgmCompoundMeshedGeometricItem(item, cpnode);
-			}
-
-			if (nodeType == "Mgm_meshed_primitive_bounded_surface") {
-				// Normally we should not get any of these as they should have been correctly handled by the compound meshed geometry exploration
-
-				tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMPBS = 0;
-				mgmMPBS = m_dataSet->getMgm_meshed_primitive_bounded_surface(id);
-				processMgmMeshedPrimitiveBoundedSurface(mgmMPBS, cpnode);
+			case EntityKind::COMPOUND_MESHED_GEOMETRIC_ITEM:
+				if (auto compound = entityCast<tas_arm::Mgm_compound_meshed_geometric_item>(geoitem.get()))
+				{
+					processMgmCompoundMeshedGeometricItem(compound, cpnode);
+				}
+				break;
+			case EntityKind::MESHED_PRIMITIVE_BOUNDED_SURFACE:
+				if (auto surface = entityCast<tas_arm::Mgm_meshed_primitive_bounded_surface>(geoitem.get()))
+				{
+					dispatchMgmMeshedPrimitiveBoundedSurface(surface, cpnode);
+				}
+				break;
+			default:
+				break;
 			}
 		}
 	}
@@ -234,10 +355,75 @@ void FileInterface::processMgmMeshedGeometricModel(
 	{
 		tas_arm::Mgm_any_meshed_geometric_item* rootItem = 0;
 		rootItem = mgmMeshedGeometricModel->getRoot_item();
-		string typ = rootItem->type();
-		if (typ == "Mgm_compound_meshed_geometric_item")
+		if (entityKindOf(rootItem) == EntityKind::COMPOUND_MESHED_GEOMETRIC_ITEM)
+		{
+			if (auto compound = entityCast<tas_arm::Mgm_compound_meshed_geometric_item>(rootItem))
+			{
+				processMgmCompoundMeshedGeometricItem(compound, node);
+			}
+		}
+	}
+}
+
+// lazy loading: walk the compound hierarchy once to decide which compound owns each item.
+// Only the item keys are visited, the nodes and the surface subtrees are built by expandNode.
+//
+void FileInterface::collectLazyChildren(tas_arm::Mgm_compound_meshed_geometric_item* compound)
+{
+	std::vector<LazyItem>& children = m_lazy_children[compound->getKey()];
+	if (!compound->testGeometric_items()) return;
+
+	tas_arm::List_Mgm_any_meshed_geometric_item_1_n& items = compound->getGeometric_items();
+	for (auto geoitem : items) {
+		Step::Id id = geoitem->getKey();
+		if (isAlready(id))continue;
+		Already(id);
+		EntityKind kind = entityKindOf(geoitem.get());
+		if (kind == EntityKind::COMPOUND_MESHED_GEOMETRIC_ITEM)
+		{
+			auto compound = entityCast<tas_arm::Mgm_compound_meshed_geometric_item>(geoitem.get());
+			if (compound == nullptr) continue;
+			children.push_back({ geoitem.get(), kind });
+			collectLazyChildren(compound);
+		}
+		else if (kind == EntityKind::MESHED_PRIMITIVE_BOUNDED_SURFACE)
+		{
+			children.push_back({ geoitem.get(), kind });
+		}
+	}
+}
+
+TasNode* FileInterface::createLazyCompoundNode(
+	tas_arm::Mgm_compound_meshed_geometric_item* compound, TasNode* parent)
+{
+	TasNode* cpnode = m_arena.create<TasNode>();
+	processNrfNamedObservableItem(compound, cpnode, m_context, false);
+	parent->addChild(cpnode);
+	placeCompound(compound, parent, cpnode);
+	cpnode->pendingExpansion = this;
+	return cpnode;
+}
+
+void FileInterface::expandNode(TasNode* node)
+{
+	if (Side* side = dynamic_cast<Side*>(node))
+	{
+		materializeFaces(side);
+		return;
+	}
+	auto it = m_lazy_children.find(node->id);
+	if (it == m_lazy_children.end()) return;
+
+	for (const LazyItem& item : it->second)
+	{
+		if (item.kind == EntityKind::COMPOUND_MESHED_GEOMETRIC_ITEM)
 		{
-			processMgmCompoundMeshedGeometricItem(dynamic_cast<tas_arm::Mgm_compound_meshed_geometric_item*> (rootItem), node);
+			// checked by collectLazyChildren
+			createLazyCompoundNode(static_cast<tas_arm::Mgm_compound_meshed_geometric_item*>(item.entity), node);
+		}
+		else if (auto surface = entityCast<tas_arm::Mgm_meshed_primitive_bounded_surface>(item.entity))
+		{
+			processMgmMeshedPrimitiveBoundedSurface(surface, node);
 		}
 	}
 }
@@ -246,9 +432,9 @@ void FileInterface::processMgmMeshedGeometricModel(
 //
 
 void FileInterface::processMgmQuadrilateral(
-	tas_arm::Mgm_quadrilateral* mgmQuad, Quadrilateral* quad)
+	tas_arm::Mgm_quadrilateral* mgmQuad, Quadrilateral* quad, BuildContext& ctx)
 {
-	quad->name = "Quadrilateral";
+	quad->name = ctx.strings.intern("Quadrilateral");
 	quad->P1 = getPoint3D(mgmQuad->getP1());
 	quad->P2 = getPoint3D(mgmQuad->getP2());
 	quad->P3 = getPoint3D(mgmQuad->getP3());
@@ -259,10 +445,10 @@ void FileInterface::processMgmQuadrilateral(
 //
 
 void FileInterface::processMgmSphere(
-	tas_arm::Mgm_sphere* mgmSphere, Sphere* sphere)
+	tas_arm::Mgm_sphere* mgmSphere, Sphere* sphere, BuildContext& ctx)
 
 {
-	sphere->name = "Sphere";
+	sphere->name = ctx.strings.intern("Sphere");
 	sphere->P1 = getPoint3D(mgmSphere->getP1());
 	sphere->P2 = getPoint3D(mgmSphere->getP2());
 	sphere->P3 = getPoint3D(mgmSphere->getP3());
@@ -278,13 +464,11 @@ void FileInterface::processMgmSphere(
 	//
 	if (!mgmSphere->testBase_truncation())
 	{
-		printf("\tmgm_sphere.base_truncation: not set! [MANDATORY]\n");
+		STI_LOG(LOG_WARNING, "mgm_sphere #" << mgmSphere->getKey() << ".base_truncation: not set! [MANDATORY]");
 	}
 	else
 	{
-		tas_arm::Nrf_real_quantity_value_prescription* prescription = 0;
-		prescription = mgmSphere->getBase_truncation();
-		Step::Id entityId = prescription->getKey();
+		sphere->BaseTruncation = QuantityValuePrescription_value(mgmSphere->getBase_truncation());
 	}
 
 	// mgm_sphere.apex_truncation : nrf_real_quantity_value_prescription
@@ -300,287 +484,497 @@ void FileInterface::processMgmSphere(
 	if (mgmSphere->testStart_angle())
 
 	{
-		sphere->StartAngle = QuantityValuePrescription_value(mgmSphere->getStart_angle());
+		sphere->StartAngle = angleInDegrees(mgmSphere->getStart_angle());
 	}
 
 	if (mgmSphere->testEnd_angle())
 
 	{
-		sphere->StartAngle = QuantityValuePrescription_value(mgmSphere->getEnd_angle());
+		sphere->EndAngle = angleInDegrees(mgmSphere->getEnd_angle());
+	}
+	else
+	{
+		// unset, the surface runs to a full turn from its start angle
+		sphere->EndAngle = 360.0;
 	}
 }
 
 // process attributes of an Mgm_rectangle as one block
 //
 void FileInterface::processMgmRectangle(
-	tas_arm::Mgm_rectangle* mgmRectangle, Rectangle* rectangle)
+	tas_arm::Mgm_rectangle* mgmRectangle, Rectangle* rectangle, BuildContext& ctx)
 
 {
 	// mgm_rectangle.p1 : mgm_3d_cartesian_point
 	//
-	rectangle->name = "Rectangle";
+	rectangle->name = ctx.strings.intern("Rectangle");
 	rectangle->P1 = getPoint3D(mgmRectangle->getP1());
 	rectangle->P2 = getPoint3D(mgmRectangle->getP2());
 	rectangle->P3 = getPoint3D(mgmRectangle->getP3());
 }
 
+// process attributes of an Mgm_cone as one block
+//
+void FileInterface::processMgmCone(
+	tas_arm::Mgm_cone* mgmCone, Cone* cone, BuildContext& ctx)
+
+{
+	cone->name = ctx.strings.intern("Cone");
+	cone->P1 = getPoint3D(mgmCone->getP1());
+	cone->P2 = getPoint3D(mgmCone->getP2());
+	cone->P3 = getPoint3D(mgmCone->getP3());
+	if (mgmCone->testRadius1())
+	{
+		cone->Radius1 = QuantityValuePrescription_value(mgmCone->getRadius1());
+	}
+	if (mgmCone->testRadius2())
+	{
+		cone->Radius2 = QuantityValuePrescription_value(mgmCone->getRadius2());
+	}
+	if (mgmCone->testStart_angle())
+	{
+		cone->StartAngle = angleInDegrees(mgmCone->getStart_angle());
+	}
+	if (mgmCone->testEnd_angle())
+	{
+		cone->EndAngle = angleInDegrees(mgmCone->getEnd_angle());
+	}
+	else
+	{
+		cone->EndAngle = 360.0;
+	}
+}
+
+// process attributes of an Mgm_cylinder as one block
+//
+void FileInterface::processMgmCylinder(
+	tas_arm::Mgm_cylinder* mgmCylinder, Cylinder* cylinder, BuildContext& ctx)
+
+{
+	cylinder->name = ctx.strings.intern("Cylinder");
+	cylinder->P1 = getPoint3D(mgmCylinder->getP1());
+	cylinder->P2 = getPoint3D(mgmCylinder->getP2());
+	cylinder->P3 = getPoint3D(mgmCylinder->getP3());
+	if (mgmCylinder->testRadius())
+	{
+		cylinder->Radius = QuantityValuePrescription_value(mgmCylinder->getRadius());
+	}
+	if (mgmCylinder->testStart_angle())
+	{
+		cylinder->StartAngle = angleInDegrees(mgmCylinder->getStart_angle());
+	}
+	if (mgmCylinder->testEnd_angle())
+	{
+		cylinder->EndAngle = angleInDegrees(mgmCylinder->getEnd_angle());
+	}
+	else
+	{
+		cylinder->EndAngle = 360.0;
+	}
+}
+
+// process attributes of an Mgm_disc as one block
+//
+void FileInterface::processMgmDisc(
+	tas_arm::Mgm_disc* mgmDisc, Disc* disc, BuildContext& ctx)
+
+{
+	disc->name = ctx.strings.intern("Disc");
+	disc->P1 = getPoint3D(mgmDisc->getP1());
+	disc->P2 = getPoint3D(mgmDisc->getP2());
+	disc->P3 = getPoint3D(mgmDisc->getP3());
+	if (mgmDisc->testInner_radius())
+	{
+		disc->InnerRadius = QuantityValuePrescription_value(mgmDisc->getInner_radius());
+	}
+	if (mgmDisc->testOuter_radius())
+	{
+		disc->OuterRadius = QuantityValuePrescription_value(mgmDisc->getOuter_radius());
+	}
+	if (mgmDisc->testStart_angle())
+	{
+		disc->StartAngle = angleInDegrees(mgmDisc->getStart_angle());
+	}
+	if (mgmDisc->testEnd_angle())
+	{
+		disc->EndAngle = angleInDegrees(mgmDisc->getEnd_angle());
+	}
+	else
+	{
+		disc->EndAngle = 360.0;
+	}
+}
+
+// process attributes of an Mgm_paraboloid as one block
+//
+void FileInterface::processMgmParaboloid(
+	tas_arm::Mgm_paraboloid* mgmParaboloid, Paraboloid* paraboloid, BuildContext& ctx)
+
+{
+	paraboloid->name = ctx.strings.intern("Paraboloid");
+	paraboloid->P1 = getPoint3D(mgmParaboloid->getP1());
+	paraboloid->P2 = getPoint3D(mgmParaboloid->getP2());
+	paraboloid->P3 = getPoint3D(mgmParaboloid->getP3());
+	if (mgmParaboloid->testRadius())
+	{
+		paraboloid->Radius = QuantityValuePrescription_value(mgmParaboloid->getRadius());
+	}
+	if (mgmParaboloid->testApex_truncation())
+	{
+		paraboloid->ApexTruncation = QuantityValuePrescription_value(mgmParaboloid->getApex_truncation());
+	}
+	if (mgmParaboloid->testStart_angle())
+	{
+		paraboloid->StartAngle = angleInDegrees(mgmParaboloid->getStart_angle());
+	}
+	if (mgmParaboloid->testEnd_angle())
+	{
+		paraboloid->EndAngle = angleInDegrees(mgmParaboloid->getEnd_angle());
+	}
+	else
+	{
+		paraboloid->EndAngle = 360.0;
+	}
+}
+
+// process attributes of an Mgm_triangle as one block
+//
+void FileInterface::processMgmTriangle(
+	tas_arm::Mgm_triangle* mgmTriangle, Triangle* triangle, BuildContext& ctx)
+
+{
+	triangle->name = ctx.strings.intern("Triangle");
+	triangle->P1 = getPoint3D(mgmTriangle->getP1());
+	triangle->P2 = getPoint3D(mgmTriangle->getP2());
+	triangle->P3 = getPoint3D(mgmTriangle->getP3());
+}
+
+template <class Entity, class Node, void (FileInterface::*Process)(Entity*, Node*, BuildContext&)>
+BoundedSurface* FileInterface::buildPrimitive(tas_arm::Mgm_primitive_bounded_surface* entity, BuildContext& ctx)
+{
+	Node* node = ctx.arena.create<Node>();
+	// a misclassified primitive keeps its zero parameters
+	if (Entity* primitive = entityCast<Entity>(entity)) (this->*Process)(primitive, node, ctx);
+	return node;
+}
+
+constexpr FileInterface::SurfaceHandlerTable FileInterface::makeSurfaceHandlers()
+{
+	SurfaceHandlerTable handlers{};
+	handlers[(size_t)EntityKind::RECTANGLE] = &FileInterface::buildPrimitive<tas_arm::Mgm_rectangle, Rectangle, &FileInterface::processMgmRectangle>;
+	handlers[(size_t)EntityKind::QUADRILATERAL] = &FileInterface::buildPrimitive<tas_arm::Mgm_quadrilateral, Quadrilateral, &FileInterface::processMgmQuadrilateral>;
+	handlers[(size_t)EntityKind::SPHERE] = &FileInterface::buildPrimitive<tas_arm::Mgm_sphere, Sphere, &FileInterface::processMgmSphere>;
+	handlers[(size_t)EntityKind::CONE] = &FileInterface::buildPrimitive<tas_arm::Mgm_cone, Cone, &FileInterface::processMgmCone>;
+	handlers[(size_t)EntityKind::CYLINDER] = &FileInterface::buildPrimitive<tas_arm::Mgm_cylinder, Cylinder, &FileInterface::processMgmCylinder>;
+	handlers[(size_t)EntityKind::DISC] = &FileInterface::buildPrimitive<tas_arm::Mgm_disc, Disc, &FileInterface::processMgmDisc>;
+	handlers[(size_t)EntityKind::PARABOLOID] = &FileInterface::buildPrimitive<tas_arm::Mgm_paraboloid, Paraboloid, &FileInterface::processMgmParaboloid>;
+	handlers[(size_t)EntityKind::TRIANGLE] = &FileInterface::buildPrimitive<tas_arm::Mgm_triangle, Triangle, &FileInterface::processMgmTriangle>;
+	return handlers;
+}
+
+// constant initialized, the table is ready before any static constructor runs
+const FileInterface::SurfaceHandlerTable FileInterface::SurfaceHandlers = FileInterface::makeSurfaceHandlers();
+
 
 
 void FileInterface::processMgmRotation(
-	tas_arm::Mgm_rotation* mgmRotation, Geometry* geo)
+	tas_arm::Mgm_rotation* mgmRotation, Transform& transform)
 
 {
 	// mgm_rotation.axis : mgm_3d_direction
 	//
+	Direction axis;
 	if (!mgmRotation->testAxis())
 	{
-		printf("\tmgm_rotation.axis: not set! [MANDATORY]\n");
-	}
-	else
-	{
-		tas_arm::Mgm_3d_direction* axis = 0;
-		axis = mgmRotation->getAxis();
-		AxisRotation rot;
-		Direction dir = getDirection(axis);
-		rot.axis = dir;
-		geo->transformation = rot;
+		STI_LOG(LOG_WARNING, "mgm_rotation #" << mgmRotation->getKey() << ".axis: not set! [MANDATORY]");
+		return;
 	}
+	axis = getDirection(mgmRotation->getAxis());
 
 	// mgm_rotation.angle : REAL
 	//
 	if (!mgmRotation->testAngle())
 	{
-		printf("\tmgm_rotation.angle: not set! [MANDATORY]\n");
-	}
-	else
-	{
-		Step::Real angle = 0;
-		angle = mgmRotation->getAngle();
+		STI_LOG(LOG_WARNING, "mgm_rotation #" << mgmRotation->getKey() << ".angle: not set! [MANDATORY]");
+		return;
 	}
+	double angle = mgmRotation->getAngle();
 
 	// mgm_rotation.quantity_type : nrf_real_quantity_type
 	//
 	if (!mgmRotation->testQuantity_type())
 	{
-		printf("\tmgm_rotation.quantity_type: not set! [MANDATORY]\n");
+		STI_LOG(LOG_WARNING, "mgm_rotation #" << mgmRotation->getKey() << ".quantity_type: not set! [MANDATORY]");
 	}
 	else
 	{
 		tas_arm::Nrf_real_quantity_type* quantityType = 0;
 		quantityType = mgmRotation->getQuantity_type();
-		Step::Id entityId = quantityType->getKey();
-		std::string details = stringNrfRealQuantityType_unit(quantityType);
-		printf("\tmgm_rotation.quantity_type: #%ld  -> unit='%s'\n", entityId, details.c_str());
+		std::string unit = stringNrfRealQuantityType_unit(quantityType);
+		STI_LOG(LOG_DEBUG, "mgm_rotation.quantity_type: #" << quantityType->getKey()
+			<< "  -> unit='" << unit << "'");
+		// radians unless the unit says otherwise
+		double factor = 1.0;
+		if (quantityType->testUnit() && angleUnitToRadians(quantityType->getUnit(), factor))
+		{
+			angle *= factor;
+		}
 	}
+
+	// the axes are fixed: the rotation is expressed in the frame the previous steps started from
+	transform = Transform::rotation(axis, angle) * transform;
 }
 
-// process complete details of an Mgm_rotation_with_axes_fixed as one block
-//
+void FileInterface::processMgmTranslation(
+	tas_arm::Mgm_translation* mgmTranslation, Transform& transform)
+{
+	// mgm_translation.direction : mgm_3d_direction, its length is the distance
+	//
+	if (!mgmTranslation->testDirection())
+	{
+		STI_LOG(LOG_WARNING, "mgm_translation #" << mgmTranslation->getKey() << ".direction: not set! [MANDATORY]");
+		return;
+	}
+	Direction direction = getDirection(mgmTranslation->getDirection());
+	transform = Transform::translation(direction.x, direction.y, direction.z) * transform;
+}
 
-// process an Mgm_axis_transformation_sequence and work down hierarchy if needed
+// process an Mgm_axis_transformation_sequence, the steps are applied in list order
 //
 void FileInterface::processMgmAxisTransformationSequence(
-	tas_arm::Mgm_axis_transformation_sequence* mgmAxisTransformationSequence, Geometry* geom)
+	tas_arm::Mgm_axis_transformation_sequence* mgmAxisTransformationSequence, Transform& transform)
 
 {
-	// skip transformation sequences
-	return;
-	//processMgmAxisTransformationSequence_fields(mgmAxisTransformationSequence,geom);
-
-	//processMgmAxisTransformationSequenceB(mgmAxisTransformationSequence);
+	if (!mgmAxisTransformationSequence->testTransformation_sequence()) return;
 
-	if (mgmAxisTransformationSequence->testTransformation_sequence())
+	tas_arm::List_Mgm_translation_or_rotation_1_n& transforms = mgmAxisTransformationSequence->getTransformation_sequence();
+	for (auto step : transforms)
 	{
-		tas_arm::List_Mgm_translation_or_rotation_1_n& transforms = mgmAxisTransformationSequence->getTransformation_sequence();
-
-		for (auto transform : transforms)
+		countEntity(step.get());
+		switch (entityKindOf(step.get()))
 		{
-			Geometry* nn = new Geometry(); nn->label = "Transformation";
-			geom->addChild(nn);
-
-			Step::Id entityId = transform->getKey();
-			geom->id = entityId;
-			std::string transformationType = transform->type();
-
-			if (transformationType == "Mgm_rotation_with_axes_fixed")
+		case EntityKind::ROTATION_WITH_AXES_FIXED:
+			if (auto rotation = entityCast<tas_arm::Mgm_rotation_with_axes_fixed>(step.get()))
 			{
-				tas_arm::Mgm_rotation_with_axes_fixed* rotation = 0;
-				rotation = m_dataSet->getMgm_rotation_with_axes_fixed(entityId);
+				processMgmRotation(rotation, transform);
 			}
+			break;
+		case EntityKind::TRANSLATION:
+			if (auto translation = entityCast<tas_arm::Mgm_translation>(step.get()))
+			{
+				processMgmTranslation(translation, transform);
+			}
+			break;
+		default:
+			STI_LOG(LOG_WARNING, "transformation step #" << step->getKey() << " of type " << step->type() << " is not supported, skipped");
+			break;
 		}
 	}
 }
 
-// process an Mgm_axis_transformation and work down hierarchy if needed
+// process an Mgm_axis_transformation into the matrix it stands for
 //
 void FileInterface::processMgmAxisTransformation(
-	tas_arm::Mgm_axis_transformation* mgmAxisTransformation, Geometry* geom)
+	tas_arm::Mgm_axis_transformation* mgmAxisTransformation, Transform& transform)
 
 {
-	if (mgmAxisTransformation == nullptr) {
-		return;
-	}
-	std::string transformationType = mgmAxisTransformation->type();
-	Step::Id entityId = mgmAxisTransformation->getKey();
-	if (transformationType == "Mgm_axis_transformation_sequence")
+	countEntity(mgmAxisTransformation);
+	if (entityKindOf(mgmAxisTransformation) == EntityKind::AXIS_TRANSFORMATION_SEQUENCE)
 	{
-		tas_arm::Mgm_axis_transformation_sequence* sequence = 0;
-		sequence = m_dataSet->getMgm_axis_transformation_sequence(entityId);
-		processMgmAxisTransformationSequence(sequence, geom);
+		if (auto sequence = entityCast<tas_arm::Mgm_axis_transformation_sequence>(mgmAxisTransformation))
+		{
+			processMgmAxisTransformationSequence(sequence, transform);
+		}
 	}
 	else
 	{
-		cout << "Transformation to do " << transformationType << endl;
-		//
+		STI_LOG(LOG_WARNING, "transformation #" << mgmAxisTransformation->getKey() << " of type "
+			<< mgmAxisTransformation->type() << " is not supported, the item stays in place");
 	}
 }
 
-// get and process an individual quantity value
+// A transformation entity is turned into its matrix once, and an item gets the same model matrix as
+// every other item of its compound placed by the same entity. The matrices live in the node arena.
 //
-
-double FileInterface::processQuantityValue(
-	Step::RefPtr<tas_arm_support::MaterialPropertiesTable> materialPropertiesTable,
-	Step::String environmentName,
-	Step::String materialId,
-	Step::String quantityName)
+Transform* FileInterface::placeItem(TasNode* parent, tas_arm::Mgm_axis_transformation* local)
 {
-	return  materialPropertiesTable->getPropertyRealValues(environmentName, materialId, quantityName)[0];
+	auto inherited = m_compound_transforms.find(parent->id);
+	Transform* parentTransform = (inherited == m_compound_transforms.end()) ? nullptr : inherited->second;
+	if (local == nullptr) return parentTransform;
+
+	Step::Id key = local->getKey();
+	auto placed = m_model_transforms.find({ parentTransform, key });
+	if (placed != m_model_transforms.end()) return placed->second;
+
+	auto cached = m_local_transforms.find(key);
+	if (cached == m_local_transforms.end())
+	{
+		Transform matrix;
+		processMgmAxisTransformation(local, matrix);
+		cached = m_local_transforms.emplace(key, matrix).first;
+	}
+	Transform* model = m_arena.create<Transform>(parentTransform != nullptr ? *parentTransform * cached->second : cached->second);
+	m_model_transforms.emplace(std::make_pair(parentTransform, key), model);
+	return model;
 }
 
+// the items of the compound inherit its model transformation
 //
-void FileInterface::processSurfaceMaterial(
-	tas_arm::Nrf_material* nrfMaterial, sti::ThermalMaterialProperties* materialnode)
+void FileInterface::placeCompound(tas_arm::Mgm_compound_meshed_geometric_item* compound, TasNode* parent, TasNode* cpnode)
+{
+	Transform* transform = placeItem(parent, compound->testTransformation() ? compound->getTransformation() : nullptr);
+	if (transform != nullptr) m_compound_transforms[cpnode->id] = transform;
+}
 
+Transform* FileInterface::placeSurface(tas_arm::Mgm_meshed_primitive_bounded_surface* surface, TasNode* parent)
 {
-	processNrfNamedObservableItem(nrfMaterial, materialnode);
+	return placeItem(parent, surface->testTransformation() ? surface->getTransformation() : nullptr);
+}
 
-	Step::RefPtr<tas_arm::Mgm_meshed_geometric_model> meshedGeometricModel =
-		m_dataSet->getNetworkModelsFromRoot("thermal_radiative_conductive_model").at(0);
+// Build the material index once from the SDK material properties table.
+// Every (environment, material, quantity) triple is looked up a single time, the process functions
+// then read the values by row instead of scanning the table with string comparisons.
+//
+void FileInterface::buildMaterialIndex()
+{
+	auto models = m_dataSet->getNetworkModelsFromRoot("thermal_radiative_conductive_model");
+	if (models.empty()) return;
 
 	tas_arm_support::MaterialTablesMap& materialTablesMap = m_dataSet->getMaterial_tables();
-
-	Step::RefPtr<tas_arm_support::MaterialPropertiesTable> materialPropertiesTable =
-		materialTablesMap[meshedGeometricModel.get()];
-
-	Step::List<Step::String>& environmentNames = materialPropertiesTable->getEnvironment_names();
-	Step::List<Step::String>::iterator environmentIter;
-
-	Step::List<Step::String>& materialIds = materialPropertiesTable->getMaterial_ids();
-	Step::List<Step::String>::iterator materialIter;
-
-	Step::String quantityName;
-	bool materialFound = false;
-	for (environmentIter = environmentNames.begin(); environmentIter != environmentNames.end(); ++environmentIter)
+	auto table = materialTablesMap.find(models.at(0).get());
+	if (table == materialTablesMap.end() || !table->second.valid()) return;
+	Step::RefPtr<tas_arm_support::MaterialPropertiesTable> materialPropertiesTable = table->second;
+
+	std::vector<Step::String> environmentNames(
+		materialPropertiesTable->getEnvironment_names().begin(), materialPropertiesTable->getEnvironment_names().end());
+	std::vector<Step::String> materialIds(
+		materialPropertiesTable->getMaterial_ids().begin(), materialPropertiesTable->getMaterial_ids().end());
+
+	std::vector<std::string> environments;
+	for (const Step::String& environmentName : environmentNames) environments.push_back(environmentName.toUTF8());
+	std::vector<std::string> materials;
+	for (const Step::String& materialId : materialIds) materials.push_back(materialId.toUTF8());
+	m_material_index.reset(materials, environments);
+
+	for (size_t material = 0; material < materialIds.size(); material++)
 	{
-		Step::String environmentName = (*environmentIter);
-		for (materialIter = materialIds.begin(); materialIter != materialIds.end(); ++materialIter)
+		for (size_t environment = 0; environment < environmentNames.size(); environment++)
 		{
-			Step::String materialId = (*materialIter);
-			if (materialId == nrfMaterial->getId())
+			for (int quantity = 0; quantity < MQ_COUNT; quantity++)
 			{
-				materialFound = true;
-				printf("\t-> property_environment = '%s'\n", environmentName.toLatin1().c_str());
-
-				materialnode->solarAbsorptance = processQuantityValue(materialPropertiesTable, environmentName, materialId, "solar_absorptance");
-				materialnode->solarDirectTransmittance = processQuantityValue(materialPropertiesTable, environmentName, materialId, "solar_direct_transmittance");
-				materialnode->solarDiffuseTransmittance = processQuantityValue(materialPropertiesTable, environmentName, materialId, "solar_diffuse_transmittance");
-				materialnode->solarSpecularity = processQuantityValue(materialPropertiesTable, environmentName, materialId, "solar_specularity");
-				materialnode->solarRefractionIndex = processQuantityValue(materialPropertiesTable, environmentName, materialId, "solar_refraction_index");
-				materialnode->infraredEmittance = processQuantityValue(materialPropertiesTable, environmentName, materialId, "infra_red_emittance");
-				materialnode->infraredDirectTransmittance = processQuantityValue(materialPropertiesTable, environmentName, materialId, "infra_red_direct_transmittance");
-				materialnode->infraredDiffuseTransmittance = processQuantityValue(materialPropertiesTable, environmentName, materialId, "infra_red_diffuse_transmittance");
-				materialnode->infraredSpecularity = processQuantityValue(materialPropertiesTable, environmentName, materialId, "infra_red_specularity");
-				materialnode->infraredRefractionIndex = processQuantityValue(materialPropertiesTable, environmentName, materialId, "infra_red_refraction_index");
+				// surface materials have no bulk quantities and the other way round, those stay missing.
+				// The support library reports an undefined property through a std::exception (std::out_of_range
+				// from its lookup tables), anything else is a real failure and goes up to the loader.
+				const char* quantityName = MaterialIndex::quantityName((MaterialQuantity)quantity);
+				try
+				{
+					auto values = materialPropertiesTable->getPropertyRealValues(
+						environmentNames[environment], materialIds[material], quantityName);
+					if (!values.empty())
+					{
+						m_material_index.set((int)material, (int)environment, (MaterialQuantity)quantity, values[0]);
+					}
+				}
+				catch (const std::exception& e)
+				{
+					STI_LOG(LOG_DEBUG, "material " << materials[material] << " environment " << environments[environment]
+						<< " has no " << quantityName << ": " << e.what());
+				}
 			}
 		}
 	}
 }
 
+// surface material values as kept by the node: the last environment defining each quantity
+//
+void FileInterface::processSurfaceMaterial(
+	tas_arm::Nrf_material* nrfMaterial, sti::ThermalMaterialProperties* materialnode)
+
+{
+	processNrfNamedObservableItem(nrfMaterial, materialnode, m_context, false);
+
+	int row = m_material_index.findMaterial(nrfMaterial->getId().toUTF8());
+	if (row < 0) return;
+
+	materialnode->solarAbsorptance = m_material_index.getLastValue(row, MQ_SOLAR_ABSORPTANCE);
+	materialnode->solarDirectTransmittance = m_material_index.getLastValue(row, MQ_SOLAR_DIRECT_TRANSMITTANCE);
+	materialnode->solarDiffuseTransmittance = m_material_index.getLastValue(row, MQ_SOLAR_DIFFUSE_TRANSMITTANCE);
+	materialnode->solarSpecularity = m_material_index.getLastValue(row, MQ_SOLAR_SPECULARITY);
+	materialnode->solarRefractionIndex = m_material_index.getLastValue(row, MQ_SOLAR_REFRACTION_INDEX);
+	materialnode->infraredEmittance = m_material_index.getLastValue(row, MQ_INFRARED_EMITTANCE);
+	materialnode->infraredDirectTransmittance = m_material_index.getLastValue(row, MQ_INFRARED_DIRECT_TRANSMITTANCE);
+	materialnode->infraredDiffuseTransmittance = m_material_index.getLastValue(row, MQ_INFRARED_DIFFUSE_TRANSMITTANCE);
+	materialnode->infraredSpecularity = m_material_index.getLastValue(row, MQ_INFRARED_SPECULARITY);
+	materialnode->infraredRefractionIndex = m_material_index.getLastValue(row, MQ_INFRARED_REFRACTION_INDEX);
+}
+
 
 void FileInterface::processBulkMaterial(
 	tas_arm::Nrf_material* nrfMaterial, Material* material)
 
 {
-	processNrfNamedObservableItem(nrfMaterial, material);
+	processNrfNamedObservableItem(nrfMaterial, material, m_context, false);
 
-	Step::RefPtr<tas_arm::Mgm_meshed_geometric_model> meshedGeometricModel =
-		m_dataSet->getNetworkModelsFromRoot("thermal_radiative_conductive_model").at(0);
-	tas_arm_support::MaterialTablesMap& materialTablesMap = m_dataSet->getMaterial_tables();
+	int row = m_material_index.findMaterial(nrfMaterial->getId().toUTF8());
+	if (row < 0) return;
 
-	Step::RefPtr<tas_arm_support::MaterialPropertiesTable> materialPropertiesTable =
-		materialTablesMap[meshedGeometricModel.get()];
+	material->massDensity = m_material_index.getLastValue(row, MQ_MASS_DENSITY);
+	material->specificHeatCapacity = m_material_index.getLastValue(row, MQ_SPECIFIC_HEAT_CAPACITY);
+	material->thermalConductivity = m_material_index.getLastValue(row, MQ_THERMAL_CONDUCTIVITY);
+}
 
-	Step::List<Step::String>& environmentNames = materialPropertiesTable->getEnvironment_names();
-	Step::List<Step::String>::iterator environmentIter;
+void FileInterface::processMgmMeshedPrimitiveBoundedSurface(
+	tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMeshedPrimitiveBoundedSurface, TasNode* rnode)
 
-	Step::List<Step::String>& materialIds = materialPropertiesTable->getMaterial_ids();
-	Step::List<Step::String>::iterator materialIter;
+{
+	advanceProgress();
+	rnode->addChild(buildMgmMeshedPrimitiveBoundedSurface(mgmMeshedPrimitiveBoundedSurface, placeSurface(mgmMeshedPrimitiveBoundedSurface, rnode), m_context));
+	fillSides(m_context);
+}
 
-	Step::String quantityName;
-	bool materialFound = false;
-	for (environmentIter = environmentNames.begin(); environmentIter != environmentNames.end(); ++environmentIter)
+// In parallel mode the surface only gets a slot in its parent, the subtree is built later by a task
+//
+void FileInterface::dispatchMgmMeshedPrimitiveBoundedSurface(
+	tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMeshedPrimitiveBoundedSurface, TasNode* rnode)
+{
+	if (m_pending_surfaces == nullptr)
 	{
-		Step::String environmentName = (*environmentIter);
-		for (materialIter = materialIds.begin(); materialIter != materialIds.end(); ++materialIter)
-		{
-			Step::String materialId = (*materialIter);
-			if (materialId == nrfMaterial->getId())
-			{
-				materialFound = true;
-
-				material->massDensity = processQuantityValue(materialPropertiesTable, environmentName, materialId, "mass_density");
-				material->specificHeatCapacity = processQuantityValue(materialPropertiesTable, environmentName, materialId, "constant_pressure_specific_heat_capacity");
-				material->thermalConductivity = processQuantityValue(materialPropertiesTable, environmentName, materialId, "thermal_conductivity");
-			}
-		}
+		processMgmMeshedPrimitiveBoundedSurface(mgmMeshedPrimitiveBoundedSurface, rnode);
+		return;
 	}
+	rnode->Children.push_back(nullptr);
+	m_pending_surfaces->push_back({ mgmMeshedPrimitiveBoundedSurface, rnode, rnode->Children.size() - 1,
+		placeSurface(mgmMeshedPrimitiveBoundedSurface, rnode) });
 }
 
-void FileInterface::processMgmMeshedPrimitiveBoundedSurface(
-	tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMeshedPrimitiveBoundedSurface, TasNode* rnode)
+// The callers have already marked the surface as processed and report the progress. Everything built
+// goes to the context: nodes, ids, strings, entity counts, geometry and thermal index. What is shared is
+// the SDK dataset, which a task only reads holding m_sdk_read_mutex.
+//
+TasNode* FileInterface::buildMgmMeshedPrimitiveBoundedSurface(
+	tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMeshedPrimitiveBoundedSurface, Transform* transform, BuildContext& ctx)
 
 {
-	TasNode* node = new BoundedSurface();
-	rnode->addChild(node);
-	processNrfNamedObservableItem(mgmMeshedPrimitiveBoundedSurface, node);
+	TasNode* node = ctx.arena.create<BoundedSurface>();
+	processNrfNamedObservableItem(mgmMeshedPrimitiveBoundedSurface, node, ctx, false);
 	BoundedSurface* surface = nullptr;
 	if (mgmMeshedPrimitiveBoundedSurface->testSurface())
 	{
 		tas_arm::Mgm_primitive_bounded_surface* mgmPrimitiveBoundedSurface = 0;
 		mgmPrimitiveBoundedSurface = mgmMeshedPrimitiveBoundedSurface->getSurface();
 		Step::Id entityId = mgmPrimitiveBoundedSurface->getKey();
-		std::string surfaceType = mgmPrimitiveBoundedSurface->type();
-		if (surfaceType == "Mgm_rectangle")
-		{
-			tas_arm::Mgm_rectangle* mgmRectangle = 0;
-			mgmRectangle = m_dataSet->getMgm_rectangle(entityId);
-			Rectangle* rect = new Rectangle();
-			processMgmRectangle(mgmRectangle, rect);
-			surface = rect;
-		}
-		else if (surfaceType == "Mgm_quadrilateral")
-		{
-			tas_arm::Mgm_quadrilateral* mgmQuad = 0;
-			mgmQuad = m_dataSet->getMgm_quadrilateral(entityId);
-			Quadrilateral* quad = new Quadrilateral();
-			processMgmQuadrilateral(mgmQuad, quad);
-			surface = quad;
-		}
-
-		else if (surfaceType == "Mgm_sphere")
+		SurfaceHandler handler = SurfaceHandlers[(size_t)entityKindOf(mgmPrimitiveBoundedSurface)];
+		if (handler != nullptr)
 		{
-			tas_arm::Mgm_sphere* mgmSphere = 0;
-			mgmSphere = m_dataSet->getMgm_sphere(entityId);
-			Sphere* sphere = new Sphere();
-			processMgmSphere(mgmSphere, sphere);
-			surface = sphere;
+			surface = (this->*handler)(mgmPrimitiveBoundedSurface, ctx);
 		}
 		else
 		{
-			surface = new BoundedSurface();
+			surface = ctx.arena.create<BoundedSurface>();
 		}
 		surface->id = entityId;
-		surface->classType = surfaceType;
+		surface->classType = ctx.strings.intern(mgmPrimitiveBoundedSurface->type());
+		ctx.countEntity(mgmPrimitiveBoundedSurface);
 	}
 
 	if (mgmMeshedPrimitiveBoundedSurface->testActive_side())
@@ -588,26 +982,31 @@ void FileInterface::processMgmMeshedPrimitiveBoundedSurface(
 		surface->activeside = (ActiveSide)mgmMeshedPrimitiveBoundedSurface->getActive_side();
 	}
 
-	if (mgmMeshedPrimitiveBoundedSurface->testTransformation())
+	// number of faces along each parameter direction, 0 when the file leaves it unset
+	if (surface != nullptr && mgmMeshedPrimitiveBoundedSurface->testDir1_meshing())
+	{
+		surface->dir1_meshing = (int)mgmMeshedPrimitiveBoundedSurface->getDir1_meshing();
+	}
+
+	if (surface != nullptr && mgmMeshedPrimitiveBoundedSurface->testDir2_meshing())
 	{
-		tas_arm::Mgm_axis_transformation* mgmAxisTransformation = 0;
-		mgmAxisTransformation = mgmMeshedPrimitiveBoundedSurface->getTransformation();
-		processMgmAxisTransformation(mgmAxisTransformation, surface);
+		surface->dir2_meshing = (int)mgmMeshedPrimitiveBoundedSurface->getDir2_meshing();
 	}
 
 	if (surface != nullptr)
 	{
+		surface->transformation = transform;
 		node->addChild(surface);
 	}
 	else
-		return;
+		return node;
 	// The rest is surface related
 	if (mgmMeshedPrimitiveBoundedSurface->testSide1_surface_material())
 	{
 		tas_arm::Nrf_material* material = 0;
 		material = mgmMeshedPrimitiveBoundedSurface->getSide1_surface_material();
 		surface->side1_material = material->getKey();
-		surface->side1_material_name = material->getName().toLatin1();
+		surface->side1_material_name = ctx.strings.intern(material->getName().toLatin1());
 	}
 
 	if (mgmMeshedPrimitiveBoundedSurface->testSide2_surface_material())
@@ -615,7 +1014,7 @@ void FileInterface::processMgmMeshedPrimitiveBoundedSurface(
 		tas_arm::Nrf_material* material = 0;
 		material = mgmMeshedPrimitiveBoundedSurface->getSide2_surface_material();
 		surface->side2_material = material->getKey();
-		surface->side2_material_name = material->getName().toLatin1();
+		surface->side2_material_name = ctx.strings.intern(material->getName().toLatin1());
 	}
 
 	if (mgmMeshedPrimitiveBoundedSurface->testSide1_bulk_material())
@@ -629,82 +1028,120 @@ void FileInterface::processMgmMeshedPrimitiveBoundedSurface(
 	{
 		tas_arm::Nrf_material* material = 0;
 		material = mgmMeshedPrimitiveBoundedSurface->getSide2_bulk_material();
-		surface->side1_material = material->getKey();
+		surface->side2_material = material->getKey();
 	}
 
-	if (mgmMeshedPrimitiveBoundedSurface->testSide1_faces())
+	// with the bulk density of the side material, gives the mass of the side
+	if (mgmMeshedPrimitiveBoundedSurface->testSide1_thickness())
 	{
-		if (mgmMeshedPrimitiveBoundedSurface->testSide1_faces())
-		{
-			tas_arm::List_Mgm_face_1_n& faces = mgmMeshedPrimitiveBoundedSurface->getSide1_faces();
-			TasNode* facenode1 = new TasNode();
-			bool active = (surface->activeside == SIDE1 || surface->activeside == BOTH);
-			const string actives = ((active) ? "Active)" : "Not Active)");
-			facenode1->label = string("Side(") + actives;
-			facenode1->name = "Side 1";
-			facenode1->id = getNewId();
-			facenode1->classType = surface->classType + "/Side1";
-			surface->addChild(facenode1);
+		surface->side1_thickness = QuantityValuePrescription_value(mgmMeshedPrimitiveBoundedSurface->getSide1_thickness());
+	}
 
-			for (auto face : faces)
-			{
-				Face* facenode = new Face();
-				facenode1->addChild(facenode);
-				if (face->testCorresponding_node()) {
-					facenode->name = face.get()->getCorresponding_node()->getId().toLatin1();
-					facenode->nrf_network_node = face.get()->getCorresponding_node()->getId().toLatin1();
-					facenode->classType = face.get()->getCorresponding_node()->getClassType().getName();
-					facenode->id = face.get()->getCorresponding_node()->getKey();
-					facenode->label = "Node on Face";
-					auto model = face.get()->getCorresponding_node()->getContaining_model();
-					if (model->testName()) {
-						facenode->nrf_model = model->getName().toLatin1();
-					}
+	if (mgmMeshedPrimitiveBoundedSurface->testSide2_thickness())
+	{
+		surface->side2_thickness = QuantityValuePrescription_value(mgmMeshedPrimitiveBoundedSurface->getSide2_thickness());
+	}
 
-				}
+	ctx.geometry.addSurface(surface);
 
-				facenode->classType = face.get()->getClassType().getName();
-				facenode->id = face.get()->getKey();
-				if (facenode->id == 0) facenode->id = getNewId();
-			}
-		}
+	if (mgmMeshedPrimitiveBoundedSurface->testSide1_faces())
+	{
+		buildSide(mgmMeshedPrimitiveBoundedSurface->getSide1_faces(), SIDE1, surface, node, ctx);
 	}
 
 	if (mgmMeshedPrimitiveBoundedSurface->testSide2_faces())
 	{
-		if (mgmMeshedPrimitiveBoundedSurface->testSide2_faces())
+		buildSide(mgmMeshedPrimitiveBoundedSurface->getSide2_faces(), SIDE2, surface, node, ctx);
+	}
+	return node;
+}
 
-		{
-			tas_arm::List_Mgm_face_1_n& faces = mgmMeshedPrimitiveBoundedSurface->getSide2_faces();
-			TasNode* facenode2 = new TasNode();
-			bool active = (surface->activeside == SIDE2 || surface->activeside == BOTH);
-			const string actives = ((active) ? "Active)" : "Not Active)");
-			facenode2->label = "Side(" + actives;
+// The faces only go to the face table of the side, their Face nodes are created by materializeFaces
+// when the children of the side are asked for. Only the SDK reads are done here, fillSides interns
+// the rows once a task has released the SDK.
+//
+void FileInterface::buildSide(tas_arm::List_Mgm_face_1_n& faces, ActiveSide which,
+	BoundedSurface* surface, TasNode* node, BuildContext& ctx)
+{
+	Side* sidenode = ctx.arena.create<Side>();
+	sidenode->side = which;
+	bool active = (surface->activeside == which || surface->activeside == BOTH);
+	const string actives = ((active) ? "Active)" : "Not Active)");
+	const char* suffix = (which == SIDE1) ? "1" : "2";
+	sidenode->label = ctx.strings.intern("Side(" + actives);
+	sidenode->name = ctx.strings.intern(string("Side ") + suffix);
+	ctx.assignId(sidenode->id);
+	sidenode->classType = ctx.strings.intern(surface->classType.str() + "/Side" + suffix);
+	surface->addChild(sidenode);
+
+	ctx.sides.push_back({ sidenode, node, {} });
+	std::vector<BuildContext::FaceRow>& rows = ctx.sides.back().rows;
+	rows.reserve(faces.size());
+	for (auto& face : faces)
+	{
+		ctx.countEntity(face.get());
+		BuildContext::FaceRow row;
+		row.key = face.get()->getKey();
+		if (face->testCorresponding_node()) {
+			row.hasNode = true;
+			row.networkNode = face.get()->getCorresponding_node()->getId().toLatin1();
+			auto containing = face.get()->getCorresponding_node()->getContaining_model();
+			if (containing->testName()) {
+				row.hasModel = true;
+				row.model = containing->getName().toLatin1();
+			}
+		}
+		row.classType = face.get()->getClassType().getName();
+		rows.push_back(std::move(row));
+	}
+}
 
-			facenode2->name = "Side 2";
-			facenode2->id = getNewId();
-			facenode2->classType = surface->classType + "/Side2";
-			surface->addChild(facenode2);
+void FileInterface::fillSides(BuildContext& ctx)
+{
+	for (BuildContext::SideRows& side : ctx.sides)
+	{
+		FaceTable& table = side.side->faces;
+		table.setStrings(&ctx.strings);
+		table.reserve(side.rows.size());
+		for (const BuildContext::FaceRow& row : side.rows)
+		{
+			int networkNode = row.hasNode ? ctx.strings.internId(row.networkNode) : -1;
+			int model = row.hasModel ? ctx.strings.internId(row.model) : -1;
+			table.add(row.key, networkNode, model, ctx.strings.internId(row.classType));
+		}
+		// a face without a key gets its id here, the node table, the node index and the Face nodes
+		// all read it from the table
+		for (int row = 0; row < table.size(); row++)
+		{
+			if (table.getFaceId(row) == 0) ctx.assignId(table.faceId(row));
+		}
+		if (table.size() > 0) side.side->pendingExpansion = ctx.owner;
+		ctx.thermal.addFaces(side.side, side.surface);
+	}
+	ctx.sides.clear();
+}
 
-			for (auto face : faces)
-			{
-				Face* facenode = new Face();
-				facenode2->addChild(facenode);
-				if (face->testCorresponding_node()) {
-					facenode->name = face.get()->getCorresponding_node()->getId().toLatin1();
-					facenode->nrf_network_node = face.get()->getCorresponding_node()->getId().toLatin1();
-					facenode->classType = face.get()->getCorresponding_node()->getClassType().getName();
-					facenode->label = "Node on Face";
-					auto model = face.get()->getCorresponding_node()->getContaining_model();
-					if (model->testName()) {
-						facenode->nrf_model = model->getName().toLatin1();
-					}
-				}
-				facenode->classType = face.get()->getClassType().getName();
-				facenode->id = face.get()->getKey();
-				if (facenode->id == 0) facenode->id = getNewId();
-			}
+// Same fields as the face nodes built before the face tables.
+//
+void FileInterface::materializeFaces(Side* side)
+{
+	FaceTable& table = side->faces;
+	const PooledString nodeOnFace = m_strings.intern("Node on Face");
+	side->Children.reserve(side->Children.size() + table.size());
+	for (int row = 0; row < table.size(); row++)
+	{
+		Face* facenode = m_arena.create<Face>();
+		side->addChild(facenode);
+		if (table.hasNetworkNode(row))
+		{
+			facenode->name = table.text(table.getNetworkNodeId(row));
+			facenode->nrf_network_node = facenode->name;
+			facenode->label = nodeOnFace;
+			facenode->nrf_model = table.text(table.getModelId(row));
 		}
+		facenode->classType = table.text(table.getClassTypeId(row));
+		facenode->id = table.getFaceId(row);
+		facenode->status = side->faceStatus();
 	}
 }
 
@@ -715,11 +1152,11 @@ void FileInterface::processMeshedGeometricModel(
 
 {
 	// Model root object
-	TasNode* node = new TasNode();
+	TasNode* node = m_arena.create<TasNode>();
 	node->id = getNewId();
 	rnode->addChild(node);
 
-	processNrfNamedObservableItem(mgmMeshedGeometricModel, node);
+	processNrfNamedObservableItem(mgmMeshedGeometricModel, node, m_context);
 	Already(mgmMeshedGeometricModel->getKey());
 	Already(mgmMeshedGeometricModel->getRoot_item()->getKey());
 
@@ -731,8 +1168,10 @@ void FileInterface::processMeshedGeometricModel(
 		{
 			Step::Id entityId = material->getKey();
 			tas_arm::Nrf_material* nrfMaterial = 0;
-			nrfMaterial = m_dataSet->getNrf_material(entityId);
-			Material* mat = new Material();
+			nrfMaterial = material.get();
+			Material* mat = m_arena.create<Material>();
+			processBulkMaterial(nrfMaterial, mat);
+			m_material_index.setStepId((long)entityId, m_material_index.findMaterial(nrfMaterial->getId().toUTF8()));
 			addMaterial(entityId, mat);
 		}
 	}
@@ -743,23 +1182,28 @@ void FileInterface::processMeshedGeometricModel(
 		tas_arm::List_Nrf_network_node_0_n::iterator it;
 		for (it = nodes.begin(); it != nodes.end(); ++it)
 		{
+			throwIfCancelled();
 			Step::Id entityId = (*it)->getKey();
 			if (isAlready(entityId)) { continue; }
 			Already(entityId);
 
-			std::string nodeType = (*it)->type();
-			if (nodeType == "Mgm_compound_meshed_geometric_item")
+			switch (entityKindOf(it->get()))
 			{
-				tas_arm::Mgm_compound_meshed_geometric_item* mgmCMGI = 0;
-				mgmCMGI = m_dataSet->getMgm_compound_meshed_geometric_item(entityId);
-				processMgmCompoundMeshedGeometricItem(mgmCMGI, node);
-			}
-			else if (nodeType == "Mgm_meshed_primitive_bounded_surface") {
+			case EntityKind::COMPOUND_MESHED_GEOMETRIC_ITEM:
+				if (auto compound = entityCast<tas_arm::Mgm_compound_meshed_geometric_item>(it->get()))
+				{
+					processMgmCompoundMeshedGeometricItem(compound, node);
+				}
+				break;
+			case EntityKind::MESHED_PRIMITIVE_BOUNDED_SURFACE:
 				// Normally we should not get any of these as they should have been correctly handled by the compound meshed geometry exploration
-
-				tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMPBS = 0;
-				mgmMPBS = m_dataSet->getMgm_meshed_primitive_bounded_surface(entityId);
-				processMgmMeshedPrimitiveBoundedSurface(mgmMPBS, node);
+				if (auto surface = entityCast<tas_arm::Mgm_meshed_primitive_bounded_surface>(it->get()))
+				{
+					dispatchMgmMeshedPrimitiveBoundedSurface(surface, node);
+				}
+				break;
+			default:
+				break;
 			}
 		}
 	}
@@ -777,35 +1221,185 @@ void FileInterface::processNrfRootCollection(tas_arm::Nrf_root* nrfRoot)
 		{
 			tas_arm::Nrf_network_model* nrfNetworkModel = model.get();
 
-			// not very object oriented to switch on a type field, but keeping it simple
-
-			string networkModelType = model->type();
-			if (networkModelType == "Mgm_meshed_geometric_model")
+			if (entityKindOf(model.get()) == EntityKind::MESHED_GEOMETRIC_MODEL)
 			{
-				TasNode* node = new TasNode(); // LINK to root
+				TasNode* node = m_arena.create<TasNode>(); // LINK to root
 				node->id = getNewId();
 				m_rootnode = node;
 
-				cout << "Process geo model " << endl;
+				STI_LOG(LOG_DEBUG, "Process geo model #" << model->getKey());
 				Step::Id entityId = model->getKey();
 				if (isAlready(entityId)) { continue; }
 				tas_arm::Mgm_meshed_geometric_model* mgmMeshedGeometricModel = 0;
-				mgmMeshedGeometricModel = m_dataSet->getMgm_meshed_geometric_model(entityId);
-				processMeshedGeometricModel(mgmMeshedGeometricModel, node);
+				mgmMeshedGeometricModel = entityCast<tas_arm::Mgm_meshed_geometric_model>(nrfNetworkModel);
+				if (mgmMeshedGeometricModel == nullptr) { continue; }
+				if (m_options.threadCount == 1)
+				{
+					processMeshedGeometricModel(mgmMeshedGeometricModel, node);
+				}
+				else
+				{
+					// walk the compound hierarchy first, then build the surfaces in parallel
+					std::vector<PendingSurface> pending;
+					m_pending_surfaces = &pending;
+					processMeshedGeometricModel(mgmMeshedGeometricModel, node);
+					m_pending_surfaces = nullptr;
+					processPendingSurfaces(pending);
+				}
 			}
 			else
 			{
-				//cout << "Process network " << endl;
+				STI_LOG(LOG_DEBUG, "Process network model #" << model->getKey());
+				if (isAlready(model->getKey())) { continue; }
+				processNrfNetworkModel(nrfNetworkModel);
+			}
+		}
+		m_conductor_graph.finalize();
+	}
+}
 
-				// processNrfNetworkModel(model.get(),node);
+// Key of a network node in the conductor graph, the same as the faces' network node in buildSide
+//
+int FileInterface::conductorNode(tas_arm::Nrf_network_node* networkNode)
+{
+	string model;
+	auto containing = networkNode->getContaining_model();
+	if (containing != nullptr && containing->testName()) model = containing->getName().toLatin1();
+	return m_conductor_graph.addNode(model, networkNode->getId().toLatin1());
+}
+
+// The nodes and couplings of a network model other than the meshed geometric model. The listed
+// nodes are numbered first so an isolated node still gets a row, then every coupling between two
+// nodes becomes a conductor, valued with its prescription when it has one.
+//
+void FileInterface::processNrfNetworkModel(tas_arm::Nrf_network_model* nrfNetworkModel)
+{
+	countEntity(nrfNetworkModel);
+	if (nrfNetworkModel->testNodes())
+	{
+		for (auto& networkNode : nrfNetworkModel->getNodes())
+		{
+			conductorNode(networkNode.get());
+		}
+	}
+	if (!nrfNetworkModel->testNode_relationships()) return;
+
+	for (auto& relationship : nrfNetworkModel->getNode_relationships())
+	{
+		countEntity(relationship.get());
+		if (!relationship->testRelating_node() || !relationship->testRelated_node()) continue;
+		int from = conductorNode(relationship->getRelating_node());
+		int to = conductorNode(relationship->getRelated_node());
+		double value = std::numeric_limits<double>::quiet_NaN();
+		if (relationship->testValue())
+		{
+			value = QuantityValuePrescription_value(relationship->getValue());
+		}
+		m_conductor_graph.addConductor(from, to, value);
+	}
+}
+
+// Build the pending surface subtrees on a work stealing pool.
+// The surfaces are split in chunks of consecutive surfaces (document order), each chunk builds its
+// fragment in its own arena, geometry store, string pool and entity counts. The SDK is not documented as
+// safe to read from several threads, so a task holds m_sdk_read_mutex while it reads a surface and
+// interns the face rows after releasing it. The chunks run in waves of one per worker: between two
+// waves this thread stitches the fragments, reports the progress and checks the cancellation.
+// The fragments are stitched in chunk order: the surfaces fill the slots reserved in their parents and
+// the synthetic ids are handed out in the same order as the serial path would have done, so both paths
+// give the same tree.
+//
+void FileInterface::processPendingSurfaces(std::vector<PendingSurface>& pending)
+{
+	if (pending.empty()) return;
+
+	struct Fragment
+	{
+		size_t first;
+		size_t last;
+		NodeArena arena{ 64 * 1024 };
+		GeometryStore geometry;
+		ThermalNodeIndex thermal;
+		StringPool strings;
+		std::unordered_map<string, long> entityCounts;
+		std::vector<long*> deferredIds;
+		std::vector<TasNode*> nodes;
+	};
+
+	std::unique_ptr<WorkStealingPool> ownPool;
+	if (m_shared_pool == nullptr) ownPool.reset(new WorkStealingPool(m_options.threadCount));
+	WorkStealingPool& pool = (m_shared_pool != nullptr) ? *m_shared_pool : *ownPool;
+	const size_t chunk = std::max<size_t>(1, std::min<size_t>(256, pending.size() / (8 * pool.threadCount())));
+
+	std::vector<std::unique_ptr<Fragment>> fragments;
+	for (size_t first = 0; first < pending.size(); first += chunk)
+	{
+		std::unique_ptr<Fragment> fragment(new Fragment());
+		fragment->first = first;
+		fragment->last = std::min(first + chunk, pending.size());
+		fragments.push_back(std::move(fragment));
+	}
+
+	const size_t wave = (size_t)pool.threadCount();
+	for (size_t start = 0; start < fragments.size(); start += wave)
+	{
+		const size_t end = std::min(start + wave, fragments.size());
+		{
+			TaskGroup group(pool);
+			for (size_t k = start; k < end; k++)
+			{
+				Fragment* f = fragments[k].get();
+				group.run([this, f, &pending]()
+					{
+						BuildContext ctx{ f->arena, f->geometry, f->thermal, f->strings, this, &f->deferredIds, &f->entityCounts };
+						for (size_t i = f->first; i < f->last; i++)
+						{
+							{
+								std::lock_guard<std::mutex> lock(m_sdk_read_mutex);
+								f->nodes.push_back(buildMgmMeshedPrimitiveBoundedSurface(pending[i].surface, pending[i].transform, ctx));
+							}
+							fillSides(ctx);
+						}
+					});
 			}
+			group.wait();
 		}
+
+		int built = 0;
+		for (size_t k = start; k < end; k++)
+		{
+			Fragment& fragment = *fragments[k];
+			std::unordered_map<int, int> ids; // string ids of the fragment pool in m_strings
+			for (size_t i = fragment.first; i < fragment.last; i++)
+			{
+				TasNode* node = fragment.nodes[i - fragment.first];
+				pending[i].parent->Children[pending[i].slot] = node;
+				node->parent = pending[i].parent;
+				moveStrings(node, m_strings, ids);
+			}
+			for (long* id : fragment.deferredIds)
+			{
+				*id = getNewId();
+			}
+			if (!fragment.entityCounts.empty())
+			{
+				std::lock_guard<std::mutex> lock(m_entity_count_mutex);
+				for (const auto& count : fragment.entityCounts) m_entity_counts[count.first] += count.second;
+			}
+			m_geometry.append(fragment.geometry);
+			m_thermal_index.append(fragment.thermal);
+			m_arena.adopt(fragment.arena);
+			built += (int)(fragment.last - fragment.first);
+			fragments[k].reset();
+		}
+		advanceProgress(built);
 	}
 }
 
 void FileInterface::processDataSet()
 {
 	if (m_dataSet != nullptr) {
+		PhaseTimer timer(m_options.collectStatistics, m_load_statistics.headerTime);
 		Step::SPFHeader& header = m_dataSet->getHeader();
 		Step::SPFHeader::FileName& fName = header.getFileName();
 		Step::SPFHeader::FileSchema& schema = header.getFileSchema();
@@ -824,6 +1418,11 @@ void FileInterface::processDataSet()
 	tas_arm::Nrf_root* nrfRoot = m_dataSet->getRoot();
 
 	m_root = nrfRoot;
+	{
+		PhaseTimer timer(m_options.collectStatistics, m_load_statistics.materialTime);
+		buildMaterialIndex();
+	}
+	PhaseTimer timer(m_options.collectStatistics, m_load_statistics.treeTime);
 	processNrfRootCollection(nrfRoot);
 }
 
@@ -832,15 +1431,10 @@ void FileInterface::addMaterial(Step::Id theId, sti::Material* theMat)
 	m_material_map[theId] = theMat;
 }
 
-sti::Material  FileInterface::getMaterial(Step::Id theId)
-
+sti::Material* FileInterface::getMaterial(Step::Id theId)
 {
-	sti::Material mat;
 	auto it = m_material_map.find(theId);
-	if (it == m_material_map.end()) {
-		return mat;
-	}
-	else return *(*it).second;
+	return it != m_material_map.end() ? it->second : nullptr;
 }
 
 // process one file.
@@ -850,23 +1444,207 @@ bool FileInterface::processStepTasFile(const string& fileName)
 {
 	if (!isFile(fileName))
 	{
-		cerr << "cannot find file " << fileName << endl;
+		STI_LOG(LOG_ERROR, "cannot find file " << fileName);
 		return false;
 	}
+	const bool timed = m_options.collectStatistics;
+	m_load_statistics.enabled = timed;
+	PhaseTimer total(timed, m_load_statistics.totalTime);
+
+	// one mapping of the source serves the entity pre-scan and the snapshot key, it is released
+	// before the SDK reads the file
+	SnapshotKey key;
+	string snapshot;
+	report(PHASE_SCAN, 0);
+	{
+		MappedFile source;
+		if (source.open(fileName))
+		{
+			{
+				PhaseTimer timer(timed, m_load_statistics.scanTime);
+				scanPart21Entities(source.data(), source.size(), m_statistics);
+			}
+			report(PHASE_SCAN, 100, m_statistics.entityCount(), m_statistics.entityCount());
+			if (!m_options.cacheDirectory.empty())
+			{
+				key = computeSnapshotKey(source.data(), source.size());
+				snapshot = snapshotPath(m_options.cacheDirectory, key);
+			}
+		}
+	}
+	bool restored = false;
+	if (!snapshot.empty())
+	{
+		PhaseTimer timer(timed, m_load_statistics.snapshotTime);
+		restored = loadSnapshot(snapshot, key);
+	}
+	if (restored)
+	{
+		{
+			PhaseTimer timer(timed, m_load_statistics.indexTime);
+			m_node_index.build(m_rootnode);
+		}
+		m_progress = 100;
+		m_load_statistics.fromSnapshot = true;
+		finishLoadStatistics();
+		report(PHASE_DONE, 100);
+		return true;
+	}
+	reserveStorage();
 
-	m_dataSet = new tas_arm_support::ExpressDataSet_tas_arm_support();
+	// the SDK calls cannot be interrupted, cancellation is checked between them
+	// and at every entity boundary of the processing
+	try
+	{
+		throwIfCancelled();
+		report(PHASE_PARSE, 0);
+		m_dataSet = new tas_arm_support::ExpressDataSet_tas_arm_support();
 
-	m_dataSet->loadP21File(fileName.c_str());
-	if (m_dataSet.valid())
+		{
+			std::lock_guard<std::mutex> lock(sdkMutex());
+			PhaseTimer timer(timed, m_load_statistics.parseTime);
+			m_dataSet->loadP21File(fileName.c_str());
+		}
+		throwIfCancelled();
+		report(PHASE_PARSE, 100);
+		if (!m_dataSet.valid())
+		{
+			STI_LOG(LOG_ERROR, "cannot read " << fileName);
+			return false;
+		}
+		// lazy mode too: only the tree is built on demand, the later expansions read instantiated entities
+		report(PHASE_INSTANTIATE, 0, 0, m_statistics.entityCount());
+		{
+			std::lock_guard<std::mutex> lock(sdkMutex());
+			PhaseTimer timer(timed, m_load_statistics.instantiateTime);
+			m_dataSet->instantiateAll();
+		}
+		throwIfCancelled();
+		report(PHASE_INSTANTIATE, 100, m_statistics.entityCount(), m_statistics.entityCount());
+		{
+			// the surface tasks read under m_sdk_read_mutex, not this lock, and TaskGroup::wait only
+			// helps with the tasks of its group, never with the load of another file
+			std::lock_guard<std::mutex> lock(sdkMutex());
+			m_dataSet->registerLoadedStepTasArmDataset();
+			report(PHASE_PROCESS, 0, 0, m_progress_total);
+			processDataSet();
+		}
+		report(PHASE_PROCESS, 100, m_surfaces_built, m_progress_total);
+		// a lazy tree is indexed on the first lookup, building the index reads the whole model
+		if (!m_options.lazy)
+		{
+			{
+				PhaseTimer timer(timed, m_load_statistics.indexTime);
+				m_node_index.build(m_rootnode);
+			}
+			// a lazy tree is incomplete, only a full load is cached
+			PhaseTimer timer(timed, m_load_statistics.snapshotTime);
+			if (!snapshot.empty() && !saveSnapshot(snapshot, key))
+			{
+				STI_LOG(LOG_WARNING, "cannot write snapshot " << snapshot);
+			}
+		}
+	}
+	catch (const LoadCancelled&)
 	{
-		m_dataSet->instantiateAll();
-		m_dataSet->registerLoadedStepTasArmDataset();
-		processDataSet();
+		// the partial tree is released with the FileInterface, see LoadJob
+		m_pending_surfaces = nullptr;
+		return false;
 	}
 
+	finishLoadStatistics();
+	report(PHASE_DONE, 100);
 	return true;
 }
 
+// The entity counts go from the map filled during the load to a sorted list, the arena counters are
+// read once the tree is complete.
+//
+void FileInterface::finishLoadStatistics()
+{
+	if (!m_options.collectStatistics) return;
+	std::lock_guard<std::mutex> lock(m_entity_count_mutex);
+	m_load_statistics.entities.assign(m_entity_counts.begin(), m_entity_counts.end());
+	std::sort(m_load_statistics.entities.begin(), m_load_statistics.entities.end());
+	m_load_statistics.nodesAllocated = (long)m_arena.objectCount();
+	m_load_statistics.arenaBytes = (long long)m_arena.bytesReserved();
+	m_load_statistics.internedStrings = (long)m_strings.count();
+}
+
+void FileInterface::addEntityCount(const string& type)
+{
+	std::lock_guard<std::mutex> lock(m_entity_count_mutex);
+	m_entity_counts[type]++;
+}
+
+void FileInterface::SetProgress(ProgressCallback* callback, const LoadCancellation* token)
+{
+	std::lock_guard<std::mutex> lock(m_callback_mutex);
+	m_callback = callback;
+	m_cancel = token;
+}
+
+// Reports are serialized and never go backwards within a phase, whatever the thread they come from.
+//
+void FileInterface::report(LoadPhase phase, int percent, int processed, int total)
+{
+	std::lock_guard<std::mutex> lock(m_callback_mutex);
+	if (m_callback == nullptr) return;
+	if (phase == m_reported_phase && percent <= m_reported_percent) return;
+	m_reported_phase = phase;
+	m_reported_percent = percent;
+	m_callback->onProgress(phase, percent, processed, total);
+}
+
+// Sizes the containers of the load from the pre-scan counts, so they do not grow while the tree is built.
+//
+void FileInterface::reserveStorage()
+{
+	m_progress_total = m_statistics.countOf("MGM_MESHED_PRIMITIVE_BOUNDED_SURFACE");
+	int faces = m_statistics.countOf("MGM_FACE");
+	int compounds = m_statistics.countOf("MGM_COMPOUND_MESHED_GEOMETRIC_ITEM");
+	int networkNodes = m_statistics.countOf("NRF_NETWORK_NODE");
+
+	m_already_processed.reserve((size_t)m_progress_total + compounds + networkNodes);
+	m_material_map.reserve(m_statistics.countOf("NRF_MATERIAL"));
+
+	// surface, primitive, two sides and the faces of every meshed surface. Parallel tasks build in
+	// their own arenas and a lazy load only builds the first levels
+	if (m_options.threadCount == 1 && !m_options.lazy)
+	{
+		m_arena.reserve((size_t)m_progress_total * (sizeof(BoundedSurface) + sizeof(Sphere) + 2 * sizeof(TasNode))
+			+ (size_t)faces * sizeof(Face));
+	}
+}
+
+void FileInterface::advanceProgress(int surfaces)
+{
+	throwIfCancelled();
+	int built = (m_surfaces_built += surfaces);
+	if (m_progress_total <= 0) return;
+	int percent = (int)std::min<long long>(100, (long long)built * 100 / m_progress_total);
+	int previous = m_progress.load(std::memory_order_relaxed);
+	while (percent > previous)
+	{
+		// only the thread moving the percentage reports it
+		if (m_progress.compare_exchange_weak(previous, percent, std::memory_order_relaxed))
+		{
+			report(PHASE_PROCESS, percent, built, m_progress_total);
+			break;
+		}
+	}
+}
+
+FileInterface::~FileInterface()
+{
+	// the whole tree lives in the arena: release it before the SDK dataset it was built from
+	m_material_map.clear();
+	m_rootnode = nullptr;
+	m_arena.clear();
+	std::lock_guard<std::mutex> lock(sdkMutex());
+	m_dataSet = 0;
+}
+
 void FileInterface::PrintTree()
 {
 	PrintNode(m_rootnode, 0);
@@ -875,16 +1653,16 @@ void FileInterface::PrintTree()
 void  FileInterface::PrintNode(TasNode* node, int indent)
 {
 	int n = indent * 5;
-	cout << string(n, ' ') << "Node Id  " << node->name << endl;
-	cout << string(n, ' ') << "Node Label  " << node->label << endl;
-	cout << string(n, ' ') << "Node Type  " << node->classType << endl;
-	cout << string(n, ' ') << "Node Entity #" << node->id << endl;
+	STI_LOG(LOG_INFO, string(n, ' ') << "Node Id  " << node->name);
+	STI_LOG(LOG_INFO, string(n, ' ') << "Node Label  " << node->label);
+	STI_LOG(LOG_INFO, string(n, ' ') << "Node Type  " << node->classType);
+	STI_LOG(LOG_INFO, string(n, ' ') << "Node Entity #" << node->id);
 	int cnt = 0;
-	cout << string(n, ' ') << "Number of children: " << node->Children.size() << endl;
+	STI_LOG(LOG_INFO, string(n, ' ') << "Number of children: " << node->Children.size());
 	indent++;
 	for (TasNode* child : node->Children)
 	{
-		cout << string(n, ' ') << indent << "-" << cnt++ << " " << endl;
+		STI_LOG(LOG_INFO, string(n, ' ') << indent << "-" << cnt++ << " ");
 		PrintNode(child, indent);
 	}
 }
@@ -896,11 +1674,110 @@ void FileInterface::Already(Step::Id theId)
 
 bool FileInterface::isAlready(Step::Id theId)
 {
-	return m_already_processed.find(theId) != m_already_processed.end();
+	// every caller skips the entity when it is already there
+	if (m_already_processed.find(theId) == m_already_processed.end()) return false;
+	m_load_statistics.duplicatesSkipped++;
+	return true;
+}
+
+// The rows never change once built: the build reads the whole lazy tree, the later expansions only
+// create the Face nodes of rows already there. The statuses do, a diff marks both trees.
+//
+NodeTable* FileInterface::GetNodeTable()
+{
+	if (!m_nodetable_built && m_rootnode != nullptr)
+	{
+		m_nodetable.build(m_rootnode);
+		m_nodetable_built = true;
+	}
+	else if (m_nodetable_built)
+	{
+		m_nodetable.refreshStatus();
+	}
+	return &m_nodetable;
+}
+
+TasNode* FileInterface::FindById(long id)
+{
+	if (!m_node_index.isBuilt()) m_node_index.build(m_rootnode);
+	return m_node_index.findById(id);
+}
+
+TasNode* FileInterface::ResolvePath(const string& path)
+{
+	if (!m_node_index.isBuilt()) m_node_index.build(m_rootnode);
+	return m_node_index.resolvePath(path);
+}
+
+// The node index walk reads the pending levels, the index is wanted anyway.
+//
+void FileInterface::readWholeTree()
+{
+	if (!m_node_index.isBuilt()) m_node_index.build(m_rootnode);
 }
 
-FileHeader FileInterface::GetFileHeader() {
-	return m_fh;
+GeometryStore* FileInterface::GetGeometry()
+{
+	readWholeTree();
+	return &m_geometry;
+}
+
+ThermalNodeIndex* FileInterface::GetThermalNodeIndex()
+{
+	if (!m_thermal_index.isFinalized())
+	{
+		readWholeTree();
+		m_thermal_index.finalize(m_rootnode);
+	}
+	return &m_thermal_index;
+}
+
+SpatialIndex* FileInterface::GetSpatialIndex()
+{
+	if (!m_spatial_index.isBuilt() && m_rootnode != nullptr)
+	{
+		readWholeTree();
+		std::unique_ptr<WorkStealingPool> ownPool;
+		if (m_shared_pool == nullptr && m_options.threadCount != 1) ownPool.reset(new WorkStealingPool(m_options.threadCount));
+		m_spatial_index.build(m_geometry, (m_shared_pool != nullptr) ? m_shared_pool : ownPool.get());
+	}
+	return &m_spatial_index;
+}
+
+MassProperties* FileInterface::GetMassProperties()
+{
+	if (!m_mass_properties.isBuilt() && m_rootnode != nullptr)
+	{
+		readWholeTree();
+		m_mass_properties.build(m_rootnode, m_geometry, m_material_index);
+	}
+	return &m_mass_properties;
+}
+
+ConductorGraph* FileInterface::GetConductorGraph()
+{
+	if (!m_conductor_graph.isLinked()) m_conductor_graph.link(*GetThermalNodeIndex());
+	return &m_conductor_graph;
+}
+
+Tessellation* FileInterface::Tessellate(const TessellationOptions& options)
+{
+	std::unique_ptr<WorkStealingPool> ownPool;
+	if (m_shared_pool == nullptr && m_options.threadCount != 1) ownPool.reset(new WorkStealingPool(m_options.threadCount));
+	Tessellation* tessellation = new Tessellation();
+	readWholeTree();
+	tessellation->build(m_rootnode, m_geometry, options, (m_shared_pool != nullptr) ? m_shared_pool : ownPool.get());
+	return tessellation;
+}
+
+const NodeHashes& FileInterface::GetNodeHashes()
+{
+	if (!m_node_hashes.isBuilt())
+	{
+		readWholeTree();
+		m_node_hashes.build(m_rootnode, m_geometry);
+	}
+	return m_node_hashes;
 }
 
 void FileInterface::SetRootNode(TasNode* rootnode) {
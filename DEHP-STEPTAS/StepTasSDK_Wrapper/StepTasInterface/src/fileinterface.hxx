@@ -29,37 +29,213 @@
 #include <tas_arm_support/ExpressDataSet_tas_arm_support.h>
 #include <tas_arm_support/MaterialPropertiesTable.h>
 #include "interface.hxx"
-#include <set>
+#include "geometrystore.hxx"
+#include "materialindex.hxx"
+#include "thermalnodeindex.hxx"
+#include "nodearena.hxx"
+#include "entitykind.hxx"
+#include "nodeindex.hxx"
+#include "nodehash.hxx"
+#include "snapshot.hxx"
+#include "filestatistics.hxx"
+#include "loadjob.hxx"
+#include "loadstatistics.hxx"
+#include "transform.hxx"
+#include "spatialindex.hxx"
+#include "massproperties.hxx"
+#include "tessellation.hxx"
+#include "conductorgraph.hxx"
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 using namespace std;
 using namespace sti;
-class __declspec(dllexport)  FileInterface
+
+class FileInterface;
+class WorkStealingPool;
+
+// Where the process functions put what they build. The serial path builds straight into the
+// FileInterface arena, geometry store and string pool. In parallel mode each task gets its own context
+// and the fragments are merged afterwards in document order, so the tree is the same as the serial one.
+struct BuildContext
+{
+	NodeArena& arena;
+	GeometryStore& geometry;
+	ThermalNodeIndex& thermal;
+	StringPool& strings;
+	FileInterface* owner;                 // serial path: ids are taken from the FileInterface counter
+	std::vector<long*>* deferredIds;  // parallel task: the ids are given when the fragment is stitched
+	std::unordered_map<string, long>* entityCounts; // parallel task: merged when the fragment is stitched
+
+	// the faces of a side as buildSide reads them from the SDK, interned by fillSides
+	struct FaceRow
+	{
+		long key = 0;
+		bool hasNode = false;
+		bool hasModel = false;
+		string networkNode;
+		string model;
+		string classType;
+	};
+	struct SideRows
+	{
+		Side* side;
+		TasNode* surface;
+		std::vector<FaceRow> rows;
+	};
+	std::vector<SideRows> sides;
+
+	// a synthetic id, in the order of the serial path
+	void assignId(long& id);
+	template <class Entity>
+	void countEntity(Entity* entity);
+};
+
+// One FileInterface is used by one thread at a time (the parallel build tasks only write to their own
+// BuildContext and read the SDK under m_sdk_read_mutex). Separate instances share no state: the duplicate set, the id counter and the material
+// map are members, so several files can be loaded at once. The only process wide step is the SDK
+// registration of a loaded dataset: processStepTasFile holds the SDK lock from the registration to the
+// end of the processing, so the files are processed one at a time.
+class __declspec(dllexport)  FileInterface final : public NodeExpander
 {
 	
 public:
 
-	TasNode GetRootNode() { return *m_rootnode; };
+	FileInterface();
+	explicit FileInterface(const LoadOptions& options);
+	~FileInterface();
+
 	void SetRootNode(TasNode* rootnode);
-	FileHeader GetFileHeader();
+	const FileHeader& GetFileHeader() const { return m_fh; };
+	NodeTable* GetNodeTable();
+	// complete: a lazy tree is read first, so the columns handed out are never reallocated
+	GeometryStore* GetGeometry();
+	MaterialIndex* GetMaterialIndex() { return &m_material_index; };
+	TasNode* FindById(long id);
+	TasNode* ResolvePath(const string& path);
+	ThermalNodeIndex* GetThermalNodeIndex();
+	SpatialIndex* GetSpatialIndex();
+	MassProperties* GetMassProperties();
+	// couplings of the network models, linked to the thermal node index on first use
+	ConductorGraph* GetConductorGraph();
+	// new Tessellation of every surface, owned by the caller
+	Tessellation* Tessellate(const TessellationOptions& options);
+	TasNode* GetRoot() { return m_rootnode; };
+	// content and subtree hashes, computed on first use
+	const NodeHashes& GetNodeHashes();
+	// entity counts of the source file, from the pre-scan
+	FileStatistics* GetStatistics() { return &m_statistics; };
+	// percentage of the meshed surfaces built so far
+	int GetProgress() const { return m_progress.load(std::memory_order_relaxed); };
+	// phase times and entity counts of the last load, filled when LoadOptions.collectStatistics is set
+	LoadStatistics* GetLoadStatistics() { return &m_load_statistics; };
+	// progress reports and cancellation of processStepTasFile, both may be null
+	void SetProgress(ProgressCallback* callback, const LoadCancellation* token);
+	// pool for the parallel surface building, null to use a pool of m_options.threadCount workers
+	void SetSharedPool(WorkStealingPool* pool) { m_shared_pool = pool; };
 	bool  processStepTasFile(const string& fileName);
 	void PrintNode(TasNode* node, int indent);
 	void PrintTree();
+	// lazy loading: reads the children of a node built with pendingExpansion set, or creates the
+	// Face nodes of a side from its face table
+	void expandNode(TasNode* node) override;
 private:
 
-	set<Step::Id> m_already_processed; // use to avoid duplicate tree items
+	unordered_set<Step::Id> m_already_processed; // use to avoid duplicate tree items
 	// STEP TAS DATA
 	tas_arm::Nrf_root* m_root;
-	TasNode* m_rootnode;
+	TasNode* m_rootnode = nullptr;
+	NodeArena m_arena; // owns every TasNode and Material of the file
+	StringPool m_strings; // text fields of the nodes
+	NodeTable m_nodetable;
+	bool m_nodetable_built = false;
+	NodeIndex m_node_index; // built after the tree, on first lookup in lazy mode
+	NodeHashes m_node_hashes;
+	GeometryStore m_geometry;
+	ThermalNodeIndex m_thermal_index; // faces registered while parsing, finalized on first use
+	SpatialIndex m_spatial_index; // built on first use
+	MassProperties m_mass_properties; // built on first use
+	ConductorGraph m_conductor_graph; // filled while parsing the network models
 	Step::RefPtr<tas_arm_support::ExpressDataSet_tas_arm_support> m_dataSet = 0;
 	//Material Map
-	map<Step::Id, Material*> m_material_map;
+	unordered_map<Step::Id, Material*> m_material_map;
+	MaterialIndex m_material_index; // property values of every material, built before the tree
 	// Exchange DATA
 	FileHeader m_fh;
 	int owncounter = 0;
 	int getNewId() { return owncounter--; }
+	friend struct BuildContext;
+
+	// pre-scan of the source file
+	FileStatistics m_statistics;
+	int m_progress_total = 0;  // meshed surfaces in the file
+	std::atomic<int> m_surfaces_built{ 0 };
+	std::atomic<int> m_progress{ 0 };
+	void reserveStorage();
+	void advanceProgress(int surfaces = 1); // meshed surfaces built, only called by the loading thread
+
+	// load instrumentation, the build tasks count in their fragment
+	LoadStatistics m_load_statistics;
+	std::mutex m_entity_count_mutex;
+	std::unordered_map<string, long> m_entity_counts;
+	template <class Entity>
+	void countEntity(Entity* entity) { if (m_options.collectStatistics) addEntityCount(entity->type()); };
+	void addEntityCount(const string& type);
+	void finishLoadStatistics();
+
+	// progress and cancellation, see LoadJob
+	struct LoadCancelled {}; // unwinds the processing back to processStepTasFile
+	ProgressCallback* m_callback = nullptr;
+	const LoadCancellation* m_cancel = nullptr;
+	std::mutex m_callback_mutex;
+	LoadPhase m_reported_phase = PHASE_SCAN;
+	int m_reported_percent = -1;
+	void report(LoadPhase phase, int percent, int processed = 0, int total = 0);
+	// called at every entity boundary of the processing
+	void throwIfCancelled() { if (m_cancel != nullptr && m_cancel->isCancelled()) throw LoadCancelled(); };
+
+	// parallel model processing
+	struct PendingSurface
+	{
+		tas_arm::Mgm_meshed_primitive_bounded_surface* surface;
+		TasNode* parent;
+		size_t slot; // index reserved in parent->Children
+		Transform* transform;
+	};
+	LoadOptions m_options;
+	BuildContext m_context; // serial build context
+	std::vector<PendingSurface>* m_pending_surfaces = nullptr; // set while collecting the parallel tasks
+	WorkStealingPool* m_shared_pool = nullptr;
+	std::mutex m_sdk_read_mutex; // the build tasks read the entities of the dataset one at a time
+
+	// snapshot cache, defined in snapshot.cxx
+	bool saveSnapshot(const string& path, const SnapshotKey& key);
+	bool loadSnapshot(const string& path, const SnapshotKey& key);
+
+	// lazy loading
+	struct LazyItem
+	{
+		tas_arm::Mgm_any_meshed_geometric_item* entity;
+		EntityKind kind; // compound item or bounded surface
+	};
+	// items each compound owns, in document order. Collected when its top level compound is opened
+	// with the same duplicate rules as the eager walk, so expanding gives the tree the eager load builds
+	std::unordered_map<Step::Id, std::vector<LazyItem>> m_lazy_children;
+	// reads every pending level of a lazy tree, after that the geometry store and the thermal node index
+	// are complete and no row is added to them
+	void readWholeTree();
+	void collectLazyChildren(tas_arm::Mgm_compound_meshed_geometric_item* compound);
+	TasNode* createLazyCompoundNode(tas_arm::Mgm_compound_meshed_geometric_item* compound, TasNode* parent);
+	void dispatchMgmMeshedPrimitiveBoundedSurface(
+		tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMeshedPrimitiveBoundedSurface, TasNode* node);
+	void processPendingSurfaces(std::vector<PendingSurface>& pending);
 	bool isAlready(Step::Id theId);
 	void Already(Step::Id theId);
 	void addMaterial(Step::Id theId, sti::Material* theMaterialNode);
-	sti::Material getMaterial(Step::Id theId);// returns a MaterialNode instance
+	sti::Material* getMaterial(Step::Id theId);// the MaterialNode in the arena, nullptr when unknown
 	void processDataSet();
 	void processNrfRoot(
 		tas_arm::Nrf_root* nrfRoot);
@@ -67,12 +243,16 @@ private:
 	//std::string stringNrfNetworkNode(tas_arm::Nrf_network_node *nrfNetworkNode,ThermalNode *tnode);
 
 	void processNrfNamedObservableItem(
-		tas_arm::Nrf_named_observable_item* namedObservableItem, sti::TasNode* node);
+		tas_arm::Nrf_named_observable_item* namedObservableItem, sti::TasNode* node, BuildContext& ctx, bool markProcessed = true);
 
 	string stringNrfRealQuantityType_unit(
 		tas_arm::Nrf_real_quantity_type* nrfRealQuantityType);
 	double QuantityValuePrescription_value(
 		tas_arm::Nrf_real_quantity_value_prescription* nrfRealQuantityValuePrescription);
+	bool angleUnitToRadians(
+		tas_arm::Nrf_any_unit* unit, double& factor, int depth = 0);
+	double angleInDegrees(
+		tas_arm::Nrf_real_quantity_value_prescription* nrfRealQuantityValuePrescription);
 	string stringMgm3dCartesianPoint(
 		tas_arm::Mgm_3d_cartesian_point* mgm3dCartesianPoint);
 	string stringMgm3dDirection(
@@ -83,6 +263,13 @@ private:
 
 	void processMgmMeshedPrimitiveBoundedSurface(
 		tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMeshedPrimitiveBoundedSurface, TasNode* node);
+	// builds the surface subtree into the context, the faces are only read: fillSides adds them to their
+	// tables. A task calls it holding m_sdk_read_mutex, and fillSides after releasing it
+	TasNode* buildMgmMeshedPrimitiveBoundedSurface(
+		tas_arm::Mgm_meshed_primitive_bounded_surface* mgmMeshedPrimitiveBoundedSurface, Transform* transform, BuildContext& ctx);
+	void buildSide(tas_arm::List_Mgm_face_1_n& faces, ActiveSide which, BoundedSurface* surface, TasNode* node, BuildContext& ctx);
+	void fillSides(BuildContext& ctx);
+	void materializeFaces(Side* side);
 
 	void processMgmAnyMeshedGeometricItem(
 		tas_arm::Mgm_any_meshed_geometric_item* mgmAnyMeshedGeometricItem, Geometry* geo);
@@ -90,39 +277,72 @@ private:
 	void processMgmCompoundMeshedGeometricItem(
 		tas_arm::Mgm_compound_meshed_geometric_item* mgmCompoundMeshedGeometricItem, TasNode* node);
 	void processMgmQuadrilateral(
-		tas_arm::Mgm_quadrilateral* mgmSphere, Quadrilateral* quad);
+		tas_arm::Mgm_quadrilateral* mgmSphere, Quadrilateral* quad, BuildContext& ctx);
 	void processMgmMeshedGeometricModel(
 		tas_arm::Mgm_meshed_geometric_model* mgmMeshedGeometricModel, TasNode* node);
 
 	void processMgmSphere(
-		tas_arm::Mgm_sphere* mgmSphere, Sphere* sphere);
+		tas_arm::Mgm_sphere* mgmSphere, Sphere* sphere, BuildContext& ctx);
 	void processMgmRectangle(
-		tas_arm::Mgm_rectangle* mgmRectangle, Rectangle* rect);
+		tas_arm::Mgm_rectangle* mgmRectangle, Rectangle* rect, BuildContext& ctx);
+	void processMgmCone(
+		tas_arm::Mgm_cone* mgmCone, Cone* cone, BuildContext& ctx);
+	void processMgmCylinder(
+		tas_arm::Mgm_cylinder* mgmCylinder, Cylinder* cylinder, BuildContext& ctx);
+	void processMgmDisc(
+		tas_arm::Mgm_disc* mgmDisc, Disc* disc, BuildContext& ctx);
+	void processMgmParaboloid(
+		tas_arm::Mgm_paraboloid* mgmParaboloid, Paraboloid* paraboloid, BuildContext& ctx);
+	void processMgmTriangle(
+		tas_arm::Mgm_triangle* mgmTriangle, Triangle* triangle, BuildContext& ctx);
+
+	// primitive surface handlers, indexed by EntityKind. Adding a primitive is one process function
+	// and one entry in makeSurfaceHandlers
+	typedef BoundedSurface* (FileInterface::*SurfaceHandler)(tas_arm::Mgm_primitive_bounded_surface*, BuildContext&);
+	typedef std::array<SurfaceHandler, (size_t)EntityKind::COUNT> SurfaceHandlerTable;
+	template <class Entity, class Node, void (FileInterface::*Process)(Entity*, Node*, BuildContext&)>
+	BoundedSurface* buildPrimitive(tas_arm::Mgm_primitive_bounded_surface* entity, BuildContext& ctx);
+	static constexpr SurfaceHandlerTable makeSurfaceHandlers();
+	static const SurfaceHandlerTable SurfaceHandlers;
 	void processMgmFace(
 		tas_arm::Mgm_face* mgmFace, Face* Face);
+	// transformations: each one is applied to the matrix of the steps before it
 	void processMgmRotation(
-		tas_arm::Mgm_rotation* mgmRotation, Geometry* geo);
-
-	
+		tas_arm::Mgm_rotation* mgmRotation, Transform& transform);
+	void processMgmTranslation(
+		tas_arm::Mgm_translation* mgmTranslation, Transform& transform);
 	void processMgmAxisTransformationSequence(
-		tas_arm::Mgm_axis_transformation_sequence* mgmAxisTransformationSequence, Geometry* geo);
+		tas_arm::Mgm_axis_transformation_sequence* mgmAxisTransformationSequence, Transform& transform);
 	void processMgmAxisTransformation(
-		tas_arm::Mgm_axis_transformation* mgmAxisTransformation, Geometry* geo);
+		tas_arm::Mgm_axis_transformation* mgmAxisTransformation, Transform& transform);
+	// model transformation of an item placed by local in the compound node parent, nullptr for none.
+	// Serial only: the parallel surfaces get theirs when they are dispatched
+	Transform* placeItem(TasNode* parent, tas_arm::Mgm_axis_transformation* local);
+	void placeCompound(tas_arm::Mgm_compound_meshed_geometric_item* compound, TasNode* parent, TasNode* cpnode);
+	Transform* placeSurface(tas_arm::Mgm_meshed_primitive_bounded_surface* surface, TasNode* parent);
+	std::unordered_map<Step::Id, Transform> m_local_transforms; // one matrix per transformation entity
+	std::map<std::pair<Transform*, Step::Id>, Transform*> m_model_transforms; // (parent, local) -> model, in the arena
+	std::unordered_map<long, Transform*> m_compound_transforms; // by compound node id
 	void processSurfaceMaterial(
 		tas_arm::Nrf_material* nrfMaterial, ThermalMaterialProperties* mat);
 	void processBulkMaterial(
 		tas_arm::Nrf_material* nrfMaterial, Material* mat);
-	
-	double processQuantityValue(
-		Step::RefPtr<tas_arm_support::MaterialPropertiesTable> materialPropertiesTable,
-		Step::String environmentName,
-		Step::String materialId,
-		Step::String quantityName);
+	void buildMaterialIndex();
 	
 
 	void processMeshedGeometricModel(
 		tas_arm::Mgm_meshed_geometric_model* mgmMeshedGeometricModel, TasNode* node);
 
 	void processNrfRootCollection(tas_arm::Nrf_root* nrfRoot);
+	void processNrfNetworkModel(tas_arm::Nrf_network_model* nrfNetworkModel);
+	int conductorNode(tas_arm::Nrf_network_node* networkNode);
 	
-};
\ No newline at end of file
+};
+
+template <class Entity>
+void BuildContext::countEntity(Entity* entity)
+{
+	if (!owner->m_options.collectStatistics) return;
+	if (entityCounts != nullptr) (*entityCounts)[entity->type()]++;
+	else owner->addEntityCount(entity->type());
+}
\ No newline at end of file
@@ -0,0 +1,201 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="fileloader.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <system_error>
+#include <filesystem>
+#include "fileloader.hxx"
+#include "fileinterface.hxx"
+#include "logger.hxx"
+#include "threadpool.hxx"
+
+using namespace sti;
+
+FileLoader::FileLoader(int threadCount, long long memoryBudget)
+	: m_pool(new WorkStealingPool(threadCount)), m_budget(memoryBudget)
+{
+	m_group.reset(new TaskGroup(*m_pool));
+}
+
+FileLoader::~FileLoader()
+{
+	cancel();
+	try
+	{
+		m_group->wait();
+	}
+	catch (const std::exception& e)
+	{
+		STI_LOG(LOG_ERROR, "file loader shutdown: " << e.what());
+	}
+	catch (...)
+	{
+		STI_LOG(LOG_ERROR, "file loader shutdown: unknown exception");
+	}
+	m_group.reset();
+	for (Entry& entry : m_entries)
+	{
+		delete entry.result;
+	}
+}
+
+int FileLoader::add(const std::string& filename)
+{
+	return add(filename, LoadOptions());
+}
+
+int FileLoader::add(const std::string& filename, const LoadOptions& options)
+{
+	std::error_code error;
+	auto size = std::filesystem::file_size(filename, error);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	int index = (int)m_entries.size();
+	m_entries.push_back({ filename, options, error ? 0 : (long long)size * FootprintPerSourceByte, LOAD_PENDING, nullptr });
+	m_pending.push_back(index);
+	startPending(lock);
+	return index;
+}
+
+int FileLoader::size()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return (int)m_entries.size();
+}
+
+std::string FileLoader::getFileName(int index)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (index < 0 || index >= (int)m_entries.size()) return std::string();
+	return m_entries[index].filename;
+}
+
+LoadStatus FileLoader::getStatus(int index)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (index < 0 || index >= (int)m_entries.size()) return LOAD_FAILED;
+	return m_entries[index].status;
+}
+
+int FileLoader::waitNext()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_finished_changed.wait(lock, [this] { return !m_finished.empty() || m_returned == (int)m_entries.size(); });
+	if (m_finished.empty()) return -1;
+	int index = m_finished.front();
+	m_finished.pop_front();
+	m_returned++;
+	return index;
+}
+
+FileData* FileLoader::takeResult(int index)
+{
+	FileInterface* finter = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (index < 0 || index >= (int)m_entries.size() || m_entries[index].status != LOAD_SUCCEEDED) return nullptr;
+		std::swap(finter, m_entries[index].result);
+	}
+	return finter == nullptr ? nullptr : new FileData(finter);
+}
+
+void FileLoader::cancel()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_cancellation.cancel();
+	for (int index : m_pending)
+	{
+		m_entries[index].status = LOAD_CANCELLED;
+		m_finished.push_back(index);
+	}
+	m_pending.clear();
+	m_finished_changed.notify_all();
+}
+
+// Starts the pending files in order while their footprint fits; nothing running means the next one
+// starts whatever its size. Called with the mutex held.
+//
+void FileLoader::startPending(std::unique_lock<std::mutex>& lock)
+{
+	while (!m_pending.empty())
+	{
+		int index = m_pending.front();
+		Entry& entry = m_entries[index];
+		if (m_budget > 0 && m_running > 0 && m_charged + entry.footprint > m_budget) return;
+
+		m_pending.pop_front();
+		m_charged += entry.footprint;
+		m_running++;
+		entry.status = LOAD_RUNNING;
+		m_group->run([this, index]() { load(index); });
+	}
+}
+
+void FileLoader::load(int index)
+{
+	std::string filename;
+	LoadOptions options;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		filename = m_entries[index].filename;
+		options = m_entries[index].options;
+	}
+
+	FileInterface* finter = new FileInterface(options);
+	finter->SetSharedPool(m_pool.get());
+	finter->SetProgress(nullptr, &m_cancellation);
+	bool loaded = false;
+	try
+	{
+		loaded = finter->processStepTasFile(filename);
+	}
+	catch (const std::exception& e)
+	{
+		STI_LOG(LOG_ERROR, "loading " << filename << " failed: " << e.what());
+		loaded = false;
+	}
+	catch (...)
+	{
+		STI_LOG(LOG_ERROR, "loading " << filename << " failed: unknown exception");
+		loaded = false;
+	}
+	// the pool does not outlive the loader, later lazy expansions build serially
+	finter->SetSharedPool(nullptr);
+	finter->SetProgress(nullptr, nullptr);
+
+	LoadStatus status = m_cancellation.isCancelled() ? LOAD_CANCELLED : (loaded ? LOAD_SUCCEEDED : LOAD_FAILED);
+	if (status != LOAD_SUCCEEDED)
+	{
+		// released before the next file is started
+		delete finter;
+		finter = nullptr;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Entry& entry = m_entries[index];
+	entry.status = status;
+	entry.result = finter;
+	m_charged -= entry.footprint;
+	m_running--;
+	m_finished.push_back(index);
+	m_finished_changed.notify_all();
+	startPending(lock);
+}
@@ -0,0 +1,104 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="fileloader.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Multi-file loader
+// Loads a batch of files concurrently on one bounded worker pool, which the parallel surface building of
+// each file shares. A memory budget limits how many loads run at once: every load is charged an estimate
+// of its peak footprint (a multiple of the source size) until it finishes, and a file is only started when
+// its estimate fits in what is left. A file larger than the whole budget runs alone.
+// The SDK calls of the loads (parsing, instantiation, registration) run one at a time, the processing
+// of the files runs concurrently.
+// The files are handed back in completion order.
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "interface.hxx"
+#include "loadjob.hxx"
+
+class FileInterface;
+class WorkStealingPool;
+class TaskGroup;
+
+namespace sti
+{
+	class FileLoader
+	{
+	public:
+		// threadCount <= 0 uses one worker per hardware thread, a memoryBudget of 0 (bytes) is unlimited
+		FileLoader(int threadCount, long long memoryBudget);
+		~FileLoader(); // cancels the loads not yet returned and waits for the running ones
+
+		// queues a file and returns its index in the batch, the load starts as soon as it fits in the budget
+		int add(const std::string& filename, const LoadOptions& options);
+		int add(const std::string& filename);
+		int size();
+		std::string getFileName(int index);
+		LoadStatus getStatus(int index);
+
+		// blocks until the next file is finished and returns its index, -1 once every file was returned
+		int waitNext();
+		// the loaded file once its status is LOAD_SUCCEEDED, null otherwise. Ownership goes to the caller
+		FileData* takeResult(int index);
+		// files not started yet are dropped, running ones stop at the next entity boundary
+		void cancel();
+
+		// estimated peak memory of a load per byte of Part 21 text (SDK dataset and node tree)
+		static const int FootprintPerSourceByte = 8;
+
+#ifndef SWIG
+	private:
+		FileLoader(const FileLoader&) = delete;
+		FileLoader& operator=(const FileLoader&) = delete;
+
+		struct Entry
+		{
+			std::string filename;
+			LoadOptions options;
+			long long footprint;
+			LoadStatus status;
+			FileInterface* result;
+		};
+		void startPending(std::unique_lock<std::mutex>& lock);
+		void load(int index);
+
+		std::unique_ptr<WorkStealingPool> m_pool;
+		std::unique_ptr<TaskGroup> m_group;
+		long long m_budget;
+		long long m_charged = 0;
+		int m_running = 0;
+		LoadCancellation m_cancellation;
+
+		std::mutex m_mutex;
+		std::condition_variable m_finished_changed;
+		std::deque<Entry> m_entries; // stable references while the batch grows
+		std::deque<int> m_pending;
+		std::deque<int> m_finished;
+		int m_returned = 0;
+#endif
+	};
+}
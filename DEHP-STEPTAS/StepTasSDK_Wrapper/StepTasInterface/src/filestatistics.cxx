@@ -0,0 +1,95 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="filestatistics.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <cctype>
+#include "filestatistics.hxx"
+
+using namespace sti;
+
+FileStatistics::FileStatistics() : m_size(0), m_entities(0)
+{
+}
+
+void FileStatistics::reset(long long fileSize)
+{
+	m_size = fileSize;
+	m_entities = 0;
+	m_names.clear();
+	m_counts.clear();
+	m_rows.clear();
+}
+
+void FileStatistics::add(std::string_view typeName, int count)
+{
+	m_entities += count;
+	std::string key(typeName);
+	for (char& c : key) c = (char)std::toupper((unsigned char)c);
+	auto found = m_rows.find(key);
+	if (found != m_rows.end())
+	{
+		m_counts[found->second] += count;
+		return;
+	}
+	m_rows.emplace(key, (int)m_names.size());
+	m_names.push_back(key);
+	m_counts.push_back(count);
+}
+
+void FileStatistics::addComplex(int count)
+{
+	m_entities += count;
+}
+
+long long FileStatistics::fileSize()
+{
+	return m_size;
+}
+
+int FileStatistics::entityCount()
+{
+	return m_entities;
+}
+
+int FileStatistics::typeCount()
+{
+	return (int)m_names.size();
+}
+
+std::string FileStatistics::getTypeName(int type)
+{
+	if (type < 0 || type >= (int)m_names.size()) return std::string();
+	return m_names[type];
+}
+
+int FileStatistics::getTypeCount(int type)
+{
+	if (type < 0 || type >= (int)m_counts.size()) return 0;
+	return m_counts[type];
+}
+
+int FileStatistics::countOf(const std::string& typeName)
+{
+	std::string key(typeName);
+	for (char& c : key) c = (char)std::toupper((unsigned char)c);
+	auto found = m_rows.find(key);
+	return found == m_rows.end() ? 0 : m_counts[found->second];
+}
@@ -0,0 +1,63 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="filestatistics.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// File statistics
+// Number of instances of each entity type of a Part 21 file, counted by a single pass over the raw text
+// before the SDK parses it. Used to size the containers of the load and to turn the processing into a
+// percentage.
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sti
+{
+	class FileStatistics
+	{
+	public:
+		long long fileSize();
+		// every instance of the DATA section, complex instances included
+		int entityCount();
+		// simple instance types, sorted by name
+		int typeCount();
+		std::string getTypeName(int type); // upper case, as written in the file
+		int getTypeCount(int type);
+		// 0 for a type that does not occur. The name is not case sensitive: "Mgm_face" finds MGM_FACE
+		int countOf(const std::string& typeName);
+
+#ifndef SWIG
+		FileStatistics();
+		void reset(long long fileSize);
+		void add(std::string_view typeName, int count);
+		void addComplex(int count); // complex instances are only counted in the total
+	private:
+		long long m_size;
+		int m_entities;
+		std::vector<std::string> m_names;
+		std::vector<int> m_counts;
+		std::unordered_map<std::string, int> m_rows;
+#endif
+	};
+}
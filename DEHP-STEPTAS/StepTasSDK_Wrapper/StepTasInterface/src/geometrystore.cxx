@@ -0,0 +1,445 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="geometrystore.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+#include <cstring>
+
+#include "geometrystore.hxx"
+#include "transform.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// columns used by each primitive type, the point columns are always the first ones
+	bool usesColumn(NodeType type, int column)
+	{
+		if (column == GEO_SIDE1_THICKNESS || column == GEO_SIDE2_THICKNESS)
+		{
+			return true;
+		}
+		int points = (type == QUADRILATERAL) ? 4 : 3;
+		if (column < GEO_P1X + 3 * points)
+		{
+			return true;
+		}
+		switch (type)
+		{
+		case SPHERE:
+			return column == GEO_RADIUS1 || column == GEO_BASE_TRUNCATION || column == GEO_APEX_TRUNCATION
+				|| column == GEO_START_ANGLE || column == GEO_END_ANGLE;
+		case CONE:
+		case DISC:
+			return column == GEO_RADIUS1 || column == GEO_RADIUS2 || column == GEO_START_ANGLE || column == GEO_END_ANGLE;
+		case CYLINDER:
+			return column == GEO_RADIUS1 || column == GEO_START_ANGLE || column == GEO_END_ANGLE;
+		case PARABOLOID:
+			return column == GEO_RADIUS1 || column == GEO_APEX_TRUNCATION || column == GEO_START_ANGLE || column == GEO_END_ANGLE;
+		default:
+			return false;
+		}
+	}
+}
+
+PrimitiveTable::PrimitiveTable(NodeType type) : m_type(type)
+{
+	for (int column = 0; column < GEO_COLUMN_COUNT; column++)
+	{
+		m_used[column] = usesColumn(type, column);
+	}
+}
+
+NodeType PrimitiveTable::getType()
+{
+	return m_type;
+}
+
+int PrimitiveTable::size()
+{
+	return (int)m_ids.size();
+}
+
+bool PrimitiveTable::hasColumn(GeometryColumn column)
+{
+	return column >= 0 && column < GEO_COLUMN_COUNT && m_used[column];
+}
+
+long PrimitiveTable::getSurfaceId(int row)
+{
+	return (row < 0 || row >= size()) ? 0 : m_ids[row];
+}
+
+int PrimitiveTable::findRow(long surfaceId)
+{
+	auto it = m_rows.find(surfaceId);
+	return (it == m_rows.end()) ? -1 : it->second;
+}
+
+double PrimitiveTable::getValue(GeometryColumn column, int row)
+{
+	if (!hasColumn(column) || row < 0 || row >= size()) return 0.0;
+	return m_columns[column][row];
+}
+
+long PrimitiveTable::getIndexValue(GeometryIndexColumn column, int row)
+{
+	if (column < 0 || column >= GEO_INDEX_COLUMN_COUNT || row < 0 || row >= size()) return 0;
+	return m_index[column][row];
+}
+
+double* PrimitiveTable::columnData(GeometryColumn column)
+{
+	if (!hasColumn(column) || m_ids.empty()) return nullptr;
+	return m_columns[column].data();
+}
+
+long* PrimitiveTable::indexColumnData(GeometryIndexColumn column)
+{
+	if (column < 0 || column >= GEO_INDEX_COLUMN_COUNT || m_ids.empty()) return nullptr;
+	return m_index[column].data();
+}
+
+long* PrimitiveTable::surfaceIdData()
+{
+	return m_ids.empty() ? nullptr : m_ids.data();
+}
+
+void PrimitiveTable::copyColumn(GeometryColumn column, double* values)
+{
+	const double* data = columnData(column);
+	if (data != nullptr && values != nullptr)
+	{
+		std::memcpy(values, data, m_ids.size() * sizeof(double));
+	}
+}
+
+void PrimitiveTable::copyIndexColumn(GeometryIndexColumn column, long* values)
+{
+	const long* data = indexColumnData(column);
+	if (data != nullptr && values != nullptr)
+	{
+		std::memcpy(values, data, m_ids.size() * sizeof(long));
+	}
+}
+
+void PrimitiveTable::copySurfaceIds(long* ids)
+{
+	if (!m_ids.empty() && ids != nullptr)
+	{
+		std::memcpy(ids, m_ids.data(), m_ids.size() * sizeof(long));
+	}
+}
+
+double* PrimitiveTable::worldColumnData(GeometryColumn column)
+{
+	if (!hasColumn(column) || column >= PointColumnCount || m_ids.empty()) return nullptr;
+	buildWorld();
+	return m_world[column].data();
+}
+
+double PrimitiveTable::getWorldValue(GeometryColumn column, int row)
+{
+	const double* data = worldColumnData(column);
+	return (data == nullptr || row < 0 || row >= size()) ? 0.0 : data[row];
+}
+
+void PrimitiveTable::copyWorldColumn(GeometryColumn column, double* values)
+{
+	const double* data = worldColumnData(column);
+	if (data != nullptr && values != nullptr)
+	{
+		std::memcpy(values, data, m_ids.size() * sizeof(double));
+	}
+}
+
+Transform* PrimitiveTable::getTransform(int row)
+{
+	return (row < 0 || row >= size()) ? nullptr : m_transforms[row];
+}
+
+void PrimitiveTable::setTransform(int row, Transform* transform)
+{
+	m_transforms[row] = transform;
+	m_world_built = false;
+}
+
+// Surfaces of the same compound are added one after the other and share their transformation,
+// so each point column triple is transformed in a few long runs of rows.
+//
+void PrimitiveTable::buildWorld()
+{
+	if (m_world_built) return;
+	size_t rows = m_ids.size();
+	for (int x = GEO_P1X; x < PointColumnCount; x += 3)
+	{
+		if (!m_used[x]) continue;
+		const double* local[3] = { m_columns[x].data(), m_columns[x + 1].data(), m_columns[x + 2].data() };
+		double* world[3];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			m_world[x + axis].resize(rows);
+			world[axis] = m_world[x + axis].data();
+		}
+
+		size_t begin = 0;
+		while (begin < rows)
+		{
+			Transform* transform = m_transforms[begin];
+			size_t end = begin + 1;
+			while (end < rows && m_transforms[end] == transform) end++;
+			if (transform == nullptr)
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					std::memcpy(world[axis] + begin, local[axis] + begin, (end - begin) * sizeof(double));
+				}
+			}
+			else
+			{
+				transformPoints(*transform, local[0] + begin, local[1] + begin, local[2] + begin,
+					world[0] + begin, world[1] + begin, world[2] + begin, end - begin);
+			}
+			begin = end;
+		}
+	}
+	m_world_built = true;
+}
+
+int PrimitiveTable::addRow(long surfaceId)
+{
+	int row = (int)m_ids.size();
+	m_ids.push_back(surfaceId);
+	m_transforms.push_back(nullptr);
+	m_world_built = false;
+	for (int column = 0; column < GEO_COLUMN_COUNT; column++)
+	{
+		if (m_used[column]) m_columns[column].push_back(0.0);
+	}
+	for (std::vector<long>& index : m_index)
+	{
+		index.push_back(0);
+	}
+	m_rows.emplace(surfaceId, row);
+	return row;
+}
+
+void PrimitiveTable::set(GeometryColumn column, int row, double value)
+{
+	if (!hasColumn(column)) return;
+	m_columns[column][row] = value;
+	if (column < PointColumnCount) m_world_built = false;
+}
+
+void PrimitiveTable::setPoint(int pointIndex, int row, const Point3D& point)
+{
+	GeometryColumn x = (GeometryColumn)(GEO_P1X + 3 * pointIndex);
+	set(x, row, point.x);
+	set((GeometryColumn)(x + 1), row, point.y);
+	set((GeometryColumn)(x + 2), row, point.z);
+}
+
+void PrimitiveTable::setIndex(GeometryIndexColumn column, int row, long value)
+{
+	m_index[column][row] = value;
+}
+
+void PrimitiveTable::append(const PrimitiveTable& other)
+{
+	for (size_t row = 0; row < other.m_ids.size(); row++)
+	{
+		long surfaceId = other.m_ids[row];
+		if (m_rows.count(surfaceId) != 0) continue;
+
+		int newRow = addRow(surfaceId);
+		for (int column = 0; column < GEO_COLUMN_COUNT; column++)
+		{
+			if (m_used[column]) m_columns[column][newRow] = other.m_columns[column][row];
+		}
+		for (int column = 0; column < GEO_INDEX_COLUMN_COUNT; column++)
+		{
+			m_index[column][newRow] = other.m_index[column][row];
+		}
+		m_transforms[newRow] = other.m_transforms[row];
+	}
+}
+
+GeometryStore::GeometryStore()
+{
+	m_tables.reserve(PrimitiveCount);
+	for (int type = FirstPrimitive; type < FirstPrimitive + PrimitiveCount; type++)
+	{
+		m_tables.emplace_back((NodeType)type);
+	}
+}
+
+PrimitiveTable* GeometryStore::getTable(NodeType type)
+{
+	int index = (int)type - FirstPrimitive;
+	if (index < 0 || index >= PrimitiveCount) return nullptr;
+	return &m_tables[index];
+}
+
+int GeometryStore::surfaceCount()
+{
+	return (int)m_surfaces.size();
+}
+
+NodeType GeometryStore::findSurfaceType(long surfaceId)
+{
+	auto it = m_surfaces.find(surfaceId);
+	return (it == m_surfaces.end()) ? TASNODE : it->second;
+}
+
+int GeometryStore::findSurfaceRow(long surfaceId)
+{
+	PrimitiveTable* table = getTable(findSurfaceType(surfaceId));
+	return (table == nullptr) ? -1 : table->findRow(surfaceId);
+}
+
+void GeometryStore::computeWorldPoints()
+{
+	for (PrimitiveTable& table : m_tables)
+	{
+		table.buildWorld();
+	}
+}
+
+void GeometryStore::append(const GeometryStore& other)
+{
+	for (int index = 0; index < PrimitiveCount; index++)
+	{
+		m_tables[index].append(other.m_tables[index]);
+	}
+	for (const auto& surface : other.m_surfaces)
+	{
+		m_surfaces.insert(surface);
+	}
+}
+
+void GeometryStore::addSurface(BoundedSurface* surface)
+{
+	NodeType type = surface->getNodeType();
+	PrimitiveTable* table = getTable(type);
+	if (table == nullptr || m_surfaces.count(surface->id) != 0) return;
+
+	int row = table->addRow(surface->id);
+	m_surfaces[surface->id] = type;
+
+	switch (type)
+	{
+	case RECTANGLE:
+	{
+		Rectangle* rect = static_cast<Rectangle*>(surface);
+		table->setPoint(0, row, rect->P1);
+		table->setPoint(1, row, rect->P2);
+		table->setPoint(2, row, rect->P3);
+		break;
+	}
+	case QUADRILATERAL:
+	{
+		Quadrilateral* quad = static_cast<Quadrilateral*>(surface);
+		table->setPoint(0, row, quad->P1);
+		table->setPoint(1, row, quad->P2);
+		table->setPoint(2, row, quad->P3);
+		table->setPoint(3, row, quad->P4);
+		break;
+	}
+	case TRIANGLE:
+	{
+		Triangle* triangle = static_cast<Triangle*>(surface);
+		table->setPoint(0, row, triangle->P1);
+		table->setPoint(1, row, triangle->P2);
+		table->setPoint(2, row, triangle->P3);
+		break;
+	}
+	case SPHERE:
+	{
+		Sphere* sphere = static_cast<Sphere*>(surface);
+		table->setPoint(0, row, sphere->P1);
+		table->setPoint(1, row, sphere->P2);
+		table->setPoint(2, row, sphere->P3);
+		table->set(GEO_RADIUS1, row, sphere->Radius);
+		table->set(GEO_BASE_TRUNCATION, row, sphere->BaseTruncation);
+		table->set(GEO_APEX_TRUNCATION, row, sphere->ApexTruncation);
+		table->set(GEO_START_ANGLE, row, sphere->StartAngle);
+		table->set(GEO_END_ANGLE, row, sphere->EndAngle);
+		break;
+	}
+	case CONE:
+	{
+		Cone* cone = static_cast<Cone*>(surface);
+		table->setPoint(0, row, cone->P1);
+		table->setPoint(1, row, cone->P2);
+		table->setPoint(2, row, cone->P3);
+		table->set(GEO_RADIUS1, row, cone->Radius1);
+		table->set(GEO_RADIUS2, row, cone->Radius2);
+		table->set(GEO_START_ANGLE, row, cone->StartAngle);
+		table->set(GEO_END_ANGLE, row, cone->EndAngle);
+		break;
+	}
+	case CYLINDER:
+	{
+		Cylinder* cylinder = static_cast<Cylinder*>(surface);
+		table->setPoint(0, row, cylinder->P1);
+		table->setPoint(1, row, cylinder->P2);
+		table->setPoint(2, row, cylinder->P3);
+		table->set(GEO_RADIUS1, row, cylinder->Radius);
+		table->set(GEO_START_ANGLE, row, cylinder->StartAngle);
+		table->set(GEO_END_ANGLE, row, cylinder->EndAngle);
+		break;
+	}
+	case DISC:
+	{
+		Disc* disc = static_cast<Disc*>(surface);
+		table->setPoint(0, row, disc->P1);
+		table->setPoint(1, row, disc->P2);
+		table->setPoint(2, row, disc->P3);
+		table->set(GEO_RADIUS1, row, disc->InnerRadius);
+		table->set(GEO_RADIUS2, row, disc->OuterRadius);
+		table->set(GEO_START_ANGLE, row, disc->StartAngle);
+		table->set(GEO_END_ANGLE, row, disc->EndAngle);
+		break;
+	}
+	case PARABOLOID:
+	{
+		Paraboloid* paraboloid = static_cast<Paraboloid*>(surface);
+		table->setPoint(0, row, paraboloid->P1);
+		table->setPoint(1, row, paraboloid->P2);
+		table->setPoint(2, row, paraboloid->P3);
+		table->set(GEO_RADIUS1, row, paraboloid->Radius);
+		table->set(GEO_APEX_TRUNCATION, row, paraboloid->ApexTruncation);
+		table->set(GEO_START_ANGLE, row, paraboloid->StartAngle);
+		table->set(GEO_END_ANGLE, row, paraboloid->EndAngle);
+		break;
+	}
+	default:
+		break;
+	}
+
+	table->setTransform(row, surface->transformation);
+	table->set(GEO_SIDE1_THICKNESS, row, surface->side1_thickness);
+	table->set(GEO_SIDE2_THICKNESS, row, surface->side2_thickness);
+	table->setIndex(GEO_DIR1_MESHING, row, surface->dir1_meshing);
+	table->setIndex(GEO_DIR2_MESHING, row, surface->dir2_meshing);
+	table->setIndex(GEO_SIDE1_MATERIAL, row, (long)surface->side1_material);
+	table->setIndex(GEO_SIDE2_MATERIAL, row, (long)surface->side2_material);
+}
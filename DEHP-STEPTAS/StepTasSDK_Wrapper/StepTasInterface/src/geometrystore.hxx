@@ -0,0 +1,174 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="geometrystore.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Geometry store
+// Contiguous structure-of-arrays copy of the bounded surface geometry, filled by FileInterface while parsing.
+// There is one table per primitive type, each used column is one contiguous double (or long) array indexed
+// by table row, and rows can be found back from the surface id.
+// The columns are exposed to C# either as raw pointers (zero copy) or copied into pinned arrays. The
+// pointers stay valid as long as the FileData lives: FileData::getGeometry reads the whole tree of a lazy
+// load first, so no row is added to a table once it is handed out.
+// The point columns hold local coordinates. Their model (world) coordinates are computed for a whole table
+// at once, by applying the transformation of each row with transformPoints.
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "interface.hxx"
+
+namespace sti
+{
+	enum GeometryColumn
+	{
+		GEO_P1X, GEO_P1Y, GEO_P1Z,
+		GEO_P2X, GEO_P2Y, GEO_P2Z,
+		GEO_P3X, GEO_P3Y, GEO_P3Z,
+		GEO_P4X, GEO_P4Y, GEO_P4Z,
+		GEO_RADIUS1, // Radius, InnerRadius for a disc
+		GEO_RADIUS2, // cone second radius, OuterRadius for a disc
+		GEO_START_ANGLE,
+		GEO_END_ANGLE,
+		GEO_BASE_TRUNCATION,
+		GEO_APEX_TRUNCATION,
+		GEO_SIDE1_THICKNESS,
+		GEO_SIDE2_THICKNESS,
+		GEO_COLUMN_COUNT
+	};
+
+	enum GeometryIndexColumn
+	{
+		GEO_DIR1_MESHING,
+		GEO_DIR2_MESHING,
+		GEO_SIDE1_MATERIAL,
+		GEO_SIDE2_MATERIAL,
+		GEO_INDEX_COLUMN_COUNT
+	};
+
+#ifndef SWIG
+	// node types of the bounded surfaces, a BOUNDEDSURFACE has no primitive table
+	inline bool isBoundedSurface(NodeType type)
+	{
+		return type == BOUNDEDSURFACE || (type >= RECTANGLE && type <= TRIANGLE);
+	}
+
+	// The primitive columns hold their angles in degrees, FileInterface converts the SDK units to them.
+	// Every angle that goes to a kernel or a transform is converted here.
+	const double DegreesToRadians = 3.14159265358979323846 / 180.0;
+
+	inline double degreesToRadians(double degrees)
+	{
+		return degrees * DegreesToRadians;
+	}
+
+	// span in radians of a primitive start/end angle pair given in degrees.
+	// An end before the start wraps around, an end equal to the start is an empty span; FileInterface
+	// gives an unset end angle 360, so an unset pair is a full turn
+	inline double angularSpan(double start, double end)
+	{
+		double degrees = end - start;
+		if (degrees < 0.0) degrees += 360.0;
+		return degreesToRadians(std::min(std::max(degrees, 0.0), 360.0));
+	}
+#endif
+
+	class PrimitiveTable
+	{
+	public:
+		NodeType getType();
+		int size();
+		// columns not used by the primitive type are left empty
+		bool hasColumn(GeometryColumn column);
+
+		long getSurfaceId(int row);
+		int findRow(long surfaceId); // -1 when the surface is not in the table
+		double getValue(GeometryColumn column, int row);
+		long getIndexValue(GeometryIndexColumn column, int row);
+
+		// zero copy access, nullptr for an unused column
+		double* columnData(GeometryColumn column);
+		long* indexColumnData(GeometryIndexColumn column);
+		long* surfaceIdData();
+
+		// copies into a buffer of size() entries
+		void copyColumn(GeometryColumn column, double* values);
+		void copyIndexColumn(GeometryIndexColumn column, long* values);
+		void copySurfaceIds(long* ids);
+
+		// model coordinates of the point columns, nullptr (0.0) for the other columns.
+		// The first call transforms the points of every row of the table
+		double* worldColumnData(GeometryColumn column);
+		double getWorldValue(GeometryColumn column, int row);
+		void copyWorldColumn(GeometryColumn column, double* values);
+		// local to model transformation of the surface, nullptr when it is not transformed
+		Transform* getTransform(int row);
+
+#ifndef SWIG
+		explicit PrimitiveTable(NodeType type);
+		int addRow(long surfaceId);
+		void setTransform(int row, Transform* transform);
+		void buildWorld();
+		void set(GeometryColumn column, int row, double value);
+		void setPoint(int pointIndex, int row, const Point3D& point); // pointIndex 0 for P1
+		void setIndex(GeometryIndexColumn column, int row, long value);
+		void append(const PrimitiveTable& other);
+	private:
+		NodeType m_type;
+		bool m_used[GEO_COLUMN_COUNT];
+		std::vector<long> m_ids;
+		std::vector<double> m_columns[GEO_COLUMN_COUNT];
+		std::vector<long> m_index[GEO_INDEX_COLUMN_COUNT];
+		std::unordered_map<long, int> m_rows;
+		std::vector<Transform*> m_transforms;
+		static const int PointColumnCount = GEO_P4Z + 1;
+		std::vector<double> m_world[PointColumnCount];
+		bool m_world_built = false;
+#endif
+	};
+
+	class GeometryStore
+	{
+	public:
+		// nullptr for a type that is not a bounded surface primitive
+		PrimitiveTable* getTable(NodeType type);
+		int surfaceCount();
+		// type of the table holding the surface, TASNODE when the surface is unknown
+		NodeType findSurfaceType(long surfaceId);
+		int findSurfaceRow(long surfaceId);
+		// model coordinates of every table in one pass, otherwise each table computes them on first use
+		void computeWorldPoints();
+
+#ifndef SWIG
+		GeometryStore();
+		void addSurface(BoundedSurface* surface);
+		// appends the rows of another store, surfaces already present are skipped
+		void append(const GeometryStore& other);
+		static const int FirstPrimitive = RECTANGLE;
+		static const int PrimitiveCount = TRIANGLE - RECTANGLE + 1;
+	private:
+		std::vector<PrimitiveTable> m_tables;
+		std::unordered_map<long, NodeType> m_surfaces;
+#endif
+	};
+}
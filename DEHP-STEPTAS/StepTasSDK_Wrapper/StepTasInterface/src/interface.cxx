@@ -2,68 +2,117 @@
 // Interface class
 #include "interface.hxx"
 #include "fileinterface.hxx"
+#include "treediff.hxx"
+#include "mappedfile.hxx"
+#include "part21.hxx"
 
 FileData::FileData(const std::string& filename)
 {
 	
 	finter = new FileInterface();
 	finter->processStepTasFile(filename);
-	header = finter->GetFileHeader();
+}
 
+FileData::FileData(const std::string& filename, const LoadOptions& options)
+{
+	finter = new FileInterface(options);
+	finter->processStepTasFile(filename);
 }
 
-TasNode FileData::getRoot()
+FileData::FileData(FileInterface* loaded)
 {
-	return finter->GetRootNode();
+	finter = loaded;
 }
 
-void TasNode::addChild(TasNode* child) {
-	
-	Children.push_back(child);
-	child->parent = this;
+FileData::~FileData()
+{
+	delete finter;
 }
 
-int TasNode::childrenCount()
+TasNode* FileData::getRoot()
 {
-	return Children.size();
+	return finter->GetRoot();
 }
 
-TasNode* TasNode::getChildNode(int idx)
+const FileHeader& FileData::getHeader()
 {
-	if (idx<0 || idx>Children.size()) {
-		
-		return nullptr;
-	}
-	return Children[idx];
+	return finter->GetFileHeader();
+}
+
+NodeTable* FileData::getNodeTable()
+{
+	return finter->GetNodeTable();
 }
 
-TasNode* TasNode::getParent()
+GeometryStore* FileData::getGeometry()
 {
-	return parent;
+	return finter->GetGeometry();
 }
 
+MaterialIndex* FileData::getMaterialIndex()
+{
+	return finter->GetMaterialIndex();
+}
 
-NodeType TasNode::getNodeType()
+TasNode* FileData::findById(long id)
 {
-	return TASNODE;
-};
+	return finter->FindById(id);
+}
 
-NodeType Face::getNodeType()
+TasNode* FileData::resolvePath(const std::string& path)
 {
-	return FACE;
-};
+	return finter->ResolvePath(path);
+}
 
-NodeType BoundedSurface::getNodeType()
+ThermalNodeIndex* FileData::getThermalNodeIndex()
 {
-	return BOUNDEDSURFACE;
-};
+	return finter->GetThermalNodeIndex();
+}
 
-NodeType Rectangle::getNodeType()
+SpatialIndex* FileData::getSpatialIndex()
 {
-	return RECTANGLE;
-};
+	return finter->GetSpatialIndex();
+}
+
+MassProperties* FileData::getMassProperties()
+{
+	return finter->GetMassProperties();
+}
 
-NodeType Quadrilateral::getNodeType()
+ConductorGraph* FileData::getConductorGraph()
 {
-	return QUADRILATERAL;
-};
\ No newline at end of file
+	return finter->GetConductorGraph();
+}
+
+Tessellation* FileData::tessellate(const TessellationOptions& options)
+{
+	return finter->Tessellate(options);
+}
+
+FileStatistics* FileData::getStatistics()
+{
+	return finter->GetStatistics();
+}
+
+LoadStatistics* FileData::getLoadStatistics()
+{
+	return finter->GetLoadStatistics();
+}
+
+TreeDiff FileData::diff(FileData& other)
+{
+	return TreeDiff::compute(finter->GetRoot(), finter->GetNodeHashes(), other.finter->GetRoot(), other.finter->GetNodeHashes());
+}
+
+// Only the pages holding the header section are read from the mapping, whatever the file size.
+//
+FileHeader FileData::readHeaderOnly(const std::string& filename)
+{
+	FileHeader header;
+	MappedFile file;
+	if (file.open(filename))
+	{
+		readPart21Header(file.data(), file.size(), header);
+	}
+	return header;
+}
@@ -31,25 +31,62 @@
 
 #include <string>
 #include <vector>
+#include "facetable.hxx"
 class FileInterface;
+namespace sti
+{
+	class GeometryStore;
+	class MaterialIndex;
+	class ThermalNodeIndex;
+	class TreeDiff;
+	class FileStatistics;
+	class LoadStatistics;
+	class Transform;
+	class SpatialIndex;
+	class MassProperties;
+	class Tessellation;
+	class TessellationOptions;
+	class ConductorGraph;
+}
 using namespace std;
 
 namespace sti
 {
+#ifndef SWIG
+	class TasNode;
+
+	// Reads the children of a node left pending by a lazy load, implemented by FileInterface.
+	// The nodes only see this interface, so they do not depend on the SDK
+	class NodeExpander
+	{
+	public:
+		virtual void expandNode(TasNode* node) = 0;
+	protected:
+		~NodeExpander() {}
+	};
+#endif
 
 	enum NodeType {
 		TASNODE,
 		BOUNDEDSURFACE,
 		FACE,
 		RECTANGLE,
-		QUADRILATERAL
+		QUADRILATERAL,
+		SPHERE,
+		CONE,
+		CYLINDER,
+		DISC,
+		PARABOLOID,
+		TRIANGLE
 
 	};
 	enum DataStatus
 	{
 		Unchanged,
 		Modified,
-		Deleted
+		Deleted,
+		Added,
+		Moved
 	};
 
 	enum ActiveSide
@@ -93,22 +130,47 @@ namespace sti
 		long entity;
 		long id;// the structural id - most of the time it will be the same as the stepid, can be changed for exemple in a diff, where both tree are merged
 
-		std::string name;
-		std::string classType; //type of the corresponding step - tas
+#ifndef SWIG
+		// interned in the StringPool of the file, see stringpool.hxx
+		PooledString name;
+		PooledString classType; //type of the corresponding step - tas
+#endif
 		
 		int source;
 		TasNode* parent;
-		std::string label;
-		std::string description;
+#ifndef SWIG
+		PooledString label;
+		PooledString description;
+#endif
+		// read only name, classType, label and description properties in C#
+		const std::string& getName() const;
+		const std::string& getClassType() const;
+		const std::string& getLabel() const;
+		const std::string& getDescription() const;
+
+#ifndef SWIG
+		TasNode() = default;
+		// nodes live in the arena of their file and are handed out by pointer, never copied
+		TasNode(const TasNode&) = delete;
+		TasNode& operator=(const TasNode&) = delete;
+#endif
+		virtual ~TasNode() {}
 
 		void addChild(TasNode* child);
         int childrenCount();
 		TasNode* getParent();
         TasNode* getChildNode(int idx);
 		virtual NodeType getNodeType();
+		// faces of a side node, without creating their Face nodes. nullptr for the other nodes
+		virtual FaceTable* getFaceTable();
 
 #ifndef SWIG	
         std::vector<TasNode*> Children;
+		// set while the children are still in the file (lazy loading) or in the face table of a side,
+		// cleared once they are read
+		NodeExpander* pendingExpansion = nullptr;
+		// children for the internal walkers, reads them from the file first when needed
+		std::vector<TasNode*>& children();
 #endif
 		
 	};
@@ -119,53 +181,38 @@ namespace sti
 		
 	};
 
-	// Structural node
+	// Structural node, side 1 or 2 of a meshed bounded surface
 	class Side : public TasNode
 	{
 	public:
 		ActiveSide side;
-	};
-
-	class AxisTransformation
-	{
-	};
-
-	class AxisPlacement : public AxisTransformation
-	{
-	public:
-		Point3D location;
-	};
-	class AxisTranslation : public AxisTransformation
-	{
-	public:
-		Direction direction; //we set it in mm
-	};
-
-	class AxisRotation : public AxisTransformation
-	{
-	public:
-		double angle; //rotation in rads.
-		Direction axis;// If the axis is set to 0,0,0 we have a "rotation with a axes fixed"
-	};
-
-	class AxisTransformationSequence : public AxisTransformation
-	{
-	public:
-		std::vector<AxisTransformation> transformationsequence;
+		FaceTable* getFaceTable();
+#ifndef SWIG
+		FaceTable faces;
+		// status of the faces, created or not: a diff marks a whole added, deleted or moved side without
+		// creating its faces, the faces of a modified side keep their own
+		DataStatus faceStatus() const { return status == Modified ? Unchanged : status; }
+#endif
 	};
 
 	class Geometry : public DataNode
 	{
 	public:
-		AxisTransformation transformation;
+		// local to model coordinates, composed with the transformations of the enclosing compounds.
+		// nullptr when the geometry is not transformed, see transform.hxx
+		Transform* transformation;
 	};
 
 	class Face :public TasNode
 	{ 
 	public:
 		// The children of the Face are made out of      nrf_network_nodes
-		std::string nrf_network_node;
-		std::string nrf_model;
+#ifndef SWIG
+		PooledString nrf_network_node;
+		PooledString nrf_model;
+#endif
+		const std::string& getNetworkNode() const;
+		const std::string& getModel() const;
 	virtual NodeType getNodeType();
 	};
 
@@ -211,9 +258,13 @@ namespace sti
 	public:
 		ActiveSide activeside;
 		StepId side1_material;
-		string side1_material_name;
 		StepId side2_material;
-		string side2_material_name;
+#ifndef SWIG
+		PooledString side1_material_name;
+		PooledString side2_material_name;
+#endif
+		const std::string& getSide1MaterialName() const;
+		const std::string& getSide2MaterialName() const;
 		double side1_thickness;
 		double side2_thickness;
 		int dir1_meshing;
@@ -232,7 +283,7 @@ namespace sti
 		double Radius2;
 		double StartAngle;
 		double EndAngle;
-		
+		NodeType getNodeType();
 	};
 
 	class Triangle : public BoundedSurface
@@ -241,7 +292,7 @@ namespace sti
 		Point3D P1;
 		Point3D P2;
 		Point3D P3;
-
+		NodeType getNodeType();
 	};
 
 	class Rectangle : public BoundedSurface
@@ -273,6 +324,7 @@ namespace sti
 		double OuterRadius;
 		double StartAngle;
 		double EndAngle;
+		NodeType getNodeType();
 	};
 
 	class Cylinder : public BoundedSurface
@@ -284,6 +336,7 @@ namespace sti
 		double Radius;
 		double  StartAngle;
 		double  EndAngle;
+		NodeType getNodeType();
 	};
 
 	class Sphere : public BoundedSurface
@@ -297,6 +350,7 @@ namespace sti
 		double ApexTruncation;
 		double StartAngle;
 		double EndAngle;
+		NodeType getNodeType();
 	};
 
 	class Paraboloid : public BoundedSurface
@@ -309,6 +363,7 @@ namespace sti
 		double ApexTruncation;
 		double  StartAngle;
 		double  EndAngle;
+		NodeType getNodeType();
 	};
 
 	class FileHeader
@@ -326,16 +381,120 @@ namespace sti
 	};
 		
 
-	class FileData
+	// String fields of a node, as ordered in the NodeTable string offsets
+	enum NodeTableField
+	{
+		FIELD_NAME,
+		FIELD_LABEL,
+		FIELD_CLASSTYPE,
+		FIELD_DESCRIPTION,
+		FIELD_COUNT
+	};
+
+	// Flat pre-order table of the whole node tree, built in one native call.
+	// Each column is exported in bulk into a pinned C# array (one P/Invoke per column, not per node).
+	// The strings of all nodes are UTF-8 encoded one after the other in a single blob: field f of row r
+	// spans [offset(r * FIELD_COUNT + f), offset(r * FIELD_COUNT + f + 1)).
+	class NodeTable
+	{
+	public:
+		int size();
+		int blobSize();
+
+		// every buffer must hold size() entries
+		void copyIds(long* ids);
+		void copyParents(int* parents); // parent row, -1 for the root
+		void copyNodeTypes(int* types);
+		void copyStatus(int* status);
+		// size() * FIELD_COUNT + 1 entries
+		void copyStringOffsets(int* offsets);
+		// blobSize() bytes
+		void copyBlob(unsigned char* blob);
+
+		TasNode* getNode(int row);
+
+#ifndef SWIG
+		void build(TasNode* root);
+		// reads the status column again from the nodes, a diff changes it after the table is built
+		void refreshStatus();
+	private:
+		void addFaceRows(Side* side, FaceTable& faces, int parent);
+		std::vector<TasNode*> m_nodes;  // the side for a face row
+		std::vector<int> m_face_rows;   // row in the face table of the side, -1 for a node row
+		std::vector<long> m_ids;
+		std::vector<int> m_parents;
+		std::vector<int> m_types;
+		std::vector<int> m_status;
+		std::vector<int> m_offsets;
+		std::string m_blob;
+#endif
+	};
+
+	// How a file is turned into the node tree
+	class LoadOptions
 	{
 	public:
-		FileHeader header;
-		Geometry rootGeomtry;
+		LoadOptions() : threadCount(1), lazy(false), collectStatistics(false) {};
+		// threads used to build the bounded surface subtrees, 1 for the serial path, 0 for one per hardware thread
+		int threadCount;
+		// only build the model and the first compound level when opening,
+		// the other levels are read the first time their parent's children are asked for
+		bool lazy;
+		// directory of the processed model snapshots, empty to disable the cache.
+		// An unchanged file is then reopened from its snapshot without going through the STEP SDK
+		std::string cacheDirectory;
+		// time the load phases and count the processed entities, see FileData::getLoadStatistics
+		bool collectStatistics;
+	};
 
+	class FileData
+	{
+	public:
 		FileData(const std::string & filename);
+		FileData(const std::string & filename, const LoadOptions& options);
+		~FileData(); // releases the whole node tree, proxies obtained from this FileData become invalid
 		//bool getStatus();
-		TasNode getRoot();
+		// both owned by the FileData, no copy is made
+		TasNode* getRoot();
+		const FileHeader& getHeader();
+		// built on first call, owned by the FileData. Later calls refresh the status column, ask for it again after a diff
+		NodeTable* getNodeTable();
+		// filled while parsing, owned by the FileData. A lazy load reads its whole tree first, the tables are then complete
+		GeometryStore* getGeometry();
+		// material property values for every environment, owned by the FileData
+		MaterialIndex* getMaterialIndex();
+		// constant time lookups, nullptr when not found. The first node in pre-order wins on duplicates
+		TasNode* findById(long id);
+		// '/' separated node names from the root, unnamed nodes are skipped as in the adapter paths
+		TasNode* resolvePath(const std::string& path);
+		// faces <-> thermal network nodes, owned by the FileData
+		ThermalNodeIndex* getThermalNodeIndex();
+		// surfaces by position in model coordinates, built on first call and owned by the FileData
+		SpatialIndex* getSpatialIndex();
+		// area and mass of the surfaces and of every node above them, built on first call and owned by the FileData
+		MassProperties* getMassProperties();
+		// triangles of every surface in model coordinates, owned by the caller. Runs on LoadOptions.threadCount threads
+		Tessellation* tessellate(const TessellationOptions& options);
+		// couplings between the nodes of the thermal network models, owned by the FileData
+		ConductorGraph* getConductorGraph();
+		// instance counts per entity type of the source file, owned by the FileData
+		FileStatistics* getStatistics();
+		// phase times and processed entity counts of the load, owned by the FileData.
+		// Only filled when LoadOptions.collectStatistics was set
+		LoadStatistics* getLoadStatistics();
+		// edit script turning this file into the other one, sets the DataStatus of the nodes of both files
+		TreeDiff diff(FileData& other);
+		// header section only, the model is not loaded. Fields are empty when the file cannot be read
+		static FileHeader readHeaderOnly(const std::string& filename);
 	private:
+		FileData(const FileData&) = delete;
+		FileData& operator=(const FileData&) = delete;
+#ifndef SWIG
+		// takes over a file loaded by a LoadJob
+		explicit FileData(FileInterface* loaded);
+		friend class LoadJob;
+		friend class FileLoader;
+#endif
 		FileInterface* finter;
 	};
 }
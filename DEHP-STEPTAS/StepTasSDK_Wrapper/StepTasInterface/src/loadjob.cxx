@@ -0,0 +1,122 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="loadjob.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <exception>
+
+#include "loadjob.hxx"
+#include "fileinterface.hxx"
+#include "logger.hxx"
+
+using namespace sti;
+
+LoadJob::LoadJob(const std::string& filename, const LoadOptions& options, ProgressCallback* callback)
+	: m_filename(filename), m_options(options), m_callback(callback), m_status(LOAD_PENDING)
+{
+}
+
+LoadJob::~LoadJob()
+{
+	cancel();
+	if (m_thread.joinable()) m_thread.join();
+	delete m_interface;
+}
+
+void LoadJob::start()
+{
+	if (m_status != LOAD_PENDING) return;
+	m_status = LOAD_RUNNING;
+	m_thread = std::thread(&LoadJob::run, this);
+}
+
+void LoadJob::cancel()
+{
+	m_token.cancel();
+}
+
+LoadCancellation* LoadJob::getCancellation()
+{
+	return &m_token;
+}
+
+LoadStatus LoadJob::wait()
+{
+	if (m_thread.joinable()) m_thread.join();
+	return getStatus();
+}
+
+LoadStatus LoadJob::getStatus()
+{
+	return (LoadStatus)m_status.load();
+}
+
+bool LoadJob::isFinished()
+{
+	int status = m_status.load();
+	return status != LOAD_PENDING && status != LOAD_RUNNING;
+}
+
+FileData* LoadJob::takeResult()
+{
+	if (m_status != LOAD_SUCCEEDED || m_interface == nullptr) return nullptr;
+	FileData* data = new FileData(m_interface);
+	m_interface = nullptr;
+	return data;
+}
+
+void LoadJob::run()
+{
+	FileInterface* finter = new FileInterface(m_options);
+	finter->SetProgress(m_callback, &m_token);
+	bool loaded = false;
+	// nothing may escape the job thread: SDK parse errors, allocation failures, errors rethrown by the
+	// parallel surface build or by the C# callback would otherwise terminate the process
+	try
+	{
+		loaded = finter->processStepTasFile(m_filename);
+	}
+	catch (const std::exception& e)
+	{
+		STI_LOG(LOG_ERROR, "loading " << m_filename << " failed: " << e.what());
+	}
+	catch (...)
+	{
+		STI_LOG(LOG_ERROR, "loading " << m_filename << " failed: unknown exception");
+	}
+	// the callback belongs to the caller, it is not kept for the lazy expansions done later
+	finter->SetProgress(nullptr, nullptr);
+
+	if (m_token.isCancelled())
+	{
+		// releases the partial tree and the SDK dataset right away, not when the job is destroyed
+		delete finter;
+		m_status = LOAD_CANCELLED;
+		return;
+	}
+	if (!loaded)
+	{
+		delete finter;
+		m_status = LOAD_FAILED;
+		return;
+	}
+	m_interface = finter;
+	m_status = LOAD_SUCCEEDED;
+}
@@ -0,0 +1,113 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="loadjob.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Asynchronous loading
+// A LoadJob reads, instantiates and processes a file on its own thread. Progress is reported per phase
+// through a ProgressCallback, derived in C# (SWIG director). Cancelling takes effect at the next phase or
+// entity boundary: the SDK parse and instantiation run to the end of their phase, the tree processing stops
+// at the next compound item, network node or meshed surface. Everything built so far is then released.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "interface.hxx"
+
+class FileInterface;
+
+namespace sti
+{
+	enum LoadPhase
+	{
+		PHASE_SCAN,        // entity pre-scan of the raw text
+		PHASE_PARSE,       // SDK Part 21 parse
+		PHASE_INSTANTIATE, // SDK entity instantiation
+		PHASE_PROCESS,     // node tree, per meshed surface
+		PHASE_DONE
+	};
+
+	enum LoadStatus
+	{
+		LOAD_PENDING,
+		LOAD_RUNNING,
+		LOAD_SUCCEEDED,
+		LOAD_FAILED,
+		LOAD_CANCELLED
+	};
+
+	// Called from the loading thread (and from the build tasks in parallel mode, one call at a time).
+	class ProgressCallback
+	{
+	public:
+		virtual ~ProgressCallback() {}
+		// percent of the phase; processed and total are entity counts when the phase has them, 0 otherwise
+		virtual void onProgress(LoadPhase /*phase*/, int /*percent*/, int /*processed*/, int /*total*/) {}
+	};
+
+	// set by the caller, polled by the loading thread
+	class LoadCancellation
+	{
+	public:
+		LoadCancellation() : m_cancelled(false) {}
+		void cancel() { m_cancelled = true; }
+		bool isCancelled() const { return m_cancelled; }
+#ifndef SWIG
+	private:
+		LoadCancellation(const LoadCancellation&) = delete;
+		LoadCancellation& operator=(const LoadCancellation&) = delete;
+		std::atomic<bool> m_cancelled;
+#endif
+	};
+
+	class LoadJob
+	{
+	public:
+		// the callback may be null, otherwise it must stay alive until the job is finished
+		LoadJob(const std::string& filename, const LoadOptions& options, ProgressCallback* callback);
+		~LoadJob(); // cancels a running load and waits for it
+		void start();
+		void cancel();
+		LoadCancellation* getCancellation();
+		// blocks until the load is over
+		LoadStatus wait();
+		LoadStatus getStatus();
+		bool isFinished();
+		// the loaded file once the status is LOAD_SUCCEEDED, null otherwise. Ownership goes to the caller
+		FileData* takeResult();
+
+#ifndef SWIG
+	private:
+		LoadJob(const LoadJob&) = delete;
+		LoadJob& operator=(const LoadJob&) = delete;
+		void run();
+
+		std::string m_filename;
+		LoadOptions m_options;
+		ProgressCallback* m_callback;
+		LoadCancellation m_token;
+		std::thread m_thread;
+		std::atomic<int> m_status;
+		FileInterface* m_interface = nullptr;
+#endif
+	};
+}
@@ -0,0 +1,50 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="loadstatistics.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "loadstatistics.hxx"
+
+using namespace sti;
+
+LoadStatistics::LoadStatistics()
+	: enabled(false), fromSnapshot(false),
+	scanTime(0.0), snapshotTime(0.0), parseTime(0.0), instantiateTime(0.0), headerTime(0.0),
+	materialTime(0.0), treeTime(0.0), indexTime(0.0), totalTime(0.0),
+	duplicatesSkipped(0), nodesAllocated(0), arenaBytes(0), internedStrings(0)
+{
+}
+
+int LoadStatistics::entityTypeCount()
+{
+	return (int)entities.size();
+}
+
+std::string LoadStatistics::getEntityTypeName(int type)
+{
+	if (type < 0 || type >= (int)entities.size()) return std::string();
+	return entities[type].first;
+}
+
+long LoadStatistics::getEntityCount(int type)
+{
+	if (type < 0 || type >= (int)entities.size()) return 0;
+	return entities[type].second;
+}
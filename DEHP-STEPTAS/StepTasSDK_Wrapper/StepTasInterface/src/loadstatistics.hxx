@@ -0,0 +1,95 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="loadstatistics.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Load instrumentation
+// Wall time of each load phase and counts of what the processing went through, collected when
+// LoadOptions.collectStatistics is set. When it is not, the phases only test a flag.
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sti
+{
+	class LoadStatistics
+	{
+	public:
+		LoadStatistics();
+
+		bool enabled;      // LoadOptions.collectStatistics was set
+		bool fromSnapshot; // the tree came from the snapshot cache, the SDK phases did not run
+
+		// wall times in milliseconds
+		double scanTime;        // entity pre-scan
+		double snapshotTime;    // snapshot read, or write after the load
+		double parseTime;       // SDK loadP21File
+		double instantiateTime; // SDK instantiateAll
+		double headerTime;      // file header extraction
+		double materialTime;    // material properties index
+		double treeTime;        // node tree, model materials included
+		double indexTime;       // node id and path index
+		double totalTime;
+
+		long duplicatesSkipped; // entities already in the tree, skipped through the duplicate set
+		long nodesAllocated;    // objects in the node arena
+		long long arenaBytes;
+		long internedStrings;   // distinct node strings of the file
+
+		// processed entities per SDK entity type, sorted by name
+		int entityTypeCount();
+		std::string getEntityTypeName(int type);
+		long getEntityCount(int type);
+
+#ifndef SWIG
+		std::vector<std::pair<std::string, long>> entities;
+#endif
+	};
+}
+
+#ifndef SWIG
+// Adds the lifetime of the scope to a LoadStatistics time, does nothing when disabled.
+class PhaseTimer
+{
+public:
+	PhaseTimer(bool enabled, double& milliseconds) : m_target(enabled ? &milliseconds : nullptr)
+	{
+		if (m_target != nullptr) m_start = std::chrono::steady_clock::now();
+	}
+	~PhaseTimer()
+	{
+		if (m_target != nullptr)
+		{
+			*m_target += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+		}
+	}
+
+	PhaseTimer(const PhaseTimer&) = delete;
+	PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+	double* m_target;
+	std::chrono::steady_clock::time_point m_start;
+};
+#endif
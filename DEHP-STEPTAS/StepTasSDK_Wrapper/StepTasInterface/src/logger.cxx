@@ -0,0 +1,243 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="logger.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "logger.hxx"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace sti;
+
+std::atomic<int> NativeLog::s_level{ LOG_INFO };
+
+namespace
+{
+	class ConsoleSink : public LogSink
+	{
+	public:
+		void write(LogLevel level, const std::string& message) override
+		{
+			static const char* const names[] = { "trace", "debug", "info", "warning", "error" };
+			const char* name = (level >= LOG_TRACE && level < LOG_OFF) ? names[level] : "";
+			std::fprintf(stderr, "[%s] %s\n", name, message.c_str());
+		}
+	};
+
+	// Bounded multi producer, single consumer ring. Each slot carries a sequence number telling whether
+	// it is free for the producer of that turn or filled for the consumer, so producers only contend on
+	// the enqueue position.
+	class LogQueue
+	{
+	public:
+		static const size_t Capacity = 4096; // power of two
+
+		LogQueue() : m_slots(new Slot[Capacity])
+		{
+			for (size_t i = 0; i < Capacity; i++)
+			{
+				m_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+			m_writer = std::thread([this] { writerLoop(); });
+			m_writer_id = m_writer.get_id();
+			// the queue lives as long as the process, see instance()
+			m_writer.detach();
+		}
+
+		// The queue is never destroyed: joining a thread from a static destructor can deadlock at
+		// library unload. Pending messages are lost at exit unless NativeLog::flush was called.
+		static LogQueue& instance()
+		{
+			static LogQueue* queue = new LogQueue();
+			return *queue;
+		}
+
+		void push(LogLevel level, std::string message)
+		{
+			size_t position = m_enqueue.load(std::memory_order_relaxed);
+			Slot* slot;
+			for (;;)
+			{
+				slot = &m_slots[position & (Capacity - 1)];
+				size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+				if (difference == 0)
+				{
+					if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+				}
+				else if (difference < 0)
+				{
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				else
+				{
+					position = m_enqueue.load(std::memory_order_relaxed);
+				}
+			}
+			slot->level = level;
+			slot->message = std::move(message);
+			slot->sequence.store(position + 1, std::memory_order_release);
+
+			if (m_sleeping.load(std::memory_order_acquire)) wake();
+		}
+
+		// waits for the batch being written to the previous sink, unless the sink itself is calling
+		void setSink(LogSink* sink)
+		{
+			std::unique_lock<std::mutex> lock(m_sink_mutex);
+			m_sink = sink;
+			if (std::this_thread::get_id() == m_writer_id) return;
+			m_sink_idle.wait(lock, [&] { return !m_writing; });
+		}
+
+		void flush()
+		{
+			// a sink would wait for itself
+			if (std::this_thread::get_id() == m_writer_id) return;
+			size_t target = m_enqueue.load(std::memory_order_acquire);
+			wake();
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_flushed.wait(lock, [&] { return m_written.load(std::memory_order_acquire) >= target; });
+		}
+
+		long dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+	private:
+		struct Slot
+		{
+			std::atomic<size_t> sequence;
+			LogLevel level;
+			std::string message;
+		};
+
+		// Only the writer thread dequeues.
+		bool pop(LogLevel& level, std::string& message)
+		{
+			Slot& slot = m_slots[m_dequeue & (Capacity - 1)];
+			if (slot.sequence.load(std::memory_order_acquire) != m_dequeue + 1) return false;
+			level = slot.level;
+			message = std::move(slot.message);
+			slot.message.clear();
+			slot.sequence.store(m_dequeue + Capacity, std::memory_order_release);
+			m_dequeue++;
+			return true;
+		}
+
+		void wake()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_wakeUp.notify_one();
+		}
+
+		void writerLoop()
+		{
+			LogLevel level;
+			std::string message;
+			long reported = 0;
+			for (;;)
+			{
+				// the sink is called without the lock, it may log or replace itself
+				LogSink* sink;
+				{
+					std::lock_guard<std::mutex> lock(m_sink_mutex);
+					sink = m_sink != nullptr ? m_sink : &m_console;
+					m_writing = true;
+				}
+				while (pop(level, message))
+				{
+					sink->write(level, message);
+				}
+				long dropped = m_dropped.load(std::memory_order_relaxed);
+				if (dropped != reported)
+				{
+					sink->write(LOG_WARNING, std::to_string(dropped - reported) + " log messages dropped, the queue was full");
+					reported = dropped;
+				}
+				{
+					std::lock_guard<std::mutex> lock(m_sink_mutex);
+					m_writing = false;
+				}
+				m_sink_idle.notify_all();
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_written.store(m_dequeue, std::memory_order_release);
+					m_flushed.notify_all();
+					m_sleeping.store(true, std::memory_order_release);
+					// the timeout covers a push racing with the sleeping flag
+					m_wakeUp.wait_for(lock, std::chrono::milliseconds(50));
+					m_sleeping.store(false, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		std::unique_ptr<Slot[]> m_slots;
+		std::atomic<size_t> m_enqueue{ 0 };
+		size_t m_dequeue = 0; // writer thread only
+		std::atomic<size_t> m_written{ 0 };
+		std::atomic<long> m_dropped{ 0 };
+		std::atomic<bool> m_sleeping{ false };
+		std::mutex m_mutex;
+		std::condition_variable m_wakeUp;
+		std::condition_variable m_flushed;
+		std::mutex m_sink_mutex;
+		std::condition_variable m_sink_idle;
+		LogSink* m_sink = nullptr;
+		bool m_writing = false; // a batch is being written, setSink waits for it so a replaced sink is never called again
+		std::thread::id m_writer_id;
+		ConsoleSink m_console;
+		std::thread m_writer;
+	};
+}
+
+void NativeLog::setSink(LogSink* sink)
+{
+	LogQueue::instance().setSink(sink);
+}
+
+void NativeLog::setLevel(LogLevel level)
+{
+	s_level.store(level, std::memory_order_relaxed);
+}
+
+LogLevel NativeLog::getLevel()
+{
+	return (LogLevel)s_level.load(std::memory_order_relaxed);
+}
+
+void NativeLog::flush()
+{
+	LogQueue::instance().flush();
+}
+
+long NativeLog::droppedCount()
+{
+	return LogQueue::instance().dropped();
+}
+
+void NativeLog::post(LogLevel level, std::string message)
+{
+	LogQueue::instance().push(level, std::move(message));
+}
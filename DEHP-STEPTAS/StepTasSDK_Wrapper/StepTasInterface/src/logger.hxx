@@ -0,0 +1,95 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="logger.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Native diagnostics
+// Messages are filtered twice: STI_LOG_LEVEL removes the levels below it at compile time, NativeLog::setLevel
+// at run time. A message that passes is formatted by the caller and pushed on a bounded lock free queue; a
+// background thread hands the queued messages to the sink, so the processing never waits on a console or a
+// file. The default sink writes to stderr, the adapter installs one forwarding to NLog (SWIG director).
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+namespace sti
+{
+	enum LogLevel
+	{
+		LOG_TRACE,
+		LOG_DEBUG,
+		LOG_INFO,
+		LOG_WARNING,
+		LOG_ERROR,
+		LOG_OFF
+	};
+
+	// Called from the log writer thread only, one message at a time.
+	class LogSink
+	{
+	public:
+		virtual ~LogSink() {}
+		virtual void write(LogLevel /*level*/, const std::string& /*message*/) {}
+	};
+
+	class NativeLog
+	{
+	public:
+		// null restores the stderr sink. The previous sink is no longer called once this returns,
+		// except when called from a sink, which does not wait for its own write to end
+		static void setSink(LogSink* sink);
+		// messages below the level are dropped before being formatted, LOG_INFO by default
+		static void setLevel(LogLevel level);
+		static LogLevel getLevel();
+		// blocks until every message posted before the call has been written, returns at once in a sink
+		static void flush();
+		// messages lost because the queue was full
+		static long droppedCount();
+#ifndef SWIG
+		static bool isEnabled(LogLevel level) { return level >= s_level.load(std::memory_order_relaxed); }
+		static void post(LogLevel level, std::string message);
+	private:
+		static std::atomic<int> s_level;
+#endif
+	private:
+		NativeLog();
+	};
+}
+
+#ifndef SWIG
+#ifndef STI_LOG_LEVEL
+#define STI_LOG_LEVEL sti::LOG_TRACE
+#endif
+
+// STI_LOG(sti::LOG_DEBUG, "rotation #" << id << " unit=" << unit);
+// The stream expression is only evaluated when the level is enabled.
+#define STI_LOG(level, text) \
+	do { \
+		if ((level) >= STI_LOG_LEVEL && sti::NativeLog::isEnabled(level)) \
+		{ \
+			std::ostringstream stiLogText; \
+			stiLogText << text; \
+			sti::NativeLog::post((level), stiLogText.str()); \
+		} \
+	} while (0)
+#endif
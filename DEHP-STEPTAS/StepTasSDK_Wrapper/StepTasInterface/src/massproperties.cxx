@@ -0,0 +1,590 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="massproperties.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "massproperties.hxx"
+#include "geometrystore.hxx"
+#include "materialindex.hxx"
+#include "transform.hxx"
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define STI_HAS_AVX2_KERNEL 1
+#if defined(_MSC_VER)
+#define STI_AVX2_TARGET
+#else
+#define STI_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace sti;
+
+namespace
+{
+	// The scalar and AVX2 versions of each formula do the same operations in the same order,
+	// so a surface gets the same area whichever lane computes it (angularSpan is in geometrystore.hxx).
+	//
+	double norm(double x, double y, double z)
+	{
+		return std::sqrt(x * x + y * y + z * z);
+	}
+
+	// |a x b|
+	double crossNorm(double ax, double ay, double az, double bx, double by, double bz)
+	{
+		return norm(ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx);
+	}
+
+	// the columns of a table, c[GEO_P2X + 1][i] is the y of P2 of row i
+	double edge(const double* const* c, int from, int to, int axis, size_t i)
+	{
+		return c[GEO_P1X + 3 * to + axis][i] - c[GEO_P1X + 3 * from + axis][i];
+	}
+
+	double edgeLength(const double* const* c, int from, int to, size_t i)
+	{
+		return norm(edge(c, from, to, 0, i), edge(c, from, to, 1, i), edge(c, from, to, 2, i));
+	}
+
+	double edgeCrossNorm(const double* const* c, int a0, int a1, int b0, int b1, size_t i)
+	{
+		return crossNorm(edge(c, a0, a1, 0, i), edge(c, a0, a1, 1, i), edge(c, a0, a1, 2, i),
+			edge(c, b0, b1, 0, i), edge(c, b0, b1, 1, i), edge(c, b0, b1, 2, i));
+	}
+
+	template <int Type>
+	double surfaceArea(const double* const* c, size_t i)
+	{
+		if constexpr (Type == RECTANGLE)
+		{
+			return edgeCrossNorm(c, 0, 1, 0, 2, i);
+		}
+		else if constexpr (Type == TRIANGLE)
+		{
+			return 0.5 * edgeCrossNorm(c, 0, 1, 0, 2, i);
+		}
+		else if constexpr (Type == QUADRILATERAL)
+		{
+			// half the cross product of the diagonals
+			return 0.5 * edgeCrossNorm(c, 0, 2, 1, 3, i);
+		}
+		else if constexpr (Type == CYLINDER)
+		{
+			return std::fabs(c[GEO_RADIUS1][i]) * angularSpan(c[GEO_START_ANGLE][i], c[GEO_END_ANGLE][i]) * edgeLength(c, 0, 1, i);
+		}
+		else if constexpr (Type == CONE)
+		{
+			// frustum between the radius at P1 and the radius at P2
+			double r1 = std::fabs(c[GEO_RADIUS1][i]), r2 = std::fabs(c[GEO_RADIUS2][i]);
+			double height = edgeLength(c, 0, 1, i);
+			double slant = std::sqrt(height * height + (r1 - r2) * (r1 - r2));
+			return 0.5 * angularSpan(c[GEO_START_ANGLE][i], c[GEO_END_ANGLE][i]) * (r1 + r2) * slant;
+		}
+		else if constexpr (Type == DISC)
+		{
+			double inner = c[GEO_RADIUS1][i], outer = c[GEO_RADIUS2][i];
+			return 0.5 * angularSpan(c[GEO_START_ANGLE][i], c[GEO_END_ANGLE][i]) * std::fabs(outer * outer - inner * inner);
+		}
+		else if constexpr (Type == SPHERE)
+		{
+			// zone between the truncation planes: 2 pi r h for a full turn
+			double r = std::fabs(c[GEO_RADIUS1][i]);
+			double top = std::min(std::max(c[GEO_APEX_TRUNCATION][i], -r), r);
+			double bottom = std::min(std::max(c[GEO_BASE_TRUNCATION][i], -r), r);
+			return angularSpan(c[GEO_START_ANGLE][i], c[GEO_END_ANGLE][i]) * r * std::max(top - bottom, 0.0);
+		}
+		else if constexpr (Type == PARABOLOID)
+		{
+			// z = h (r / R)^2 from the apex P1, cut at z0. With u = 1 + 4 h z / R^2 the area is
+			// span R^2 / (12 h) (u1^3/2 - u0^3/2), written without the cancellation of flat paraboloids
+			double r = std::fabs(c[GEO_RADIUS1][i]);
+			double h = edgeLength(c, 0, 1, i);
+			double z0 = std::min(std::max(c[GEO_APEX_TRUNCATION][i], 0.0), h);
+			double r2 = r * r;
+			double u1 = 1.0 + 4.0 * h * h / r2, u0 = 1.0 + 4.0 * h * z0 / r2;
+			double cut = (h > 0.0) ? (h - z0) / h : 1.0;
+			double area = angularSpan(c[GEO_START_ANGLE][i], c[GEO_END_ANGLE][i]) * r2 * cut / 3.0
+				* (u1 * u1 + u1 * u0 + u0 * u0) / (u1 * std::sqrt(u1) + u0 * std::sqrt(u0));
+			return (r > 0.0) ? area : 0.0;
+		}
+		else
+		{
+			return 0.0;
+		}
+	}
+
+	template <int Type>
+	void surfaceAreas(const double* const* c, double* area, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			area[i] = surfaceArea<Type>(c, i);
+		}
+	}
+
+	void sideMasses(const double* area, const double* thickness1, const double* density1,
+		const double* thickness2, const double* density2, double* mass, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			mass[i] = area[i] * (thickness1[i] * density1[i] + thickness2[i] * density2[i]);
+		}
+	}
+
+#ifdef STI_HAS_AVX2_KERNEL
+	STI_AVX2_TARGET inline __m256d abs4(__m256d x)
+	{
+		return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+	}
+
+	STI_AVX2_TARGET inline __m256d clamp4(__m256d x, __m256d low, __m256d high)
+	{
+		return _mm256_min_pd(_mm256_max_pd(x, low), high);
+	}
+
+	STI_AVX2_TARGET inline __m256d angularSpan4(const double* const* c, size_t i)
+	{
+		__m256d degrees = _mm256_sub_pd(_mm256_loadu_pd(c[GEO_END_ANGLE] + i), _mm256_loadu_pd(c[GEO_START_ANGLE] + i));
+		__m256d wrap = _mm256_cmp_pd(degrees, _mm256_setzero_pd(), _CMP_LT_OQ);
+		degrees = _mm256_blendv_pd(degrees, _mm256_add_pd(degrees, _mm256_set1_pd(360.0)), wrap);
+		degrees = clamp4(degrees, _mm256_setzero_pd(), _mm256_set1_pd(360.0));
+		return _mm256_mul_pd(degrees, _mm256_set1_pd(DegreesToRadians));
+	}
+
+	STI_AVX2_TARGET inline __m256d norm4(__m256d x, __m256d y, __m256d z)
+	{
+		return _mm256_sqrt_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)), _mm256_mul_pd(z, z)));
+	}
+
+	STI_AVX2_TARGET inline __m256d edge4(const double* const* c, int from, int to, int axis, size_t i)
+	{
+		return _mm256_sub_pd(_mm256_loadu_pd(c[GEO_P1X + 3 * to + axis] + i), _mm256_loadu_pd(c[GEO_P1X + 3 * from + axis] + i));
+	}
+
+	STI_AVX2_TARGET inline __m256d edgeLength4(const double* const* c, int from, int to, size_t i)
+	{
+		return norm4(edge4(c, from, to, 0, i), edge4(c, from, to, 1, i), edge4(c, from, to, 2, i));
+	}
+
+	STI_AVX2_TARGET inline __m256d edgeCrossNorm4(const double* const* c, int a0, int a1, int b0, int b1, size_t i)
+	{
+		__m256d ax = edge4(c, a0, a1, 0, i), ay = edge4(c, a0, a1, 1, i), az = edge4(c, a0, a1, 2, i);
+		__m256d bx = edge4(c, b0, b1, 0, i), by = edge4(c, b0, b1, 1, i), bz = edge4(c, b0, b1, 2, i);
+		return norm4(_mm256_sub_pd(_mm256_mul_pd(ay, bz), _mm256_mul_pd(az, by)),
+			_mm256_sub_pd(_mm256_mul_pd(az, bx), _mm256_mul_pd(ax, bz)),
+			_mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(ay, bx)));
+	}
+
+	template <int Type>
+	STI_AVX2_TARGET inline __m256d surfaceArea4(const double* const* c, size_t i)
+	{
+		const __m256d zero = _mm256_setzero_pd(), half = _mm256_set1_pd(0.5);
+		if constexpr (Type == RECTANGLE)
+		{
+			return edgeCrossNorm4(c, 0, 1, 0, 2, i);
+		}
+		else if constexpr (Type == TRIANGLE)
+		{
+			return _mm256_mul_pd(half, edgeCrossNorm4(c, 0, 1, 0, 2, i));
+		}
+		else if constexpr (Type == QUADRILATERAL)
+		{
+			return _mm256_mul_pd(half, edgeCrossNorm4(c, 0, 2, 1, 3, i));
+		}
+		else if constexpr (Type == CYLINDER)
+		{
+			return _mm256_mul_pd(_mm256_mul_pd(abs4(_mm256_loadu_pd(c[GEO_RADIUS1] + i)), angularSpan4(c, i)), edgeLength4(c, 0, 1, i));
+		}
+		else if constexpr (Type == CONE)
+		{
+			__m256d r1 = abs4(_mm256_loadu_pd(c[GEO_RADIUS1] + i)), r2 = abs4(_mm256_loadu_pd(c[GEO_RADIUS2] + i));
+			__m256d height = edgeLength4(c, 0, 1, i);
+			__m256d step = _mm256_sub_pd(r1, r2);
+			__m256d slant = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(height, height), _mm256_mul_pd(step, step)));
+			return _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(half, angularSpan4(c, i)), _mm256_add_pd(r1, r2)), slant);
+		}
+		else if constexpr (Type == DISC)
+		{
+			__m256d inner = _mm256_loadu_pd(c[GEO_RADIUS1] + i), outer = _mm256_loadu_pd(c[GEO_RADIUS2] + i);
+			__m256d ring = abs4(_mm256_sub_pd(_mm256_mul_pd(outer, outer), _mm256_mul_pd(inner, inner)));
+			return _mm256_mul_pd(_mm256_mul_pd(half, angularSpan4(c, i)), ring);
+		}
+		else if constexpr (Type == SPHERE)
+		{
+			__m256d r = abs4(_mm256_loadu_pd(c[GEO_RADIUS1] + i));
+			__m256d low = _mm256_sub_pd(zero, r);
+			__m256d top = clamp4(_mm256_loadu_pd(c[GEO_APEX_TRUNCATION] + i), low, r);
+			__m256d bottom = clamp4(_mm256_loadu_pd(c[GEO_BASE_TRUNCATION] + i), low, r);
+			return _mm256_mul_pd(_mm256_mul_pd(angularSpan4(c, i), r), _mm256_max_pd(_mm256_sub_pd(top, bottom), zero));
+		}
+		else if constexpr (Type == PARABOLOID)
+		{
+			// the lanes with h = 0 or R = 0 divide by zero, their result is replaced by the blends
+			const __m256d one = _mm256_set1_pd(1.0), four = _mm256_set1_pd(4.0);
+			__m256d r = abs4(_mm256_loadu_pd(c[GEO_RADIUS1] + i));
+			__m256d h = edgeLength4(c, 0, 1, i);
+			__m256d z0 = clamp4(_mm256_loadu_pd(c[GEO_APEX_TRUNCATION] + i), zero, h);
+			__m256d r2 = _mm256_mul_pd(r, r);
+			__m256d u1 = _mm256_add_pd(one, _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(four, h), h), r2));
+			__m256d u0 = _mm256_add_pd(one, _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(four, h), z0), r2));
+			__m256d cut = _mm256_blendv_pd(one, _mm256_div_pd(_mm256_sub_pd(h, z0), h), _mm256_cmp_pd(h, zero, _CMP_GT_OQ));
+			__m256d sum = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(u1, u1), _mm256_mul_pd(u1, u0)), _mm256_mul_pd(u0, u0));
+			__m256d powers = _mm256_add_pd(_mm256_mul_pd(u1, _mm256_sqrt_pd(u1)), _mm256_mul_pd(u0, _mm256_sqrt_pd(u0)));
+			__m256d area = _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(angularSpan4(c, i), r2), cut), _mm256_set1_pd(3.0));
+			area = _mm256_div_pd(_mm256_mul_pd(area, sum), powers);
+			return _mm256_blendv_pd(zero, area, _mm256_cmp_pd(r, zero, _CMP_GT_OQ));
+		}
+		else
+		{
+			return zero;
+		}
+	}
+
+	// four surfaces per iteration, returns the number of rows done
+	//
+	template <int Type>
+	STI_AVX2_TARGET size_t surfaceAreasAvx2(const double* const* c, double* area, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			_mm256_storeu_pd(area + i, surfaceArea4<Type>(c, i));
+		}
+		return i;
+	}
+
+	STI_AVX2_TARGET size_t sideMassesAvx2(const double* area, const double* thickness1, const double* density1,
+		const double* thickness2, const double* density2, double* mass, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256d side1 = _mm256_mul_pd(_mm256_loadu_pd(thickness1 + i), _mm256_loadu_pd(density1 + i));
+			__m256d side2 = _mm256_mul_pd(_mm256_loadu_pd(thickness2 + i), _mm256_loadu_pd(density2 + i));
+			_mm256_storeu_pd(mass + i, _mm256_mul_pd(_mm256_loadu_pd(area + i), _mm256_add_pd(side1, side2)));
+		}
+		return i;
+	}
+#endif
+
+	template <int Type>
+	void computeAreas(const double* const* c, double* area, size_t n)
+	{
+		size_t done = 0;
+#ifdef STI_HAS_AVX2_KERNEL
+		if (hasAvx2Kernels()) done = surfaceAreasAvx2<Type>(c, area, n);
+#endif
+		surfaceAreas<Type>(c, area, done, n);
+	}
+
+	typedef void (*AreaKernel)(const double* const* c, double* area, size_t n);
+
+	// indexed by NodeType - RECTANGLE
+	const AreaKernel AreaKernels[] = {
+		&computeAreas<RECTANGLE>,
+		&computeAreas<QUADRILATERAL>,
+		&computeAreas<SPHERE>,
+		&computeAreas<CONE>,
+		&computeAreas<CYLINDER>,
+		&computeAreas<DISC>,
+		&computeAreas<PARABOLOID>,
+		&computeAreas<TRIANGLE>,
+	};
+
+	// Densities of the side materials per row. The surfaces of a compound mostly share their
+	// materials, so the last material of each side is remembered across rows.
+	//
+	class DensityLookup
+	{
+	public:
+		explicit DensityLookup(MaterialIndex& materials) : m_materials(materials) {}
+
+		double density(long stepId)
+		{
+			if (stepId == 0) return std::numeric_limits<double>::quiet_NaN();
+			if (stepId == m_last) return m_last_density;
+			auto it = m_densities.find(stepId);
+			if (it == m_densities.end())
+			{
+				int material = m_materials.findMaterialByStepId(stepId);
+				double value = (material < 0) ? std::numeric_limits<double>::quiet_NaN()
+					: m_materials.getLastValue(material, MQ_MASS_DENSITY);
+				it = m_densities.emplace(stepId, value).first;
+			}
+			m_last = stepId;
+			m_last_density = it->second;
+			return m_last_density;
+		}
+
+	private:
+		MaterialIndex& m_materials;
+		std::unordered_map<long, double> m_densities;
+		long m_last = 0;
+		double m_last_density = 0.0;
+	};
+}
+
+void MassProperties::computeSurfaces(GeometryStore& geometry, MaterialIndex& materials)
+{
+	DensityLookup lookup(materials);
+	std::vector<double> density1, density2;
+	for (int index = 0; index < TableCount; index++)
+	{
+		PrimitiveTable* table = geometry.getTable((NodeType)(RECTANGLE + index));
+		size_t rows = (size_t)table->size();
+		m_area[index].assign(rows, 0.0);
+		m_mass[index].assign(rows, 0.0);
+		m_missing[index].assign(rows, 0);
+		if (rows == 0) continue;
+
+		const double* columns[GEO_COLUMN_COUNT];
+		for (int column = 0; column < GEO_COLUMN_COUNT; column++)
+		{
+			columns[column] = table->columnData((GeometryColumn)column);
+		}
+		AreaKernels[index](columns, m_area[index].data(), rows);
+
+		// a side without a thickness needs no density, the NaN of a missing one must not reach the kernel
+		const double* thickness1 = columns[GEO_SIDE1_THICKNESS];
+		const double* thickness2 = columns[GEO_SIDE2_THICKNESS];
+		const long* material1 = table->indexColumnData(GEO_SIDE1_MATERIAL);
+		const long* material2 = table->indexColumnData(GEO_SIDE2_MATERIAL);
+		density1.resize(rows);
+		density2.resize(rows);
+		for (size_t row = 0; row < rows; row++)
+		{
+			double d1 = (thickness1[row] != 0.0) ? lookup.density(material1[row]) : 0.0;
+			double d2 = (thickness2[row] != 0.0) ? lookup.density(material2[row]) : 0.0;
+			m_missing[index][row] = (std::isnan(d1) || std::isnan(d2)) ? 1 : 0;
+			density1[row] = std::isnan(d1) ? 0.0 : d1;
+			density2[row] = std::isnan(d2) ? 0.0 : d2;
+		}
+
+		size_t done = 0;
+#ifdef STI_HAS_AVX2_KERNEL
+		if (hasAvx2Kernels())
+		{
+			done = sideMassesAvx2(m_area[index].data(), thickness1, density1.data(), thickness2, density2.data(),
+				m_mass[index].data(), rows);
+		}
+#endif
+		sideMasses(m_area[index].data(), thickness1, density1.data(), thickness2, density2.data(),
+			m_mass[index].data(), done, rows);
+	}
+}
+
+// The walk stops at the bounded surfaces: their sides and faces add nothing and are not created.
+// Every node gets a row before the surfaces are computed, since reading a pending level of a lazy
+// tree adds its surfaces to the geometry store.
+//
+void MassProperties::build(TasNode* root, GeometryStore& geometry, MaterialIndex& materials)
+{
+	m_geometry = &geometry;
+	m_ids.clear();
+	m_parents.clear();
+	m_rows.clear();
+	m_built = true;
+	if (root == nullptr) return;
+
+	struct Entry
+	{
+		TasNode* node;
+		int parent;
+	};
+	std::vector<Entry> stack;
+	std::vector<NodeType> types;
+	stack.push_back({ root, -1 });
+	while (!stack.empty())
+	{
+		Entry entry = stack.back();
+		stack.pop_back();
+
+		int row = (int)m_ids.size();
+		m_ids.push_back(entry.node->id);
+		m_parents.push_back(entry.parent);
+		types.push_back(entry.node->getNodeType());
+		m_rows.emplace(entry.node->id, row);
+		if (isBoundedSurface(types.back())) continue;
+
+		std::vector<TasNode*>& children = entry.node->children();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			if (*it != nullptr) stack.push_back({ *it, row });
+		}
+	}
+
+	computeSurfaces(geometry, materials);
+
+	// children come after their parent in pre-order, so a reverse pass sums the subtrees
+	size_t count = m_ids.size();
+	m_node_area.assign(count, 0.0);
+	m_node_mass.assign(count, 0.0);
+	m_node_surfaces.assign(count, 0);
+	m_node_missing.assign(count, 0);
+	for (size_t row = count; row-- > 0;)
+	{
+		if (isBoundedSurface(types[row]))
+		{
+			// the node type gives the table, a BOUNDEDSURFACE has none
+			int table = (int)types[row] - RECTANGLE;
+			int surface = (table >= 0) ? geometry.getTable(types[row])->findRow(m_ids[row]) : -1;
+			if (surface >= 0 && surface < (int)m_area[table].size())
+			{
+				m_node_area[row] = m_area[table][surface];
+				m_node_mass[row] = m_mass[table][surface];
+				m_node_missing[row] = m_missing[table][surface];
+			}
+			m_node_surfaces[row] = 1;
+		}
+		int parent = m_parents[row];
+		if (parent < 0) continue;
+		m_node_area[parent] += m_node_area[row];
+		m_node_mass[parent] += m_node_mass[row];
+		m_node_surfaces[parent] += m_node_surfaces[row];
+		m_node_missing[parent] += m_node_missing[row];
+	}
+}
+
+int MassProperties::surfaceRow(long surfaceId, int& table)
+{
+	if (m_geometry == nullptr) return -1;
+	table = (int)m_geometry->findSurfaceType(surfaceId) - RECTANGLE;
+	if (table < 0 || table >= TableCount) return -1;
+	int row = m_geometry->findSurfaceRow(surfaceId);
+	return (row < (int)m_area[table].size()) ? row : -1;
+}
+
+double* MassProperties::areaData(NodeType type)
+{
+	int index = (int)type - RECTANGLE;
+	if (index < 0 || index >= TableCount || m_area[index].empty()) return nullptr;
+	return m_area[index].data();
+}
+
+double* MassProperties::massData(NodeType type)
+{
+	int index = (int)type - RECTANGLE;
+	if (index < 0 || index >= TableCount || m_mass[index].empty()) return nullptr;
+	return m_mass[index].data();
+}
+
+void MassProperties::copyAreas(NodeType type, double* values)
+{
+	const double* data = areaData(type);
+	if (data != nullptr && values != nullptr)
+	{
+		std::memcpy(values, data, m_area[type - RECTANGLE].size() * sizeof(double));
+	}
+}
+
+void MassProperties::copyMasses(NodeType type, double* values)
+{
+	const double* data = massData(type);
+	if (data != nullptr && values != nullptr)
+	{
+		std::memcpy(values, data, m_mass[type - RECTANGLE].size() * sizeof(double));
+	}
+}
+
+double MassProperties::getSurfaceArea(long surfaceId)
+{
+	int table = 0;
+	int row = surfaceRow(surfaceId, table);
+	return (row < 0) ? 0.0 : m_area[table][row];
+}
+
+double MassProperties::getSurfaceMass(long surfaceId)
+{
+	int table = 0;
+	int row = surfaceRow(surfaceId, table);
+	return (row < 0) ? 0.0 : m_mass[table][row];
+}
+
+int MassProperties::nodeCount()
+{
+	return (int)m_ids.size();
+}
+
+int MassProperties::findNode(long nodeId)
+{
+	auto it = m_rows.find(nodeId);
+	return (it == m_rows.end()) ? -1 : it->second;
+}
+
+double MassProperties::getArea(long nodeId)
+{
+	int row = findNode(nodeId);
+	return (row < 0) ? 0.0 : m_node_area[row];
+}
+
+double MassProperties::getMass(long nodeId)
+{
+	int row = findNode(nodeId);
+	return (row < 0) ? 0.0 : m_node_mass[row];
+}
+
+int MassProperties::getSurfaceCount(long nodeId)
+{
+	int row = findNode(nodeId);
+	return (row < 0) ? 0 : m_node_surfaces[row];
+}
+
+int MassProperties::getMissingDensityCount(long nodeId)
+{
+	int row = findNode(nodeId);
+	return (row < 0) ? 0 : m_node_missing[row];
+}
+
+void MassProperties::copyNodeIds(long* ids)
+{
+	if (!m_ids.empty() && ids != nullptr)
+	{
+		std::memcpy(ids, m_ids.data(), m_ids.size() * sizeof(long));
+	}
+}
+
+void MassProperties::copyParents(int* parents)
+{
+	if (!m_parents.empty() && parents != nullptr)
+	{
+		std::memcpy(parents, m_parents.data(), m_parents.size() * sizeof(int));
+	}
+}
+
+void MassProperties::copyNodeAreas(double* values)
+{
+	if (!m_node_area.empty() && values != nullptr)
+	{
+		std::memcpy(values, m_node_area.data(), m_node_area.size() * sizeof(double));
+	}
+}
+
+void MassProperties::copyNodeMasses(double* values)
+{
+	if (!m_node_mass.empty() && values != nullptr)
+	{
+		std::memcpy(values, m_node_mass.data(), m_node_mass.size() * sizeof(double));
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="massproperties.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Mass properties
+// Area and mass of every bounded surface, summed up to every node above the surfaces. The areas are
+// computed from the geometry store columns, one primitive type at a time, four surfaces per AVX2 step.
+// The transformations are rigid, so the local points give the model areas.
+// Angles are in degrees, a span of 0 or less wraps around (an unset start/end pair is a full turn).
+// Sphere truncations are positions along the axis from the centre, the paraboloid apex truncation a
+// height from the apex.
+// The mass of a side is area * thickness * mass density of its material. The density is the last
+// environment value of the MaterialIndex; a side with a thickness but no density adds no mass and is
+// counted in getMissingDensityCount.
+
+#include <vector>
+#include <unordered_map>
+#include "interface.hxx"
+
+namespace sti
+{
+	class GeometryStore;
+	class MaterialIndex;
+
+	class MassProperties
+	{
+	public:
+		// per surface, in the rows of the PrimitiveTable of the type. nullptr for an empty table
+		double* areaData(NodeType type);
+		double* massData(NodeType type);
+		// PrimitiveTable::size() entries
+		void copyAreas(NodeType type, double* values);
+		void copyMasses(NodeType type, double* values);
+		// 0.0 when the surface is unknown
+		double getSurfaceArea(long surfaceId);
+		double getSurfaceMass(long surfaceId);
+
+		// nodes of the tree from the root down to the bounded surfaces, in pre-order
+		int nodeCount();
+		int findNode(long nodeId); // -1 when the node is not in the table
+		// sums over the surfaces under the node (the node itself for a surface), 0 when unknown
+		double getArea(long nodeId);
+		double getMass(long nodeId);
+		int getSurfaceCount(long nodeId);
+		int getMissingDensityCount(long nodeId);
+		// nodeCount() entries
+		void copyNodeIds(long* ids);
+		void copyParents(int* parents); // parent row, -1 for the root
+		void copyNodeAreas(double* values);
+		void copyNodeMasses(double* values);
+
+#ifndef SWIG
+		// reads the pending levels of a lazy tree, the geometry store is complete afterwards
+		void build(TasNode* root, GeometryStore& geometry, MaterialIndex& materials);
+		bool isBuilt() const { return m_built; }
+	private:
+		void computeSurfaces(GeometryStore& geometry, MaterialIndex& materials);
+		int surfaceRow(long surfaceId, int& table);
+
+		static const int TableCount = TRIANGLE - RECTANGLE + 1;
+		GeometryStore* m_geometry = nullptr;
+		std::vector<double> m_area[TableCount];
+		std::vector<double> m_mass[TableCount];
+		std::vector<unsigned char> m_missing[TableCount]; // thickness without a density
+
+		std::vector<long> m_ids;
+		std::vector<int> m_parents;
+		std::vector<double> m_node_area;
+		std::vector<double> m_node_mass;
+		std::vector<int> m_node_surfaces;
+		std::vector<int> m_node_missing;
+		std::unordered_map<long, int> m_rows; // first node in pre-order on duplicate ids
+		bool m_built = false;
+#endif
+	};
+}
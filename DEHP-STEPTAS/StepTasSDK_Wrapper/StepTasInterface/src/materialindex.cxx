@@ -0,0 +1,170 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="materialindex.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <cmath>
+#include <limits>
+
+#include "materialindex.hxx"
+
+using namespace sti;
+
+namespace
+{
+	const char* QuantityNames[MQ_COUNT] = {
+		"solar_absorptance",
+		"solar_direct_transmittance",
+		"solar_diffuse_transmittance",
+		"solar_specularity",
+		"solar_refraction_index",
+		"infra_red_emittance",
+		"infra_red_direct_transmittance",
+		"infra_red_diffuse_transmittance",
+		"infra_red_specularity",
+		"infra_red_refraction_index",
+		"mass_density",
+		"constant_pressure_specific_heat_capacity",
+		"thermal_conductivity"
+	};
+
+	const double Missing = std::numeric_limits<double>::quiet_NaN();
+}
+
+MaterialIndex::MaterialIndex()
+{
+}
+
+const char* MaterialIndex::quantityName(MaterialQuantity quantity)
+{
+	if (quantity < 0 || quantity >= MQ_COUNT) return "";
+	return QuantityNames[quantity];
+}
+
+void MaterialIndex::reset(const std::vector<std::string>& materialIds, const std::vector<std::string>& environmentNames)
+{
+	m_materials = materialIds;
+	m_environments = environmentNames;
+	m_material_rows.clear();
+	m_step_rows.clear();
+	for (size_t row = 0; row < m_materials.size(); row++)
+	{
+		// the first row wins if an id is listed twice
+		m_material_rows.emplace(m_materials[row], (int)row);
+	}
+	m_values.assign(m_materials.size() * m_environments.size() * MQ_COUNT, Missing);
+}
+
+void MaterialIndex::set(int material, int environment, MaterialQuantity quantity, double value)
+{
+	if (!valid(material, environment) || quantity < 0 || quantity >= MQ_COUNT) return;
+	m_values[offset(material, environment, quantity)] = value;
+}
+
+void MaterialIndex::setStepId(long stepId, int material)
+{
+	if (material < 0 || material >= materialCount()) return;
+	m_step_rows[stepId] = material;
+}
+
+size_t MaterialIndex::offset(int material, int environment, MaterialQuantity quantity) const
+{
+	return ((size_t)material * m_environments.size() + environment) * MQ_COUNT + quantity;
+}
+
+bool MaterialIndex::valid(int material, int environment) const
+{
+	return material >= 0 && material < (int)m_materials.size()
+		&& environment >= 0 && environment < (int)m_environments.size();
+}
+
+int MaterialIndex::materialCount()
+{
+	return (int)m_materials.size();
+}
+
+int MaterialIndex::environmentCount()
+{
+	return (int)m_environments.size();
+}
+
+std::string MaterialIndex::getMaterialId(int material)
+{
+	if (material < 0 || material >= materialCount()) return "";
+	return m_materials[material];
+}
+
+std::string MaterialIndex::getEnvironmentName(int environment)
+{
+	if (environment < 0 || environment >= environmentCount()) return "";
+	return m_environments[environment];
+}
+
+int MaterialIndex::findMaterial(const std::string& materialId)
+{
+	auto it = m_material_rows.find(materialId);
+	return it == m_material_rows.end() ? -1 : it->second;
+}
+
+int MaterialIndex::findMaterialByStepId(long stepId)
+{
+	auto it = m_step_rows.find(stepId);
+	return it == m_step_rows.end() ? -1 : it->second;
+}
+
+int MaterialIndex::findEnvironment(const std::string& environmentName)
+{
+	for (size_t environment = 0; environment < m_environments.size(); environment++)
+	{
+		if (m_environments[environment] == environmentName) return (int)environment;
+	}
+	return -1;
+}
+
+double MaterialIndex::getValue(int material, int environment, MaterialQuantity quantity)
+{
+	if (!valid(material, environment) || quantity < 0 || quantity >= MQ_COUNT) return Missing;
+	return m_values[offset(material, environment, quantity)];
+}
+
+bool MaterialIndex::hasValue(int material, int environment, MaterialQuantity quantity)
+{
+	return !std::isnan(getValue(material, environment, quantity));
+}
+
+double MaterialIndex::getLastValue(int material, MaterialQuantity quantity)
+{
+	for (int environment = environmentCount() - 1; environment >= 0; environment--)
+	{
+		if (hasValue(material, environment, quantity))
+		{
+			return getValue(material, environment, quantity);
+		}
+	}
+	return Missing;
+}
+
+void MaterialIndex::copyValues(int material, MaterialQuantity quantity, double* values)
+{
+	for (int environment = 0; environment < environmentCount(); environment++)
+	{
+		values[environment] = getValue(material, environment, quantity);
+	}
+}
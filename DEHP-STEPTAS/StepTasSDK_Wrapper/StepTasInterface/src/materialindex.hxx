@@ -0,0 +1,96 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="materialindex.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Material index
+// Dense [material x environment x quantity] matrix of the material property values, built once when the
+// file is loaded from the SDK material properties table. Materials and environments are referred to by
+// their row in the index, the string ids are only looked up once.
+// Values missing from the file are NaN.
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sti
+{
+	enum MaterialQuantity
+	{
+		// surface (optical) properties
+		MQ_SOLAR_ABSORPTANCE,
+		MQ_SOLAR_DIRECT_TRANSMITTANCE,
+		MQ_SOLAR_DIFFUSE_TRANSMITTANCE,
+		MQ_SOLAR_SPECULARITY,
+		MQ_SOLAR_REFRACTION_INDEX,
+		MQ_INFRARED_EMITTANCE,
+		MQ_INFRARED_DIRECT_TRANSMITTANCE,
+		MQ_INFRARED_DIFFUSE_TRANSMITTANCE,
+		MQ_INFRARED_SPECULARITY,
+		MQ_INFRARED_REFRACTION_INDEX,
+		// bulk properties
+		MQ_MASS_DENSITY,
+		MQ_SPECIFIC_HEAT_CAPACITY,
+		MQ_THERMAL_CONDUCTIVITY,
+		MQ_COUNT
+	};
+
+	class MaterialIndex
+	{
+	public:
+		int materialCount();
+		int environmentCount();
+		std::string getMaterialId(int material);
+		std::string getEnvironmentName(int environment);
+		// -1 when unknown
+		int findMaterial(const std::string& materialId);
+		int findMaterialByStepId(long stepId);
+		int findEnvironment(const std::string& environmentName);
+
+		double getValue(int material, int environment, MaterialQuantity quantity);
+		bool hasValue(int material, int environment, MaterialQuantity quantity);
+		// value of the last environment defining the quantity, NaN if none does
+		double getLastValue(int material, MaterialQuantity quantity);
+		// one value per environment into a buffer of environmentCount() entries
+		void copyValues(int material, MaterialQuantity quantity, double* values);
+
+		// name used by the SDK material properties table
+		static const char* quantityName(MaterialQuantity quantity);
+
+#ifndef SWIG
+		MaterialIndex();
+		void reset(const std::vector<std::string>& materialIds, const std::vector<std::string>& environmentNames);
+		void set(int material, int environment, MaterialQuantity quantity, double value);
+		void setStepId(long stepId, int material);
+		const std::unordered_map<long, int>& stepRows() const { return m_step_rows; }
+	private:
+		size_t offset(int material, int environment, MaterialQuantity quantity) const;
+		bool valid(int material, int environment) const;
+
+		std::vector<std::string> m_materials;
+		std::vector<std::string> m_environments;
+		std::unordered_map<std::string, int> m_material_rows;
+		std::unordered_map<long, int> m_step_rows;
+		std::vector<double> m_values;
+#endif
+	};
+}
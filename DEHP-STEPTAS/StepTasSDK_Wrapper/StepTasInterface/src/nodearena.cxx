@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodearena.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "nodearena.hxx"
+
+NodeArena::NodeArena(size_t blockSize) : m_blockSize(blockSize)
+{
+}
+
+NodeArena::~NodeArena()
+{
+	clear();
+}
+
+void NodeArena::clear()
+{
+	// reverse creation order, children are created after their parents
+	for (auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it)
+	{
+		it->destroy(it->object);
+	}
+	m_destructors.clear();
+	m_blocks.clear();
+	m_objects = 0;
+}
+
+void NodeArena::adopt(NodeArena& other)
+{
+	if (&other == this) return;
+
+	// the adopted blocks go in front so the current block stays the one being filled
+	m_blocks.insert(m_blocks.begin(),
+		std::make_move_iterator(other.m_blocks.begin()), std::make_move_iterator(other.m_blocks.end()));
+	m_destructors.insert(m_destructors.end(), other.m_destructors.begin(), other.m_destructors.end());
+	m_objects += other.m_objects;
+
+	other.m_blocks.clear();
+	other.m_destructors.clear();
+	other.m_objects = 0;
+}
+
+void NodeArena::reserve(size_t bytes)
+{
+	if (!m_blocks.empty() && m_blocks.back().size - m_blocks.back().used >= bytes) return;
+
+	Block block;
+	block.data.reset(new unsigned char[bytes]);
+	block.size = bytes;
+	block.used = 0;
+	m_blocks.push_back(std::move(block));
+}
+
+size_t NodeArena::bytesReserved() const
+{
+	size_t total = 0;
+	for (const Block& block : m_blocks)
+	{
+		total += block.size;
+	}
+	return total;
+}
+
+void* NodeArena::allocate(size_t size, size_t alignment)
+{
+	if (!m_blocks.empty())
+	{
+		// the address is aligned, not the offset: alignof(T) may exceed the alignment of new[]
+		Block& block = m_blocks.back();
+		size_t base = reinterpret_cast<size_t>(block.data.get());
+		size_t offset = ((base + block.used + alignment - 1) & ~(alignment - 1)) - base;
+		if (offset + size <= block.size)
+		{
+			block.used = offset + size;
+			return block.data.get() + offset;
+		}
+	}
+
+	// new block, oversized requests get a block of their own
+	size_t blockSize = (size + alignment > m_blockSize) ? size + alignment : m_blockSize;
+	Block block;
+	block.data.reset(new unsigned char[blockSize]);
+	block.size = blockSize;
+	size_t base = reinterpret_cast<size_t>(block.data.get());
+	size_t offset = ((base + alignment - 1) & ~(alignment - 1)) - base;
+	block.used = offset + size;
+	m_blocks.push_back(std::move(block));
+	return m_blocks.back().data.get() + offset;
+}
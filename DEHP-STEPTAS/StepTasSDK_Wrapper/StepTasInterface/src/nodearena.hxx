@@ -0,0 +1,100 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodearena.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// Node arena
+// Every TasNode (and Material) built while processing a file is placed in large contiguous blocks owned
+// by the arena. Nothing is freed individually: the arena runs the destructors and releases its blocks
+// when it is cleared or destroyed, so dropping a FileData releases the whole model at once.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class NodeArena
+{
+public:
+	static const size_t DefaultBlockSize = 1 << 20;
+
+	explicit NodeArena(size_t blockSize = DefaultBlockSize);
+	~NodeArena();
+
+	NodeArena(const NodeArena&) = delete;
+	NodeArena& operator=(const NodeArena&) = delete;
+
+	// Construct a T inside the arena. The object is value-initialized when no argument is given,
+	// so the plain data members of the sti classes start at zero.
+	template <class T, class... Args>
+	T* create(Args&&... args)
+	{
+		void* mem = allocate(sizeof(T), alignof(T));
+		T* object = new (mem) T(std::forward<Args>(args)...);
+		if (!std::is_trivially_destructible<T>::value)
+		{
+			m_destructors.push_back({ object, &destroy<T> });
+		}
+		m_objects++;
+		return object;
+	}
+
+	// Make sure the next bytes of objects fit in one block, when their total is known in advance.
+	void reserve(size_t bytes);
+
+	// Destroy every object and release all blocks.
+	void clear();
+
+	// Take over the blocks and objects of another arena, which is left empty.
+	// Used to merge the node fragments built by parallel tasks.
+	void adopt(NodeArena& other);
+
+	size_t objectCount() const { return m_objects; }
+	size_t blockCount() const { return m_blocks.size(); }
+	size_t bytesReserved() const;
+
+private:
+	struct Block
+	{
+		std::unique_ptr<unsigned char[]> data;
+		size_t size;
+		size_t used;
+	};
+
+	struct Destructor
+	{
+		void* object;
+		void (*destroy)(void*);
+	};
+
+	template <class T>
+	static void destroy(void* object) { static_cast<T*>(object)->~T(); }
+
+	void* allocate(size_t size, size_t alignment);
+
+	std::vector<Block> m_blocks;
+	std::vector<Destructor> m_destructors;
+	size_t m_blockSize;
+	size_t m_objects = 0;
+};
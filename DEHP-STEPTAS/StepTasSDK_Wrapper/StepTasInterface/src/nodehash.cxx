@@ -0,0 +1,184 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodehash.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <utility>
+#include <vector>
+
+#include "nodehash.hxx"
+
+using namespace sti;
+
+namespace
+{
+	uint64_t faceHash(const std::string& name, const std::string& label, const std::string& classType,
+		const std::string& description, const std::string& networkNode, const std::string& model)
+	{
+		HashBuilder hash;
+		hash.add((uint64_t)FACE);
+		hash.add(name);
+		hash.add(label);
+		hash.add(classType);
+		hash.add(description);
+		hash.add(networkNode);
+		hash.add(model);
+		return hash.value();
+	}
+
+	uint64_t leafSubtreeHash(uint64_t content)
+	{
+		HashBuilder subtree;
+		subtree.add(content);
+		subtree.add((uint64_t)0);
+		return subtree.value();
+	}
+}
+
+// The fields materializeFaces gives the Face node of the row, so a row and its node hash the same
+//
+uint64_t NodeHashes::faceRowHash(FaceTable& table, int row)
+{
+	static const std::string nodeOnFace = "Node on Face";
+	static const std::string none;
+	bool linked = table.hasNetworkNode(row);
+	const std::string& networkNode = linked ? (const std::string&)table.text(table.getNetworkNodeId(row)) : none;
+	const std::string& model = linked ? (const std::string&)table.text(table.getModelId(row)) : none;
+	return faceHash(networkNode, linked ? nodeOnFace : none, table.text(table.getClassTypeId(row)), none,
+		networkNode, model);
+}
+
+uint64_t NodeHashes::contentHash(TasNode* node, GeometryStore& geometry)
+{
+	NodeType type = node->getNodeType();
+	if (type == FACE)
+	{
+		Face* face = static_cast<Face*>(node);
+		return faceHash(face->name, face->label, face->classType, face->description,
+			face->nrf_network_node, face->nrf_model);
+	}
+
+	HashBuilder hash;
+	hash.add((uint64_t)type);
+	hash.add(node->name);
+	hash.add(node->label);
+	hash.add(node->classType);
+	hash.add(node->description);
+
+	if (type != TASNODE)
+	{
+		BoundedSurface* surface = static_cast<BoundedSurface*>(node);
+		hash.add((uint64_t)surface->activeside);
+		hash.add(surface->side1_material_name);
+		hash.add(surface->side2_material_name);
+		hash.add(surface->side1_thickness);
+		hash.add(surface->side2_thickness);
+		hash.add((uint64_t)surface->dir1_meshing);
+		hash.add((uint64_t)surface->dir2_meshing);
+
+		// primitive values, the same columns as the geometry store
+		PrimitiveTable* table = geometry.getTable(type);
+		int row = (table == nullptr) ? -1 : table->findRow(surface->id);
+		if (row >= 0)
+		{
+			for (int column = 0; column < GEO_COLUMN_COUNT; column++)
+			{
+				if (table->hasColumn((GeometryColumn)column))
+				{
+					hash.add(table->getValue((GeometryColumn)column, row));
+				}
+			}
+		}
+	}
+	return hash.value();
+}
+
+void NodeHashes::build(TasNode* root, GeometryStore& geometry)
+{
+	m_hashes.clear();
+	m_built = true;
+	if (root == nullptr) return;
+
+	// iterative post-order: a node is hashed when the walk comes back to it, after its children.
+	// A side is hashed from its face table, its Face nodes are neither created nor visited
+	std::vector<std::pair<TasNode*, bool>> stack;
+	stack.push_back({ root, false });
+	while (!stack.empty())
+	{
+		TasNode* node = stack.back().first;
+		bool childrenDone = stack.back().second;
+		stack.pop_back();
+		FaceTable* faces = node->getFaceTable();
+		if (faces != nullptr)
+		{
+			Hashes hashes;
+			hashes.content = contentHash(node, geometry);
+			HashBuilder subtree;
+			subtree.add(hashes.content);
+			subtree.add((uint64_t)faces->size());
+			for (int row = 0; row < faces->size(); row++)
+			{
+				subtree.add(leafSubtreeHash(faceRowHash(*faces, row)));
+			}
+			hashes.subtree = subtree.value();
+			m_hashes[node] = hashes;
+			continue;
+		}
+		std::vector<TasNode*>& children = node->children();
+		if (!childrenDone)
+		{
+			stack.push_back({ node, true });
+			for (auto it = children.rbegin(); it != children.rend(); ++it)
+			{
+				if (*it != nullptr) stack.push_back({ *it, false });
+			}
+			continue;
+		}
+
+		Hashes hashes;
+		hashes.content = contentHash(node, geometry);
+		HashBuilder subtree;
+		subtree.add(hashes.content);
+		subtree.add((uint64_t)children.size());
+		for (TasNode* child : children)
+		{
+			if (child != nullptr) subtree.add(m_hashes[child].subtree);
+		}
+		hashes.subtree = subtree.value();
+		m_hashes[node] = hashes;
+	}
+}
+
+bool NodeHashes::find(TasNode* node, Hashes& hashes) const
+{
+	auto it = m_hashes.find(node);
+	if (it != m_hashes.end())
+	{
+		hashes = it->second;
+		return true;
+	}
+	// the Face nodes materialized after the build, a face only depends on its own fields
+	if (node == nullptr || node->getNodeType() != FACE) return false;
+	Face* face = static_cast<Face*>(node);
+	hashes.content = faceHash(face->name, face->label, face->classType, face->description,
+		face->nrf_network_node, face->nrf_model);
+	hashes.subtree = leafSubtreeHash(hashes.content);
+	return true;
+}
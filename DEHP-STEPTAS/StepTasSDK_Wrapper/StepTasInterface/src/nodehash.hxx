@@ -0,0 +1,93 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodehash.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// Node hashes
+// 64 bit content and subtree (Merkle) hashes of the node tree. The content hash covers what a node shows:
+// its strings, the bounded surface sides and materials (by name, Step ids differ between revisions), the
+// primitive geometry and the face network nodes. Ids are left out. The subtree hash combines the content hash
+// with the subtree hashes of the children in order, so two equal subtree hashes mean two identical subtrees.
+// A side is hashed from the rows of its face table as if its Face nodes existed, hashing does not create them.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include "interface.hxx"
+#include "geometrystore.hxx"
+#include "facetable.hxx"
+
+// FNV-1a
+class HashBuilder
+{
+public:
+	void add(const void* data, size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			m_hash = (m_hash ^ bytes[i]) * 1099511628211ull;
+		}
+	}
+	void add(const std::string& value)
+	{
+		add(value.data(), value.size());
+		add((uint64_t)value.size()); // "ab","c" and "a","bc" differ
+	}
+	void add(uint64_t value) { add(&value, sizeof(value)); }
+	void add(double value)
+	{
+		if (value == 0.0) value = 0.0; // -0.0 and 0.0 hash the same
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		add(bits);
+	}
+	uint64_t value() const { return m_hash; }
+
+private:
+	uint64_t m_hash = 14695981039346656037ull;
+};
+
+class NodeHashes
+{
+public:
+	struct Hashes
+	{
+		uint64_t content;
+		uint64_t subtree;
+	};
+
+	// the geometry store provides the primitive values
+	void build(sti::TasNode* root, sti::GeometryStore& geometry);
+	bool isBuilt() const { return m_built; }
+	// false for a node that is not in the tree. The faces are not hashed by build, a Face node is
+	// hashed when asked for
+	bool find(sti::TasNode* node, Hashes& hashes) const;
+
+private:
+	static uint64_t contentHash(sti::TasNode* node, sti::GeometryStore& geometry);
+	static uint64_t faceRowHash(sti::FaceTable& table, int row);
+
+	std::unordered_map<const sti::TasNode*, Hashes> m_hashes;
+	bool m_built = false;
+};
@@ -0,0 +1,126 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodeindex.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <utility>
+#include <vector>
+
+#include "nodeindex.hxx"
+
+using namespace sti;
+
+void NodeIndex::build(TasNode* root)
+{
+	clear();
+	m_root = root;
+	if (root == nullptr) return;
+
+	// iterative pre-order, each entry carries the nearest named ancestor
+	std::vector<std::pair<TasNode*, const TasNode*>> stack;
+	stack.push_back({ root, nullptr });
+	while (!stack.empty())
+	{
+		TasNode* node = stack.back().first;
+		const TasNode* namedParent = stack.back().second;
+		stack.pop_back();
+
+		m_ids.emplace(node->id, Target{ node, -1 });
+		const TasNode* scope = namedParent;
+		if (node == root)
+		{
+			scope = root;
+		}
+		else if (!node->name.empty())
+		{
+			m_children.emplace(ChildKey{ namedParent, node->name.str() }, Target{ node, -1 });
+			scope = node;
+		}
+
+		FaceTable* faces = node->getFaceTable();
+		if (faces != nullptr && node->pendingExpansion != nullptr)
+		{
+			addFaces(node, *faces);
+			continue;
+		}
+
+		std::vector<TasNode*>& children = node->children();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			if (*it != nullptr) stack.push_back({ *it, scope });
+		}
+	}
+	m_built = true;
+}
+
+// The sides are named, so they are the path scope of their faces.
+//
+void NodeIndex::addFaces(TasNode* side, FaceTable& faces)
+{
+	for (int face = 0; face < faces.size(); face++)
+	{
+		m_ids.emplace(faces.getFaceId(face), Target{ side, face });
+		const std::string& name = faces.text(faces.getNetworkNodeId(face));
+		if (!name.empty())
+		{
+			m_children.emplace(ChildKey{ side, name }, Target{ side, face });
+		}
+	}
+}
+
+TasNode* NodeIndex::resolve(const Target& target)
+{
+	if (target.face < 0) return target.node;
+	std::vector<TasNode*>& faces = target.node->children();
+	return target.face < (int)faces.size() ? faces[target.face] : nullptr;
+}
+
+void NodeIndex::clear()
+{
+	m_root = nullptr;
+	m_built = false;
+	m_ids.clear();
+	m_children.clear();
+}
+
+TasNode* NodeIndex::findById(long id) const
+{
+	auto it = m_ids.find(id);
+	return it == m_ids.end() ? nullptr : resolve(it->second);
+}
+
+TasNode* NodeIndex::resolvePath(std::string_view path) const
+{
+	const TasNode* scope = m_root;
+	TasNode* node = nullptr;
+	while (!path.empty())
+	{
+		size_t separator = path.find('/');
+		std::string_view name = path.substr(0, separator);
+		path = (separator == std::string_view::npos) ? std::string_view() : path.substr(separator + 1);
+		if (name.empty()) continue;
+
+		auto it = m_children.find(ChildKey{ scope, name });
+		if (it == m_children.end()) return nullptr;
+		node = resolve(it->second);
+		scope = node;
+	}
+	return node;
+}
@@ -0,0 +1,76 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodeindex.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// Node lookup index
+// Hash indexes over the node tree, built once after the tree: Step id -> node and (named parent, name) -> node.
+// Nodes without a name are transparent for paths, as in the paths shown by the adapter, so "a/b/c" goes from
+// the root through the named nodes only. When several nodes share an id or a path the first one in pre-order wins.
+// The keys point into the node names, which live in the arena (and the string pool) as long as the tree.
+// The faces of a side that were not created yet are indexed by their row in the face table; looking one
+// up creates the Face nodes of that side.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <string_view>
+#include <unordered_map>
+#include "interface.hxx"
+
+class NodeIndex
+{
+public:
+	void build(sti::TasNode* root);
+	void clear();
+	bool isBuilt() const { return m_built; }
+
+	sti::TasNode* findById(long id) const;
+	// '/' separated names from the root, empty components are ignored
+	sti::TasNode* resolvePath(std::string_view path) const;
+
+private:
+	struct ChildKey
+	{
+		const sti::TasNode* parent;
+		std::string_view name;
+		bool operator==(const ChildKey& other) const { return parent == other.parent && name == other.name; }
+	};
+	struct ChildKeyHash
+	{
+		size_t operator()(const ChildKey& key) const
+		{
+			return std::hash<std::string_view>()(key.name) ^ (std::hash<const void*>()(key.parent) * 31);
+		}
+	};
+
+	// a node, or the row face of the face table of the side node
+	struct Target
+	{
+		sti::TasNode* node;
+		int face;
+	};
+	static sti::TasNode* resolve(const Target& target);
+	void addFaces(sti::TasNode* side, sti::FaceTable& faces);
+
+	sti::TasNode* m_root = nullptr;
+	bool m_built = false;
+	std::unordered_map<long, Target> m_ids;
+	std::unordered_map<ChildKey, Target, ChildKeyHash> m_children;
+};
@@ -0,0 +1,219 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodetable.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+#include <cstring>
+#include <utility>
+
+#include "interface.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// node strings come from toLatin1(), the blob is UTF-8
+	void appendUtf8(std::string& blob, const std::string& latin)
+	{
+		for (unsigned char c : latin)
+		{
+			if (c < 0x80)
+			{
+				blob.push_back(c);
+			}
+			else
+			{
+				blob.push_back(static_cast<char>(0xC0 | (c >> 6)));
+				blob.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+			}
+		}
+	}
+
+	template <class T>
+	void copyColumn(const std::vector<T>& column, T* buffer)
+	{
+		if (buffer != nullptr && !column.empty())
+		{
+			std::memcpy(buffer, column.data(), column.size() * sizeof(T));
+		}
+	}
+}
+
+void NodeTable::build(TasNode* root)
+{
+	m_nodes.clear();
+	m_face_rows.clear();
+	m_ids.clear();
+	m_parents.clear();
+	m_types.clear();
+	m_status.clear();
+	m_offsets.clear();
+	m_blob.clear();
+	if (root == nullptr) return;
+
+	// pre-order walk, children pushed in reverse so they come out in order
+	std::vector<std::pair<TasNode*, int>> stack;
+	stack.push_back({ root, -1 });
+	while (!stack.empty())
+	{
+		TasNode* node = stack.back().first;
+		int parent = stack.back().second;
+		stack.pop_back();
+
+		int row = (int)m_nodes.size();
+		m_nodes.push_back(node);
+		m_face_rows.push_back(-1);
+		m_ids.push_back(node->id);
+		m_parents.push_back(parent);
+		m_types.push_back(node->getNodeType());
+		m_status.push_back(node->status);
+
+		const std::string* fields[FIELD_COUNT] = { &node->name.str(), &node->label.str(), &node->classType.str(), &node->description.str() };
+		for (const std::string* field : fields)
+		{
+			m_offsets.push_back((int)m_blob.size());
+			appendUtf8(m_blob, *field);
+		}
+
+		// faces not created yet are read from the face table of their side
+		FaceTable* faces = node->getFaceTable();
+		if (faces != nullptr && node->pendingExpansion != nullptr)
+		{
+			addFaceRows(static_cast<Side*>(node), *faces, row);
+			continue;
+		}
+
+		// children() reads the pending levels of a lazily loaded file, the table always covers the whole tree
+		std::vector<TasNode*>& children = node->children();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			stack.push_back({ *it, row });
+		}
+	}
+	m_offsets.push_back((int)m_blob.size());
+}
+
+// Same values as the Face nodes materializeFaces creates.
+//
+void NodeTable::addFaceRows(Side* side, FaceTable& faces, int parent)
+{
+	static const std::string nodeOnFace = "Node on Face";
+	static const std::string empty;
+	for (int face = 0; face < faces.size(); face++)
+	{
+		m_nodes.push_back(side);
+		m_face_rows.push_back(face);
+		m_ids.push_back(faces.getFaceId(face));
+		m_parents.push_back(parent);
+		m_types.push_back(FACE);
+		m_status.push_back(side->faceStatus());
+
+		const std::string& name = faces.text(faces.getNetworkNodeId(face));
+		const std::string& classType = faces.text(faces.getClassTypeId(face));
+		const std::string* fields[FIELD_COUNT] = { &name, faces.hasNetworkNode(face) ? &nodeOnFace : &empty, &classType, &empty };
+		for (const std::string* field : fields)
+		{
+			m_offsets.push_back((int)m_blob.size());
+			appendUtf8(m_blob, *field);
+		}
+	}
+}
+
+// The face rows take the status of their Face node once it exists, that of their side before.
+//
+void NodeTable::refreshStatus()
+{
+	for (size_t row = 0; row < m_nodes.size(); row++)
+	{
+		TasNode* node = m_nodes[row];
+		int face = m_face_rows[row];
+		if (face < 0)
+		{
+			m_status[row] = node->status;
+		}
+		else if (face < (int)node->Children.size())
+		{
+			m_status[row] = node->Children[face]->status;
+		}
+		else
+		{
+			m_status[row] = static_cast<Side*>(node)->faceStatus();
+		}
+	}
+}
+
+int NodeTable::size()
+{
+	return (int)m_nodes.size();
+}
+
+int NodeTable::blobSize()
+{
+	return (int)m_blob.size();
+}
+
+void NodeTable::copyIds(long* ids)
+{
+	copyColumn(m_ids, ids);
+}
+
+void NodeTable::copyParents(int* parents)
+{
+	copyColumn(m_parents, parents);
+}
+
+void NodeTable::copyNodeTypes(int* types)
+{
+	copyColumn(m_types, types);
+}
+
+void NodeTable::copyStatus(int* status)
+{
+	copyColumn(m_status, status);
+}
+
+void NodeTable::copyStringOffsets(int* offsets)
+{
+	copyColumn(m_offsets, offsets);
+}
+
+void NodeTable::copyBlob(unsigned char* blob)
+{
+	if (blob != nullptr && !m_blob.empty())
+	{
+		std::memcpy(blob, m_blob.data(), m_blob.size());
+	}
+}
+
+TasNode* NodeTable::getNode(int row)
+{
+	if (row < 0 || row >= (int)m_nodes.size())
+	{
+		return nullptr;
+	}
+	if (m_face_rows[row] >= 0)
+	{
+		// creates the Face nodes of the side
+		std::vector<TasNode*>& faces = m_nodes[row]->children();
+		return m_face_rows[row] < (int)faces.size() ? faces[m_face_rows[row]] : nullptr;
+	}
+	return m_nodes[row];
+}
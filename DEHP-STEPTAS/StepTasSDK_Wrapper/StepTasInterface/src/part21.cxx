@@ -0,0 +1,467 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="part21.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "part21.hxx"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define P21_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define P21_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	// one header entity parameter: a string or token, or a list of them
+	struct Parameter
+	{
+		std::string text;
+		std::vector<Parameter> items;
+	};
+
+	void appendUTF8(std::string& out, unsigned long code)
+	{
+		if (code < 0x80)
+		{
+			out += (char)code;
+		}
+		else if (code < 0x800)
+		{
+			out += (char)(0xC0 | (code >> 6));
+			out += (char)(0x80 | (code & 0x3F));
+		}
+		else if (code < 0x10000)
+		{
+			out += (char)(0xE0 | (code >> 12));
+			out += (char)(0x80 | ((code >> 6) & 0x3F));
+			out += (char)(0x80 | (code & 0x3F));
+		}
+		else
+		{
+			out += (char)(0xF0 | (code >> 18));
+			out += (char)(0x80 | ((code >> 12) & 0x3F));
+			out += (char)(0x80 | ((code >> 6) & 0x3F));
+			out += (char)(0x80 | (code & 0x3F));
+		}
+	}
+
+	int hexValue(char c)
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		return -1;
+	}
+
+	class HeaderParser
+	{
+	public:
+		HeaderParser(const char* begin, const char* end) : m_pos(begin), m_end(end) {}
+
+		// white space and /* */ comments
+		void skipSpace()
+		{
+			while (m_pos < m_end)
+			{
+				if (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\r' || *m_pos == '\n')
+				{
+					m_pos++;
+				}
+				else if (*m_pos == '/' && m_pos + 1 < m_end && m_pos[1] == '*')
+				{
+					m_pos += 2;
+					while (m_pos + 1 < m_end && !(m_pos[0] == '*' && m_pos[1] == '/')) m_pos++;
+					m_pos += 2;
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		bool expect(char c)
+		{
+			skipSpace();
+			if (m_pos >= m_end || *m_pos != c) return false;
+			m_pos++;
+			return true;
+		}
+
+		// keywords, enumerations, numbers and entity references
+		std::string token()
+		{
+			skipSpace();
+			const char* start = m_pos;
+			while (m_pos < m_end)
+			{
+				char c = *m_pos;
+				if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')
+					|| c == '_' || c == '-' || c == '+' || c == '.' || c == '!' || c == '#')
+				{
+					m_pos++;
+				}
+				else
+				{
+					break;
+				}
+			}
+			return std::string(start, m_pos);
+		}
+
+		bool parameter(Parameter& out)
+		{
+			skipSpace();
+			if (m_pos >= m_end) return false;
+			char c = *m_pos;
+			if (c == '\'')
+			{
+				return quoted(out.text);
+			}
+			if (c == '(')
+			{
+				return list(out.items);
+			}
+			if (c == '$' || c == '*')
+			{
+				m_pos++;
+				return true;
+			}
+			out.text = token();
+			if (out.text.empty()) return false;
+			// typed parameter, e.g. LABEL('x')
+			skipSpace();
+			if (m_pos < m_end && *m_pos == '(') return list(out.items);
+			return true;
+		}
+
+		bool list(std::vector<Parameter>& items)
+		{
+			if (!expect('(')) return false;
+			if (expect(')')) return true;
+			do
+			{
+				items.emplace_back();
+				if (!parameter(items.back())) return false;
+			} while (expect(','));
+			return expect(')');
+		}
+
+		const char* position() const { return m_pos; }
+
+	private:
+		// quoted string with the Part 21 escapes decoded to UTF-8, line breaks are not part of the value
+		bool quoted(std::string& out)
+		{
+			m_pos++;
+			while (m_pos < m_end)
+			{
+				char c = *m_pos++;
+				if (c == '\'')
+				{
+					if (m_pos < m_end && *m_pos == '\'')
+					{
+						out += '\'';
+						m_pos++;
+						continue;
+					}
+					return true;
+				}
+				if (c == '\r' || c == '\n') continue;
+				if (c == '\\')
+				{
+					escape(out);
+					continue;
+				}
+				out += c;
+			}
+			return false;
+		}
+
+		void escape(std::string& out)
+		{
+			size_t left = m_end - m_pos;
+			if (left >= 1 && m_pos[0] == '\\')
+			{
+				out += '\\';
+				m_pos++;
+			}
+			else if (left >= 3 && m_pos[0] == 'S' && m_pos[1] == '\\')
+			{
+				// \S\c : c + 128 in the ISO 8859 page, latin-1 by default
+				appendUTF8(out, (unsigned char)m_pos[2] + 128);
+				m_pos += 3;
+			}
+			else if (left >= 4 && m_pos[0] == 'P' && m_pos[2] == '\\')
+			{
+				// \P?\ code page switch, ignored
+				m_pos += 3;
+			}
+			else if (left >= 4 && m_pos[0] == 'X' && m_pos[1] == '\\' && hexValue(m_pos[2]) >= 0 && hexValue(m_pos[3]) >= 0)
+			{
+				appendUTF8(out, hexValue(m_pos[2]) * 16 + hexValue(m_pos[3]));
+				m_pos += 4;
+			}
+			else if (left >= 3 && m_pos[0] == 'X' && (m_pos[1] == '2' || m_pos[1] == '4') && m_pos[2] == '\\')
+			{
+				// \X2\ UTF-16 or \X4\ UCS-4 code units until \X0\ .
+				int digits = (m_pos[1] == '2') ? 4 : 8;
+				m_pos += 3;
+				unsigned long high = 0;
+				while (m_pos + digits <= m_end && *m_pos != '\\')
+				{
+					unsigned long code = 0;
+					for (int i = 0; i < digits; i++)
+					{
+						int value = hexValue(m_pos[i]);
+						if (value < 0) return;
+						code = code * 16 + value;
+					}
+					m_pos += digits;
+					if (code >= 0xD800 && code < 0xDC00)
+					{
+						high = code;
+						continue;
+					}
+					if (code >= 0xDC00 && code < 0xE000 && high != 0)
+					{
+						code = 0x10000 + ((high - 0xD800) << 10) + (code - 0xDC00);
+					}
+					high = 0;
+					appendUTF8(out, code);
+				}
+				if (m_end - m_pos >= 4 && m_pos[1] == 'X' && m_pos[2] == '0' && m_pos[3] == '\\') m_pos += 4;
+			}
+			else
+			{
+				out += '\\';
+			}
+		}
+
+		const char* m_pos;
+		const char* m_end;
+	};
+
+	inline unsigned lowestBit(uint32_t mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return (unsigned)index;
+#else
+		return (unsigned)__builtin_ctz(mask);
+#endif
+	}
+
+	// calls visit(position) for every '=' of the buffer, the vector paths only test one bit per match
+	template <class Visit>
+	void forEachEquals(const char* data, size_t size, Visit visit)
+	{
+		size_t pos = 0;
+#if defined(P21_AVX2)
+		const __m256i equals = _mm256_set1_epi8('=');
+		for (; pos + 32 <= size; pos += 32)
+		{
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+			uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, equals));
+			for (; mask != 0; mask &= mask - 1) visit(pos + lowestBit(mask));
+		}
+#elif defined(P21_SSE2)
+		const __m128i equals = _mm_set1_epi8('=');
+		for (; pos + 16 <= size; pos += 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+			uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, equals));
+			for (; mask != 0; mask &= mask - 1) visit(pos + lowestBit(mask));
+		}
+#endif
+		for (; pos < size; pos++)
+		{
+			if (data[pos] == '=') visit(pos);
+		}
+	}
+
+	inline bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	inline bool isDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	inline bool isNameChar(char c)
+	{
+		return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || isDigit(c) || c == '_';
+	}
+
+	// same layout as FlatVector in fileinterface.cxx
+	std::string flatten(const Parameter& parameter)
+	{
+		if (parameter.items.empty()) return parameter.text.empty() ? std::string() : parameter.text + '\n';
+		std::string os;
+		for (const Parameter& item : parameter.items)
+		{
+			os += item.text + '\n';
+		}
+		return os;
+	}
+
+	const std::string& text(const std::vector<Parameter>& parameters, size_t index)
+	{
+		static const std::string empty;
+		return index < parameters.size() ? parameters[index].text : empty;
+	}
+
+	std::string flatten(const std::vector<Parameter>& parameters, size_t index)
+	{
+		return index < parameters.size() ? flatten(parameters[index]) : std::string();
+	}
+
+	// the HEADER section, the parser is left after its ENDSEC;
+	bool readHeaderSection(HeaderParser& parser, sti::FileHeader& header)
+	{
+		if (parser.token() != "ISO-10303-21" || !parser.expect(';')) return false;
+		if (parser.token() != "HEADER" || !parser.expect(';')) return false;
+
+		for (;;)
+		{
+			std::string entity = parser.token();
+			if (entity.empty()) return false;
+			if (entity == "ENDSEC") return parser.expect(';');
+
+			std::vector<Parameter> parameters;
+			if (!parser.list(parameters) || !parser.expect(';')) return false;
+
+			if (entity == "FILE_DESCRIPTION")
+			{
+				header.description = flatten(parameters, 0);
+			}
+			else if (entity == "FILE_NAME")
+			{
+				header.name = text(parameters, 0);
+				header.timeStamp = text(parameters, 1);
+				header.author = flatten(parameters, 2);
+				header.organization = flatten(parameters, 3);
+				header.preprocessorVersion = text(parameters, 4);
+				header.originatingSystem = text(parameters, 5);
+				header.authorization = text(parameters, 6);
+			}
+			else if (entity == "FILE_SCHEMA")
+			{
+				header.schema = flatten(parameters, 0);
+			}
+		}
+	}
+
+	// Start of the DATA section, after the tokenized header so a "DATA;" quoted in a header string is
+	// not taken for it. A header the parser rejects falls back to the first "DATA;" of the file.
+	size_t dataSectionStart(std::string_view text)
+	{
+		HeaderParser parser(text.data(), text.data() + text.size());
+		sti::FileHeader header;
+		if (!readHeaderSection(parser, header)) return text.find("DATA;");
+		size_t headerEnd = parser.position() - text.data();
+		parser.skipSpace();
+		const char* data = parser.position();
+		std::vector<Parameter> parameters;
+		// DATA; or the named DATA('name', (schema)); of the third edition
+		if (parser.token() == "DATA" && (parser.expect(';') || (parser.list(parameters) && parser.expect(';'))))
+		{
+			return data - text.data();
+		}
+		// other sections (ANCHOR, REFERENCE) come before
+		return text.find("DATA", headerEnd);
+	}
+}
+
+bool readPart21Header(const unsigned char* data, size_t size, sti::FileHeader& header)
+{
+	HeaderParser parser(reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + size);
+	return readHeaderSection(parser, header);
+}
+
+// An '=' starts an instance when it follows ';' #digits and is followed by a type name and '(', or directly
+// by '(' for a complex instance. References (#12,) and '=' inside string values do not match, short of a
+// string holding a whole "; #12=TYPE(" instance start.
+//
+bool scanPart21Entities(const unsigned char* data, size_t size, sti::FileStatistics& statistics)
+{
+	statistics.reset((long long)size);
+	std::string_view text(reinterpret_cast<const char*>(data), size);
+	size_t start = dataSectionStart(text);
+	if (start == std::string_view::npos) return false;
+	const char* begin = text.data() + start;
+	const char* end = text.data() + size;
+
+	// keyed by views into the image, nothing is allocated per instance
+	std::unordered_map<std::string_view, int> counts;
+	int complex = 0;
+	forEachEquals(begin, end - begin, [&](size_t offset)
+		{
+			const char* equals = begin + offset;
+			const char* p = equals;
+			while (p > begin && isSpace(p[-1])) p--;
+			const char* digits = p;
+			while (p > begin && isDigit(p[-1])) p--;
+			if (p == digits || p == begin || p[-1] != '#') return;
+			// an instance follows the ';' of the previous one (or of DATA;), or the end of a comment
+			p--;
+			while (p > begin && isSpace(p[-1])) p--;
+			if (p == begin || (p[-1] != ';' && p[-1] != '/')) return;
+
+			p = equals + 1;
+			while (p < end && isSpace(*p)) p++;
+			if (p < end && *p == '(')
+			{
+				complex++;
+				return;
+			}
+			const char* name = p;
+			while (p < end && isNameChar(*p)) p++;
+			if (p == name) return;
+			const char* nameEnd = p;
+			while (p < end && isSpace(*p)) p++;
+			if (p == end || *p != '(') return;
+			counts[std::string_view(name, nameEnd - name)]++;
+		});
+
+	std::vector<std::pair<std::string_view, int>> types(counts.begin(), counts.end());
+	std::sort(types.begin(), types.end());
+	for (auto& type : types)
+	{
+		statistics.add(type.first, type.second);
+	}
+	statistics.addComplex(complex);
+	return true;
+}
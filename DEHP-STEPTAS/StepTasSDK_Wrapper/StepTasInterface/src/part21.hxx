@@ -0,0 +1,42 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="part21.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Part 21 text helpers
+// Direct reads of an ISO 10303-21 file image, used where going through the SDK would mean loading
+// the whole dataset.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <cstddef>
+#include "interface.hxx"
+#include "filestatistics.hxx"
+
+// Fills the header from the HEADER; ... ENDSEC; section only, the DATA section is never touched.
+// The fields are set as processDataSet sets them: list attributes are flattened one item per line.
+// false when the section is missing or malformed, the fields read so far are kept.
+bool readPart21Header(const unsigned char* data, size_t size, sti::FileHeader& header);
+
+// Counts the instances of the DATA section per entity type in one pass over the image. The instance
+// boundaries (#id=TYPE( ) are found from the '=' signs, located 32 (AVX2) or 16 (SSE2) bytes at a time.
+// false when there is no DATA section.
+bool scanPart21Entities(const unsigned char* data, size_t size, sti::FileStatistics& statistics);
@@ -0,0 +1,705 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="snapshot.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include "fileinterface.hxx"
+#include "mappedfile.hxx"
+#include "snapshot.hxx"
+
+namespace
+{
+	const uint64_t SnapshotMagic = 0x50414e5353415453ull; // "STASSNAP"
+	const uint64_t SnapshotEnd = 0x444e455353415453ull;   // "STASSEND"
+	// bump whenever the record layout or the processing that produced the tree changes
+	const uint32_t SnapshotVersion = 8;
+
+	// node record flags
+	const uint8_t SnapshotGeometry = 1; // TASNODE record built as a Geometry
+	const uint8_t SnapshotSide = 2;     // TASNODE record built as a Side, its face table follows
+
+	// word at a time, reads the file at memory bandwidth rather than byte per byte
+	uint64_t contentHash(const unsigned char* data, size_t size)
+	{
+		const uint64_t k1 = 0x9e3779b97f4a7c15ull;
+		const uint64_t k2 = 0xff51afd7ed558ccdull;
+		uint64_t h = k1 ^ size;
+		size_t pos = 0;
+		for (; pos + 8 <= size; pos += 8)
+		{
+			uint64_t word;
+			std::memcpy(&word, data + pos, 8);
+			h ^= word * k2;
+			h = ((h << 31) | (h >> 33)) * k1;
+		}
+		uint64_t tail = 0;
+		for (size_t shift = 0; pos < size; pos++, shift += 8)
+		{
+			tail |= (uint64_t)data[pos] << shift;
+		}
+		h ^= tail * k2;
+		h ^= h >> 33;
+		h *= k2;
+		h ^= h >> 33;
+		return h;
+	}
+
+	bool isSurface(NodeType type)
+	{
+		return type == BOUNDEDSURFACE || type >= RECTANGLE;
+	}
+
+	// the meshed surface a side was registered against: the outermost of the bounded surfaces above it
+	TasNode* owningSurface(TasNode* side)
+	{
+		TasNode* surface = nullptr;
+		for (TasNode* node = side->parent; node != nullptr; node = node->parent)
+		{
+			if (isSurface(node->getNodeType())) surface = node;
+			else if (surface != nullptr) break;
+		}
+		return surface;
+	}
+
+	void writePoint(SnapshotWriter& out, const Point3D& point)
+	{
+		out.pod(point.x);
+		out.pod(point.y);
+		out.pod(point.z);
+	}
+
+	Point3D readPoint(SnapshotReader& in)
+	{
+		Point3D point;
+		point.x = in.pod<double>();
+		point.y = in.pod<double>();
+		point.z = in.pod<double>();
+		return point;
+	}
+
+	// fields shared by the tree nodes and the materials, long is stored on 64 bits on every platform
+	void writeBase(SnapshotWriter& out, const TasNode* node)
+	{
+		out.pod((int64_t)node->id);
+		out.pod((int64_t)node->entity);
+		out.pod((int32_t)node->source);
+		out.pod((int32_t)node->status);
+		out.str(node->name);
+		out.str(node->label);
+		out.str(node->classType);
+		out.str(node->description);
+	}
+
+	void readBase(SnapshotReader& in, TasNode* node, StringPool& strings)
+	{
+		node->id = (long)in.pod<int64_t>();
+		node->entity = (long)in.pod<int64_t>();
+		node->source = in.pod<int32_t>();
+		node->status = (DataStatus)in.pod<int32_t>();
+		node->name = strings.intern(in.view());
+		node->label = strings.intern(in.view());
+		node->classType = strings.intern(in.view());
+		node->description = strings.intern(in.view());
+	}
+
+	// the faces are stored with their strings, the ids are only valid in the pool that produced them
+	void writeFaces(SnapshotWriter& out, Side* side)
+	{
+		FaceTable& faces = side->faces;
+		out.pod((int32_t)side->side);
+		out.pod((uint32_t)faces.size());
+		for (int row = 0; row < faces.size(); row++)
+		{
+			out.pod((int64_t)faces.getFaceId(row));
+			out.pod((uint8_t)(faces.hasNetworkNode(row) ? 1 : 0));
+			out.str(faces.text(faces.getNetworkNodeId(row)));
+			out.pod((uint8_t)(faces.getModelId(row) >= 0 ? 1 : 0));
+			out.str(faces.text(faces.getModelId(row)));
+			out.str(faces.text(faces.getClassTypeId(row)));
+		}
+	}
+
+	bool readFaces(SnapshotReader& in, Side* side, StringPool& strings, size_t limit)
+	{
+		side->side = (ActiveSide)in.pod<int32_t>();
+		uint32_t rows = in.pod<uint32_t>();
+		if (in.failed() || rows > limit) return false;
+		FaceTable& faces = side->faces;
+		faces.reserve(rows);
+		for (uint32_t row = 0; row < rows; row++)
+		{
+			long id = (long)in.pod<int64_t>();
+			bool onNode = in.pod<uint8_t>() != 0;
+			std::string_view networkNode = in.view();
+			bool named = in.pod<uint8_t>() != 0;
+			std::string_view model = in.view();
+			std::string_view classType = in.view();
+			faces.add(id, onNode ? strings.internId(networkNode) : -1, named ? strings.internId(model) : -1, strings.internId(classType));
+		}
+		return !in.failed();
+	}
+
+	// surfaces sharing a transformation share it again once read back: the matrix is written with its
+	// first user, the others only give its index. -1 when the surface is not transformed
+	void writeTransform(SnapshotWriter& out, const Transform* transform, std::unordered_map<const Transform*, int32_t>& written)
+	{
+		if (transform == nullptr)
+		{
+			out.pod((int32_t)-1);
+			return;
+		}
+		auto it = written.find(transform);
+		if (it != written.end())
+		{
+			out.pod(it->second);
+			return;
+		}
+		int32_t index = (int32_t)written.size();
+		written.emplace(transform, index);
+		out.pod(index);
+		for (double value : transform->m) out.pod(value);
+	}
+
+	bool readTransform(SnapshotReader& in, Transform*& transform, NodeArena& arena, std::vector<Transform*>& read)
+	{
+		int32_t index = in.pod<int32_t>();
+		if (index < 0)
+		{
+			transform = nullptr;
+		}
+		else if (index < (int32_t)read.size())
+		{
+			transform = read[index];
+		}
+		else if (index == (int32_t)read.size())
+		{
+			transform = arena.create<Transform>();
+			for (double& value : transform->m) value = in.pod<double>();
+			read.push_back(transform);
+		}
+		else
+		{
+			return false;
+		}
+		return !in.failed();
+	}
+
+	void writeSurface(SnapshotWriter& out, const BoundedSurface* surface)
+	{
+		out.pod((int32_t)surface->activeside);
+		out.pod((uint64_t)surface->side1_material);
+		out.str(surface->side1_material_name);
+		out.pod((uint64_t)surface->side2_material);
+		out.str(surface->side2_material_name);
+		out.pod(surface->side1_thickness);
+		out.pod(surface->side2_thickness);
+		out.pod((int32_t)surface->dir1_meshing);
+		out.pod((int32_t)surface->dir2_meshing);
+	}
+
+	void readSurface(SnapshotReader& in, BoundedSurface* surface, StringPool& strings)
+	{
+		surface->activeside = (ActiveSide)in.pod<int32_t>();
+		surface->side1_material = (StepId)in.pod<uint64_t>();
+		surface->side1_material_name = strings.intern(in.view());
+		surface->side2_material = (StepId)in.pod<uint64_t>();
+		surface->side2_material_name = strings.intern(in.view());
+		surface->side1_thickness = in.pod<double>();
+		surface->side2_thickness = in.pod<double>();
+		surface->dir1_meshing = in.pod<int32_t>();
+		surface->dir2_meshing = in.pod<int32_t>();
+	}
+
+	// primitive specific fields, in declaration order
+	void writePrimitive(SnapshotWriter& out, TasNode* node, NodeType type)
+	{
+		switch (type)
+		{
+		case RECTANGLE:
+		{
+			Rectangle* rect = static_cast<Rectangle*>(node);
+			writePoint(out, rect->P1); writePoint(out, rect->P2); writePoint(out, rect->P3);
+			break;
+		}
+		case QUADRILATERAL:
+		{
+			Quadrilateral* quad = static_cast<Quadrilateral*>(node);
+			writePoint(out, quad->P1); writePoint(out, quad->P2); writePoint(out, quad->P3); writePoint(out, quad->P4);
+			break;
+		}
+		case TRIANGLE:
+		{
+			Triangle* triangle = static_cast<Triangle*>(node);
+			writePoint(out, triangle->P1); writePoint(out, triangle->P2); writePoint(out, triangle->P3);
+			break;
+		}
+		case SPHERE:
+		{
+			Sphere* sphere = static_cast<Sphere*>(node);
+			writePoint(out, sphere->P1); writePoint(out, sphere->P2); writePoint(out, sphere->P3);
+			out.pod(sphere->Radius); out.pod(sphere->BaseTruncation); out.pod(sphere->ApexTruncation);
+			out.pod(sphere->StartAngle); out.pod(sphere->EndAngle);
+			break;
+		}
+		case CONE:
+		{
+			Cone* cone = static_cast<Cone*>(node);
+			writePoint(out, cone->P1); writePoint(out, cone->P2); writePoint(out, cone->P3);
+			out.pod(cone->Radius1); out.pod(cone->Radius2); out.pod(cone->StartAngle); out.pod(cone->EndAngle);
+			break;
+		}
+		case CYLINDER:
+		{
+			Cylinder* cylinder = static_cast<Cylinder*>(node);
+			writePoint(out, cylinder->P1); writePoint(out, cylinder->P2); writePoint(out, cylinder->P3);
+			out.pod(cylinder->Radius); out.pod(cylinder->StartAngle); out.pod(cylinder->EndAngle);
+			break;
+		}
+		case DISC:
+		{
+			Disc* disc = static_cast<Disc*>(node);
+			writePoint(out, disc->P1); writePoint(out, disc->P2); writePoint(out, disc->P3);
+			out.pod(disc->InnerRadius); out.pod(disc->OuterRadius); out.pod(disc->StartAngle); out.pod(disc->EndAngle);
+			break;
+		}
+		case PARABOLOID:
+		{
+			Paraboloid* paraboloid = static_cast<Paraboloid*>(node);
+			writePoint(out, paraboloid->P1); writePoint(out, paraboloid->P2); writePoint(out, paraboloid->P3);
+			out.pod(paraboloid->Radius); out.pod(paraboloid->ApexTruncation);
+			out.pod(paraboloid->StartAngle); out.pod(paraboloid->EndAngle);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// creates the node of the recorded type and reads its primitive fields, nullptr for an unknown type
+	TasNode* readPrimitive(SnapshotReader& in, NodeArena& arena, NodeType type)
+	{
+		switch (type)
+		{
+		case RECTANGLE:
+		{
+			Rectangle* rect = arena.create<Rectangle>();
+			rect->P1 = readPoint(in); rect->P2 = readPoint(in); rect->P3 = readPoint(in);
+			return rect;
+		}
+		case QUADRILATERAL:
+		{
+			Quadrilateral* quad = arena.create<Quadrilateral>();
+			quad->P1 = readPoint(in); quad->P2 = readPoint(in); quad->P3 = readPoint(in); quad->P4 = readPoint(in);
+			return quad;
+		}
+		case TRIANGLE:
+		{
+			Triangle* triangle = arena.create<Triangle>();
+			triangle->P1 = readPoint(in); triangle->P2 = readPoint(in); triangle->P3 = readPoint(in);
+			return triangle;
+		}
+		case SPHERE:
+		{
+			Sphere* sphere = arena.create<Sphere>();
+			sphere->P1 = readPoint(in); sphere->P2 = readPoint(in); sphere->P3 = readPoint(in);
+			sphere->Radius = in.pod<double>(); sphere->BaseTruncation = in.pod<double>(); sphere->ApexTruncation = in.pod<double>();
+			sphere->StartAngle = in.pod<double>(); sphere->EndAngle = in.pod<double>();
+			return sphere;
+		}
+		case CONE:
+		{
+			Cone* cone = arena.create<Cone>();
+			cone->P1 = readPoint(in); cone->P2 = readPoint(in); cone->P3 = readPoint(in);
+			cone->Radius1 = in.pod<double>(); cone->Radius2 = in.pod<double>();
+			cone->StartAngle = in.pod<double>(); cone->EndAngle = in.pod<double>();
+			return cone;
+		}
+		case CYLINDER:
+		{
+			Cylinder* cylinder = arena.create<Cylinder>();
+			cylinder->P1 = readPoint(in); cylinder->P2 = readPoint(in); cylinder->P3 = readPoint(in);
+			cylinder->Radius = in.pod<double>(); cylinder->StartAngle = in.pod<double>(); cylinder->EndAngle = in.pod<double>();
+			return cylinder;
+		}
+		case DISC:
+		{
+			Disc* disc = arena.create<Disc>();
+			disc->P1 = readPoint(in); disc->P2 = readPoint(in); disc->P3 = readPoint(in);
+			disc->InnerRadius = in.pod<double>(); disc->OuterRadius = in.pod<double>();
+			disc->StartAngle = in.pod<double>(); disc->EndAngle = in.pod<double>();
+			return disc;
+		}
+		case PARABOLOID:
+		{
+			Paraboloid* paraboloid = arena.create<Paraboloid>();
+			paraboloid->P1 = readPoint(in); paraboloid->P2 = readPoint(in); paraboloid->P3 = readPoint(in);
+			paraboloid->Radius = in.pod<double>(); paraboloid->ApexTruncation = in.pod<double>();
+			paraboloid->StartAngle = in.pod<double>(); paraboloid->EndAngle = in.pod<double>();
+			return paraboloid;
+		}
+		default:
+			return nullptr;
+		}
+	}
+}
+
+SnapshotKey computeSnapshotKey(const unsigned char* data, size_t size)
+{
+	SnapshotKey key;
+	key.size = size;
+	key.hash = contentHash(data, size);
+	return key;
+}
+
+std::string snapshotPath(const std::string& cacheDirectory, const SnapshotKey& key)
+{
+	char name[64];
+	std::snprintf(name, sizeof(name), "%016llx-%llx.stsnap", (unsigned long long)key.hash, (unsigned long long)key.size);
+	return (std::filesystem::path(cacheDirectory) / name).string();
+}
+
+bool SnapshotWriter::save(const std::string& path) const
+{
+	std::error_code error;
+	std::filesystem::path target(path);
+	if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), error);
+
+	std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file) return false;
+		file.write(m_buffer.data(), (std::streamsize)m_buffer.size());
+		if (!file) return false;
+	}
+	// rename does not replace an existing file on Windows
+	std::remove(path.c_str());
+	if (std::rename(temporary.c_str(), path.c_str()) != 0)
+	{
+		std::remove(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+// Layout: magic, version, source key, file header, id counter, the nodes in pre-order (each record names
+// its parent row, so the tree comes back with the same child order), the materials and the material index.
+//
+bool FileInterface::saveSnapshot(const string& path, const SnapshotKey& key)
+{
+	SnapshotWriter out;
+	out.pod(SnapshotMagic);
+	out.pod(SnapshotVersion);
+	out.pod(key.hash);
+	out.pod(key.size);
+
+	out.str(m_fh.name);
+	out.str(m_fh.timeStamp);
+	out.str(m_fh.author);
+	out.str(m_fh.organization);
+	out.str(m_fh.preprocessorVersion);
+	out.str(m_fh.originatingSystem);
+	out.str(m_fh.description);
+	out.str(m_fh.authorization);
+	out.str(m_fh.schema);
+	out.pod((int32_t)owncounter);
+
+	std::vector<TasNode*> nodes;
+	std::unordered_map<const TasNode*, int32_t> rows;
+	std::vector<TasNode*> stack;
+	if (m_rootnode != nullptr) stack.push_back(m_rootnode);
+	while (!stack.empty())
+	{
+		TasNode* node = stack.back();
+		stack.pop_back();
+		rows.emplace(node, (int32_t)nodes.size());
+		nodes.push_back(node);
+		// the faces are recreated from the face table
+		if (node->getFaceTable() != nullptr) continue;
+		std::vector<TasNode*>& children = node->children();
+		for (auto it = children.rbegin(); it != children.rend(); ++it) stack.push_back(*it);
+	}
+
+	std::unordered_map<const Transform*, int32_t> transforms;
+	out.pod((uint32_t)nodes.size());
+	for (TasNode* node : nodes)
+	{
+		NodeType type = node->getNodeType();
+		uint8_t flags = 0;
+		if (type == TASNODE && dynamic_cast<Geometry*>(node) != nullptr) flags |= SnapshotGeometry;
+		if (node->getFaceTable() != nullptr) flags |= SnapshotSide;
+		out.pod((uint8_t)type);
+		out.pod(flags);
+		out.pod(node == m_rootnode ? (int32_t)-1 : rows.at(node->parent));
+		writeBase(out, node);
+		if (flags & SnapshotSide)
+		{
+			writeFaces(out, static_cast<Side*>(node));
+		}
+		else if (isSurface(type))
+		{
+			writeSurface(out, static_cast<BoundedSurface*>(node));
+			writeTransform(out, static_cast<BoundedSurface*>(node)->transformation, transforms);
+			writePrimitive(out, node, type);
+		}
+	}
+
+	out.pod((uint32_t)m_material_map.size());
+	for (auto& entry : m_material_map)
+	{
+		Material* material = entry.second;
+		out.pod((uint64_t)entry.first);
+		writeBase(out, material);
+		out.pod(material->massDensity);
+		out.pod(material->specificHeatCapacity);
+		out.pod(material->thermalConductivity);
+	}
+
+	int materials = m_material_index.materialCount();
+	int environments = m_material_index.environmentCount();
+	out.pod((uint32_t)materials);
+	for (int material = 0; material < materials; material++) out.str(m_material_index.getMaterialId(material));
+	out.pod((uint32_t)environments);
+	for (int environment = 0; environment < environments; environment++) out.str(m_material_index.getEnvironmentName(environment));
+	for (int material = 0; material < materials; material++)
+	{
+		for (int environment = 0; environment < environments; environment++)
+		{
+			for (int quantity = 0; quantity < MQ_COUNT; quantity++)
+			{
+				out.pod(m_material_index.getValue(material, environment, (MaterialQuantity)quantity));
+			}
+		}
+	}
+	out.pod((uint32_t)m_material_index.stepRows().size());
+	for (auto& entry : m_material_index.stepRows())
+	{
+		out.pod((int64_t)entry.first);
+		out.pod((int32_t)entry.second);
+	}
+
+	// the conductors as read, the rows are rebuilt on load
+	int networkNodes = m_conductor_graph.nodeCount();
+	out.pod((uint32_t)networkNodes);
+	for (int networkNode = 0; networkNode < networkNodes; networkNode++)
+	{
+		out.str(m_conductor_graph.getNodeModel(networkNode));
+		out.str(m_conductor_graph.getNodeName(networkNode));
+	}
+	out.pod((uint32_t)m_conductor_graph.conductorCount());
+	for (int conductor = 0; conductor < m_conductor_graph.conductorCount(); conductor++)
+	{
+		out.pod((int32_t)m_conductor_graph.getConductorFrom(conductor));
+		out.pod((int32_t)m_conductor_graph.getConductorTo(conductor));
+		out.pod(m_conductor_graph.getConductorValue(conductor));
+	}
+	out.pod(SnapshotEnd);
+
+	return out.save(path);
+}
+
+// Everything is read into local objects first: a truncated or stale snapshot leaves the FileInterface
+// untouched and the caller falls back to the SDK.
+//
+bool FileInterface::loadSnapshot(const string& path, const SnapshotKey& key)
+{
+	MappedFile file;
+	if (!file.open(path)) return false;
+	SnapshotReader in(file.data(), file.size());
+
+	if (in.pod<uint64_t>() != SnapshotMagic || in.pod<uint32_t>() != SnapshotVersion) return false;
+	if (in.pod<uint64_t>() != key.hash || in.pod<uint64_t>() != key.size) return false;
+
+	FileHeader header;
+	header.name = in.str();
+	header.timeStamp = in.str();
+	header.author = in.str();
+	header.organization = in.str();
+	header.preprocessorVersion = in.str();
+	header.originatingSystem = in.str();
+	header.description = in.str();
+	header.authorization = in.str();
+	header.schema = in.str();
+	int counter = in.pod<int32_t>();
+
+	NodeArena arena;
+	StringPool strings;
+	uint32_t count = in.pod<uint32_t>();
+	if (in.failed() || count > file.size()) return false;
+	std::vector<TasNode*> nodes;
+	nodes.reserve(count);
+	std::vector<Transform*> transforms;
+	for (uint32_t row = 0; row < count; row++)
+	{
+		NodeType type = (NodeType)in.pod<uint8_t>();
+		uint8_t flags = in.pod<uint8_t>();
+		int32_t parent = in.pod<int32_t>();
+		// only the first record is a root and a parent always comes before its children
+		if (in.failed() || (row == 0) != (parent < 0) || parent >= (int32_t)row) return false;
+
+		TasNode* node = nullptr;
+		if (type == TASNODE && (flags & SnapshotSide))
+		{
+			Side* side = arena.create<Side>();
+			readBase(in, side, strings);
+			if (!readFaces(in, side, strings, file.size())) return false;
+			// the ids are those of the local pool, which becomes m_strings
+			side->faces.setStrings(&m_strings);
+			if (side->faces.size() > 0) side->pendingExpansion = this;
+			node = side;
+		}
+		else if (type == TASNODE)
+		{
+			node = (flags & SnapshotGeometry) ? arena.create<Geometry>() : arena.create<TasNode>();
+			readBase(in, node, strings);
+		}
+		else if (type == BOUNDEDSURFACE || (type >= RECTANGLE && type <= TRIANGLE))
+		{
+			// the primitive fields come after the shared ones, read both into temporaries in file order
+			BoundedSurface fields;
+			readBase(in, &fields, strings);
+			readSurface(in, &fields, strings);
+			if (!readTransform(in, fields.transformation, arena, transforms)) return false;
+			BoundedSurface* surface = (type == BOUNDEDSURFACE)
+				? arena.create<BoundedSurface>()
+				: static_cast<BoundedSurface*>(readPrimitive(in, arena, type));
+			surface->id = fields.id;
+			surface->entity = fields.entity;
+			surface->source = fields.source;
+			surface->status = fields.status;
+			surface->name = std::move(fields.name);
+			surface->label = std::move(fields.label);
+			surface->classType = std::move(fields.classType);
+			surface->description = std::move(fields.description);
+			surface->activeside = fields.activeside;
+			surface->side1_material = fields.side1_material;
+			surface->side1_material_name = std::move(fields.side1_material_name);
+			surface->side2_material = fields.side2_material;
+			surface->side2_material_name = std::move(fields.side2_material_name);
+			surface->side1_thickness = fields.side1_thickness;
+			surface->side2_thickness = fields.side2_thickness;
+			surface->dir1_meshing = fields.dir1_meshing;
+			surface->dir2_meshing = fields.dir2_meshing;
+			surface->transformation = fields.transformation;
+			node = surface;
+		}
+		else
+		{
+			return false;
+		}
+		if (parent >= 0) nodes[parent]->addChild(node);
+		nodes.push_back(node);
+	}
+
+	unordered_map<Step::Id, Material*> materialMap;
+	uint32_t materialCount = in.pod<uint32_t>();
+	if (in.failed() || materialCount > file.size()) return false;
+	materialMap.reserve(materialCount);
+	for (uint32_t i = 0; i < materialCount; i++)
+	{
+		Step::Id id = (Step::Id)in.pod<uint64_t>();
+		Material* material = arena.create<Material>();
+		readBase(in, material, strings);
+		material->massDensity = in.pod<double>();
+		material->specificHeatCapacity = in.pod<double>();
+		material->thermalConductivity = in.pod<double>();
+		materialMap[id] = material;
+	}
+
+	std::vector<std::string> materialIds(in.pod<uint32_t>());
+	if (in.failed() || materialIds.size() > file.size()) return false;
+	for (std::string& materialId : materialIds) materialId = in.str();
+	std::vector<std::string> environmentNames(in.pod<uint32_t>());
+	if (in.failed() || environmentNames.size() > file.size()) return false;
+	for (std::string& environmentName : environmentNames) environmentName = in.str();
+	MaterialIndex materialIndex;
+	materialIndex.reset(materialIds, environmentNames);
+	for (int material = 0; material < (int)materialIds.size(); material++)
+	{
+		for (int environment = 0; environment < (int)environmentNames.size(); environment++)
+		{
+			for (int quantity = 0; quantity < MQ_COUNT; quantity++)
+			{
+				double value = in.pod<double>();
+				if (!std::isnan(value)) materialIndex.set(material, environment, (MaterialQuantity)quantity, value);
+			}
+		}
+		if (in.failed()) return false;
+	}
+	uint32_t stepRows = in.pod<uint32_t>();
+	if (in.failed() || stepRows > file.size()) return false;
+	for (uint32_t i = 0; i < stepRows; i++)
+	{
+		long stepId = (long)in.pod<int64_t>();
+		materialIndex.setStepId(stepId, in.pod<int32_t>());
+	}
+
+	ConductorGraph conductorGraph;
+	uint32_t networkNodes = in.pod<uint32_t>();
+	if (in.failed() || networkNodes > file.size()) return false;
+	for (uint32_t i = 0; i < networkNodes; i++)
+	{
+		std::string model = in.str();
+		std::string name = in.str();
+		// the nodes were written once each, a repeated key would shift the numbering
+		if (in.failed() || conductorGraph.addNode(model, name) != (int)i) return false;
+	}
+	uint32_t conductors = in.pod<uint32_t>();
+	if (in.failed() || conductors > file.size()) return false;
+	for (uint32_t i = 0; i < conductors; i++)
+	{
+		int32_t from = in.pod<int32_t>();
+		int32_t to = in.pod<int32_t>();
+		double value = in.pod<double>();
+		if (in.failed() || from < 0 || to < 0 || from >= (int32_t)networkNodes || to >= (int32_t)networkNodes) return false;
+		conductorGraph.addConductor(from, to, value);
+	}
+	if (in.pod<uint64_t>() != SnapshotEnd || in.failed()) return false;
+	conductorGraph.finalize();
+
+	m_arena.adopt(arena);
+	m_strings.swap(strings);
+	m_fh = std::move(header);
+	owncounter = counter;
+	m_rootnode = nodes.empty() ? nullptr : nodes[0];
+	m_material_map = std::move(materialMap);
+	m_material_index = std::move(materialIndex);
+	m_conductor_graph = std::move(conductorGraph);
+	// the derived stores are rebuilt in pre-order, the order the processing registered the nodes in
+	for (TasNode* node : nodes)
+	{
+		NodeType type = node->getNodeType();
+		if (type >= RECTANGLE)
+		{
+			m_geometry.addSurface(static_cast<BoundedSurface*>(node));
+		}
+		else if (node->getFaceTable() != nullptr)
+		{
+			TasNode* surface = owningSurface(node);
+			if (surface != nullptr) m_thermal_index.addFaces(static_cast<Side*>(node), surface);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,119 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="snapshot.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Snapshot cache
+// Versioned binary image of a processed file: file header, node tree and material data. It is written to
+// the cache directory after a full load, under a name made from a hash of the source file content. Opening
+// an unchanged file again maps the snapshot and rebuilds the tree from it without going through the SDK.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// identifies the source file content, the snapshot is only used when both match
+struct SnapshotKey
+{
+	uint64_t hash = 0;
+	uint64_t size = 0;
+};
+
+// hashes the whole mapped source file
+SnapshotKey computeSnapshotKey(const unsigned char* data, size_t size);
+// <cacheDirectory>/<hash>-<size>.stsnap
+std::string snapshotPath(const std::string& cacheDirectory, const SnapshotKey& key);
+
+class SnapshotWriter
+{
+public:
+	template <class T>
+	void pod(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "snapshot fields are copied byte for byte");
+		m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+	void str(const std::string& value)
+	{
+		pod((uint32_t)value.size());
+		m_buffer.append(value);
+	}
+
+	// writes next to the target and renames, a reader never sees a partial snapshot
+	bool save(const std::string& path) const;
+
+private:
+	std::string m_buffer;
+};
+
+// Bounds checked reader over the mapped snapshot. A read past the end sets failed() and returns zeros,
+// the caller checks once at the end instead of after every field.
+class SnapshotReader
+{
+public:
+	SnapshotReader(const unsigned char* data, size_t size) : m_data(data), m_size(size) {}
+
+	template <class T>
+	T pod()
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "snapshot fields are copied byte for byte");
+		T value{};
+		if (!ensure(sizeof(T))) return value;
+		std::memcpy(&value, m_data + m_pos, sizeof(T));
+		m_pos += sizeof(T);
+		return value;
+	}
+	std::string str()
+	{
+		uint32_t length = pod<uint32_t>();
+		if (!ensure(length)) return std::string();
+		std::string value(reinterpret_cast<const char*>(m_data + m_pos), length);
+		m_pos += length;
+		return value;
+	}
+	// view into the mapped snapshot, valid while it is open
+	std::string_view view()
+	{
+		uint32_t length = pod<uint32_t>();
+		if (!ensure(length)) return std::string_view();
+		std::string_view value(reinterpret_cast<const char*>(m_data + m_pos), length);
+		m_pos += length;
+		return value;
+	}
+
+	bool failed() const { return m_failed; }
+
+private:
+	bool ensure(size_t count)
+	{
+		if (m_failed || count > m_size - m_pos) m_failed = true;
+		return !m_failed;
+	}
+
+	const unsigned char* m_data;
+	size_t m_size;
+	size_t m_pos = 0;
+	bool m_failed = false;
+};
@@ -0,0 +1,696 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="spatialindex.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "spatialindex.hxx"
+#include "geometrystore.hxx"
+#include "threadpool.hxx"
+
+using namespace sti;
+
+namespace
+{
+	const int BinCount = 16;
+	const int MaxLeafSize = 4;
+	const int ParallelThreshold = 8192; // smaller subtrees are built by the task that splits them
+
+	// float bounds that still contain the double values
+	float floatDown(double value)
+	{
+		float f = (float)value;
+		return ((double)f > value) ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+	}
+
+	float floatUp(double value)
+	{
+		float f = (float)value;
+		return ((double)f < value) ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+	}
+
+	double dot(const double a[3], const double b[3])
+	{
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	}
+
+	void sub(const double a[3], const double b[3], double out[3])
+	{
+		out[0] = a[0] - b[0];
+		out[1] = a[1] - b[1];
+		out[2] = a[2] - b[2];
+	}
+
+	// squared distance from a point to a box, 0 inside
+	double boxDistance2(const float min[3], const float max[3], const double point[3])
+	{
+		double total = 0.0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double d = 0.0;
+			if (point[axis] < min[axis]) d = min[axis] - point[axis];
+			else if (point[axis] > max[axis]) d = point[axis] - max[axis];
+			total += d * d;
+		}
+		return total;
+	}
+
+	// slab test, entry distance in [0, limit) or false
+	bool rayBox(const float min[3], const float max[3], const double origin[3], const double inverse[3], double limit, double& entry)
+	{
+		double near = 0.0, far = limit;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double t1 = (min[axis] - origin[axis]) * inverse[axis];
+			double t2 = (max[axis] - origin[axis]) * inverse[axis];
+			if (t1 > t2) std::swap(t1, t2);
+			// a NaN (ray in the slab plane) keeps the current interval
+			if (t1 > near) near = t1;
+			if (t2 < far) far = t2;
+		}
+		entry = near;
+		return near <= far;
+	}
+
+	// closest point of triangle abc to p (Ericson, Real-Time Collision Detection 5.1.5)
+	double triangleDistance2(const double a[3], const double b[3], const double c[3], const double p[3])
+	{
+		double ab[3], ac[3], ap[3], closest[3];
+		sub(b, a, ab);
+		sub(c, a, ac);
+		sub(p, a, ap);
+		double d1 = dot(ab, ap), d2 = dot(ac, ap);
+		auto at = [&](const double base[3], const double* edge, double t, const double* edge2, double u) {
+			for (int axis = 0; axis < 3; axis++)
+			{
+				closest[axis] = base[axis] + (edge ? edge[axis] * t : 0.0) + (edge2 ? edge2[axis] * u : 0.0);
+			}
+		};
+		if (d1 <= 0.0 && d2 <= 0.0) at(a, nullptr, 0, nullptr, 0);
+		else
+		{
+			double bp[3];
+			sub(p, b, bp);
+			double d3 = dot(ab, bp), d4 = dot(ac, bp);
+			double cp[3];
+			sub(p, c, cp);
+			double d5 = dot(ab, cp), d6 = dot(ac, cp);
+			double vc = d1 * d4 - d3 * d2;
+			double vb = d5 * d2 - d1 * d6;
+			double va = d3 * d6 - d5 * d4;
+			if (d3 >= 0.0 && d4 <= d3) at(b, nullptr, 0, nullptr, 0);
+			else if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) at(a, ab, d1 / (d1 - d3), nullptr, 0);
+			else if (d6 >= 0.0 && d5 <= d6) at(c, nullptr, 0, nullptr, 0);
+			else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) at(a, ac, d2 / (d2 - d6), nullptr, 0);
+			else if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+			{
+				double bc[3];
+				sub(c, b, bc);
+				at(b, bc, (d4 - d3) / ((d4 - d3) + (d5 - d6)), nullptr, 0);
+			}
+			else
+			{
+				double denom = 1.0 / (va + vb + vc);
+				at(a, ab, vb * denom, ac, vc * denom);
+			}
+		}
+		double d[3];
+		sub(p, closest, d);
+		return dot(d, d);
+	}
+
+	// Moller-Trumbore, both faces
+	bool rayTriangle(const double a[3], const double b[3], const double c[3], const double origin[3], const double direction[3], double& t)
+	{
+		double e1[3], e2[3], s[3];
+		sub(b, a, e1);
+		sub(c, a, e2);
+		double p[3] = { direction[1] * e2[2] - direction[2] * e2[1], direction[2] * e2[0] - direction[0] * e2[2], direction[0] * e2[1] - direction[1] * e2[0] };
+		double det = dot(e1, p);
+		if (std::fabs(det) < 1e-300) return false;
+		double inv = 1.0 / det;
+		sub(origin, a, s);
+		double u = dot(s, p) * inv;
+		if (u < 0.0 || u > 1.0) return false;
+		double q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+		double v = dot(direction, q) * inv;
+		if (v < 0.0 || u + v > 1.0) return false;
+		t = dot(e2, q) * inv;
+		return t >= 0.0;
+	}
+}
+
+int SurfaceSet::size()
+{
+	return (int)ids.size();
+}
+
+long SurfaceSet::getSurfaceId(int i)
+{
+	return (i < 0 || i >= size()) ? 0 : ids[i];
+}
+
+void SurfaceSet::copySurfaceIds(long* values)
+{
+	if (!ids.empty() && values != nullptr)
+	{
+		std::memcpy(values, ids.data(), ids.size() * sizeof(long));
+	}
+}
+
+int SpatialIndex::surfaceCount()
+{
+	return (int)m_ids.size();
+}
+
+int SpatialIndex::nodeCount()
+{
+	return m_used.load();
+}
+
+int SpatialIndex::depth()
+{
+	return m_depth.load();
+}
+
+// The item bounds come from the model coordinates of the geometry store, every table is transformed
+// in one pass first.
+//
+void SpatialIndex::build(GeometryStore& geometry, WorkStealingPool* pool)
+{
+	m_geometry = &geometry;
+	geometry.computeWorldPoints();
+	int total = geometry.surfaceCount();
+	m_bounds.clear();
+	m_ids.clear();
+	m_types.clear();
+	m_rows.clear();
+	m_bounds.reserve(total);
+	m_ids.reserve(total);
+	m_types.reserve(total);
+	m_rows.reserve(total);
+
+	for (int type = GeometryStore::FirstPrimitive; type < GeometryStore::FirstPrimitive + GeometryStore::PrimitiveCount; type++)
+	{
+		PrimitiveTable* table = geometry.getTable((NodeType)type);
+		if (table->size() == 0) continue;
+		int points = (type == QUADRILATERAL) ? 4 : 3;
+		const double* world[12];
+		for (int column = 0; column < 3 * points; column++)
+		{
+			world[column] = table->worldColumnData((GeometryColumn)(GEO_P1X + column));
+		}
+		const double* radius1 = table->columnData(GEO_RADIUS1);
+		const double* radius2 = table->columnData(GEO_RADIUS2);
+		for (int row = 0; row < table->size(); row++)
+		{
+			double min[3], max[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = std::numeric_limits<double>::infinity();
+				max[axis] = -std::numeric_limits<double>::infinity();
+				for (int point = 0; point < points; point++)
+				{
+					double value = world[3 * point + axis][row];
+					min[axis] = std::min(min[axis], value);
+					max[axis] = std::max(max[axis], value);
+				}
+			}
+			if (type == RECTANGLE)
+			{
+				// fourth corner P2 + P3 - P1
+				for (int axis = 0; axis < 3; axis++)
+				{
+					double value = world[3 + axis][row] + world[6 + axis][row] - world[axis][row];
+					min[axis] = std::min(min[axis], value);
+					max[axis] = std::max(max[axis], value);
+				}
+			}
+			double radius = std::max(radius1 ? std::fabs(radius1[row]) : 0.0, radius2 ? std::fabs(radius2[row]) : 0.0);
+			Bounds bounds;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				bounds.min[axis] = floatDown(min[axis] - radius);
+				bounds.max[axis] = floatUp(max[axis] + radius);
+			}
+			m_bounds.push_back(bounds);
+			m_ids.push_back(table->getSurfaceId(row));
+			m_types.push_back((NodeType)type);
+			m_rows.push_back(row);
+		}
+	}
+
+	int count = (int)m_ids.size();
+	m_build.resize(count);
+	for (int item = 0; item < count; item++)
+	{
+		BuildItem& entry = m_build[item];
+		entry.bounds = m_bounds[item];
+		entry.item = item;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			entry.centroid[axis] = 0.5f * (entry.bounds.min[axis] + entry.bounds.max[axis]);
+		}
+	}
+
+	m_nodes.assign(count > 0 ? 2 * (size_t)count - 1 : 0, Node());
+	m_used = 0;
+	m_depth = 0;
+	if (count > 0)
+	{
+		m_used = 1;
+		subdivide(0, 0, count, pool, 1);
+	}
+	m_nodes.resize(m_used.load());
+	m_nodes.shrink_to_fit();
+
+	// the leaves index contiguous runs of m_build, store the items in that order
+	std::vector<long> ids(count);
+	std::vector<NodeType> types(count);
+	std::vector<int> rows(count);
+	for (int i = 0; i < count; i++)
+	{
+		const BuildItem& entry = m_build[i];
+		m_bounds[i] = entry.bounds;
+		ids[i] = m_ids[entry.item];
+		types[i] = m_types[entry.item];
+		rows[i] = m_rows[entry.item];
+	}
+	m_ids.swap(ids);
+	m_types.swap(types);
+	m_rows.swap(rows);
+	std::vector<BuildItem>().swap(m_build);
+	m_built = true;
+}
+
+// Binned SAH: the centroids are sorted into BinCount bins along the axis where they spread most, and the
+// split between two bins with the lowest (left area * left count + right area * right count) is taken.
+// The subtrees work on disjoint ranges of m_build and allocate their children with one atomic add,
+// so the right subtree of a large node runs as a task while this one builds the left.
+//
+void SpatialIndex::subdivide(int index, int first, int count, WorkStealingPool* pool, int depth)
+{
+	Node& node = m_nodes[index];
+	BuildItem* items = m_build.data() + first;
+
+	float cmin[3], cmax[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		node.min[axis] = cmin[axis] = std::numeric_limits<float>::infinity();
+		node.max[axis] = cmax[axis] = -std::numeric_limits<float>::infinity();
+	}
+	for (int i = 0; i < count; i++)
+	{
+		const BuildItem& entry = items[i];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			node.min[axis] = std::min(node.min[axis], entry.bounds.min[axis]);
+			node.max[axis] = std::max(node.max[axis], entry.bounds.max[axis]);
+			cmin[axis] = std::min(cmin[axis], entry.centroid[axis]);
+			cmax[axis] = std::max(cmax[axis], entry.centroid[axis]);
+		}
+	}
+
+	int previous = m_depth.load(std::memory_order_relaxed);
+	while (depth > previous && !m_depth.compare_exchange_weak(previous, depth)) {}
+
+	if (count <= MaxLeafSize)
+	{
+		node.leftFirst = first;
+		node.count = count;
+		return;
+	}
+
+	int axis = 0;
+	for (int a = 1; a < 3; a++)
+	{
+		if (cmax[a] - cmin[a] > cmax[axis] - cmin[axis]) axis = a;
+	}
+	float extent = cmax[axis] - cmin[axis];
+
+	int split = first + count / 2;
+	if (extent > 0.0f)
+	{
+		struct Bin
+		{
+			Bounds bounds;
+			int count;
+		};
+		Bin bins[BinCount];
+		for (Bin& bin : bins)
+		{
+			bin.count = 0;
+			for (int a = 0; a < 3; a++)
+			{
+				bin.bounds.min[a] = std::numeric_limits<float>::infinity();
+				bin.bounds.max[a] = -std::numeric_limits<float>::infinity();
+			}
+		}
+		float scale = BinCount / extent;
+		auto binOf = [&](const BuildItem& entry) {
+			int bin = (int)((entry.centroid[axis] - cmin[axis]) * scale);
+			return std::min(std::max(bin, 0), BinCount - 1);
+		};
+		for (int i = 0; i < count; i++)
+		{
+			Bin& bin = bins[binOf(items[i])];
+			const Bounds& bounds = items[i].bounds;
+			bin.count++;
+			for (int a = 0; a < 3; a++)
+			{
+				bin.bounds.min[a] = std::min(bin.bounds.min[a], bounds.min[a]);
+				bin.bounds.max[a] = std::max(bin.bounds.max[a], bounds.max[a]);
+			}
+		}
+
+		auto area = [](const Bounds& b) {
+			float dx = b.max[0] - b.min[0], dy = b.max[1] - b.min[1], dz = b.max[2] - b.min[2];
+			return (dx < 0.0f) ? 0.0f : dx * dy + dy * dz + dz * dx;
+		};
+		auto grow = [](Bounds& into, const Bounds& b) {
+			for (int a = 0; a < 3; a++)
+			{
+				into.min[a] = std::min(into.min[a], b.min[a]);
+				into.max[a] = std::max(into.max[a], b.max[a]);
+			}
+		};
+		// left sweep then right sweep over the BinCount - 1 candidate planes
+		float leftArea[BinCount - 1], rightArea[BinCount - 1];
+		int leftCount[BinCount - 1], rightCount[BinCount - 1];
+		Bounds left = bins[0].bounds, right = bins[BinCount - 1].bounds;
+		int leftSum = 0, rightSum = 0;
+		for (int i = 0; i < BinCount - 1; i++)
+		{
+			if (i > 0) grow(left, bins[i].bounds);
+			leftSum += bins[i].count;
+			leftCount[i] = leftSum;
+			leftArea[i] = area(left);
+			int j = BinCount - 1 - i;
+			if (i > 0) grow(right, bins[j].bounds);
+			rightSum += bins[j].count;
+			rightCount[j - 1] = rightSum;
+			rightArea[j - 1] = area(right);
+		}
+		float bestCost = std::numeric_limits<float>::infinity();
+		int bestPlane = -1;
+		for (int i = 0; i < BinCount - 1; i++)
+		{
+			if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+			float cost = leftArea[i] * leftCount[i] + rightArea[i] * rightCount[i];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestPlane = i;
+			}
+		}
+		if (bestPlane >= 0)
+		{
+			BuildItem* middle = std::partition(items, items + count,
+				[&](const BuildItem& entry) { return binOf(entry) <= bestPlane; });
+			split = first + (int)(middle - items);
+		}
+		else
+		{
+			// every centroid in one bin
+			std::nth_element(items, items + (split - first), items + count,
+				[&](const BuildItem& a, const BuildItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+		}
+	}
+
+	int leftCount = split - first;
+	int children = m_used.fetch_add(2);
+	node.leftFirst = children;
+	node.count = 0;
+
+	if (pool != nullptr && count >= ParallelThreshold)
+	{
+		TaskGroup group(*pool);
+		group.run([this, children, split, count, leftCount, pool, depth] {
+			subdivide(children + 1, split, count - leftCount, pool, depth + 1);
+		});
+		subdivide(children, first, leftCount, pool, depth + 1);
+		group.wait();
+	}
+	else
+	{
+		subdivide(children, first, leftCount, pool, depth + 1);
+		subdivide(children + 1, split, count - leftCount, pool, depth + 1);
+	}
+}
+
+void SpatialIndex::shapeOf(int item, Shape& shape)
+{
+	NodeType type = m_types[item];
+	PrimitiveTable* table = m_geometry->getTable(type);
+	int row = m_rows[item];
+	shape.type = type;
+	shape.pointCount = (type == QUADRILATERAL || type == RECTANGLE) ? 4 : (type == TRIANGLE) ? 3 : 0;
+	int stored = (type == QUADRILATERAL) ? 4 : 3;
+	for (int point = 0; point < stored; point++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			shape.points[point][axis] = table->getWorldValue((GeometryColumn)(GEO_P1X + 3 * point + axis), row);
+		}
+	}
+	if (type == RECTANGLE)
+	{
+		// P1 P2 P4 P3 around the rectangle, P4 = P2 + P3 - P1 stored last
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double p3 = shape.points[2][axis];
+			shape.points[2][axis] = shape.points[1][axis] + p3 - shape.points[0][axis];
+			shape.points[3][axis] = p3;
+		}
+	}
+}
+
+// exact for the planar surfaces, distance to the bounds for the curved ones
+//
+double SpatialIndex::distanceTo(int item, const double point[3])
+{
+	Shape shape;
+	shapeOf(item, shape);
+	if (shape.pointCount == 0)
+	{
+		return std::sqrt(boxDistance2(m_bounds[item].min, m_bounds[item].max, point));
+	}
+	double d2 = triangleDistance2(shape.points[0], shape.points[1], shape.points[2], point);
+	if (shape.pointCount == 4)
+	{
+		d2 = std::min(d2, triangleDistance2(shape.points[0], shape.points[2], shape.points[3], point));
+	}
+	return std::sqrt(d2);
+}
+
+bool SpatialIndex::intersect(int item, const double origin[3], const double direction[3], double& distance)
+{
+	Shape shape;
+	shapeOf(item, shape);
+	if (shape.pointCount == 0)
+	{
+		double inverse[3] = { 1.0 / direction[0], 1.0 / direction[1], 1.0 / direction[2] };
+		return rayBox(m_bounds[item].min, m_bounds[item].max, origin, inverse, std::numeric_limits<double>::infinity(), distance);
+	}
+	double t;
+	bool hit = false;
+	if (rayTriangle(shape.points[0], shape.points[1], shape.points[2], origin, direction, t))
+	{
+		distance = t;
+		hit = true;
+	}
+	if (shape.pointCount == 4 && rayTriangle(shape.points[0], shape.points[2], shape.points[3], origin, direction, t))
+	{
+		if (!hit || t < distance) distance = t;
+		hit = true;
+	}
+	return hit;
+}
+
+SurfaceSet* SpatialIndex::findInBox(double minX, double minY, double minZ, double maxX, double maxY, double maxZ)
+{
+	SurfaceSet* result = new SurfaceSet();
+	if (m_nodes.empty()) return result;
+	const float qmin[3] = { floatDown(minX), floatDown(minY), floatDown(minZ) };
+	const float qmax[3] = { floatUp(maxX), floatUp(maxY), floatUp(maxZ) };
+	auto overlaps = [&](const float min[3], const float max[3]) {
+		return min[0] <= qmax[0] && max[0] >= qmin[0] && min[1] <= qmax[1] && max[1] >= qmin[1]
+			&& min[2] <= qmax[2] && max[2] >= qmin[2];
+	};
+
+	// a pending sibling per level at most
+	std::vector<int> stack;
+	stack.reserve(m_depth.load() + 1);
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		if (!overlaps(node.min, node.max)) continue;
+		if (node.count > 0)
+		{
+			for (int item = node.leftFirst; item < node.leftFirst + node.count; item++)
+			{
+				if (overlaps(m_bounds[item].min, m_bounds[item].max)) result->ids.push_back(m_ids[item]);
+			}
+		}
+		else
+		{
+			stack.push_back(node.leftFirst + 1);
+			stack.push_back(node.leftFirst);
+		}
+	}
+	return result;
+}
+
+SurfaceSet* SpatialIndex::findNear(double x, double y, double z, double radius)
+{
+	SurfaceSet* result = new SurfaceSet();
+	if (m_nodes.empty()) return result;
+	const double point[3] = { x, y, z };
+	const double radius2 = radius * radius;
+
+	std::vector<int> stack;
+	stack.reserve(m_depth.load() + 1);
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		if (boxDistance2(node.min, node.max, point) > radius2) continue;
+		if (node.count > 0)
+		{
+			for (int item = node.leftFirst; item < node.leftFirst + node.count; item++)
+			{
+				if (boxDistance2(m_bounds[item].min, m_bounds[item].max, point) <= radius2) result->ids.push_back(m_ids[item]);
+			}
+		}
+		else
+		{
+			stack.push_back(node.leftFirst + 1);
+			stack.push_back(node.leftFirst);
+		}
+	}
+	return result;
+}
+
+// nearer child first, subtrees farther than the best distance so far are skipped
+//
+long SpatialIndex::findNearest(double x, double y, double z)
+{
+	if (m_nodes.empty()) return 0;
+	const double point[3] = { x, y, z };
+	double best = std::numeric_limits<double>::infinity();
+	long bestId = 0;
+
+	std::vector<int> stack;
+	stack.reserve(m_depth.load() + 1);
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		if (boxDistance2(node.min, node.max, point) > best * best) continue;
+		if (node.count > 0)
+		{
+			for (int item = node.leftFirst; item < node.leftFirst + node.count; item++)
+			{
+				if (boxDistance2(m_bounds[item].min, m_bounds[item].max, point) > best * best) continue;
+				double distance = distanceTo(item, point);
+				if (distance < best)
+				{
+					best = distance;
+					bestId = m_ids[item];
+				}
+			}
+		}
+		else
+		{
+			int left = node.leftFirst, right = node.leftFirst + 1;
+			double dl = boxDistance2(m_nodes[left].min, m_nodes[left].max, point);
+			double dr = boxDistance2(m_nodes[right].min, m_nodes[right].max, point);
+			if (dl <= dr) std::swap(left, right);
+			stack.push_back(left);
+			stack.push_back(right);
+		}
+	}
+	return bestId;
+}
+
+bool SpatialIndex::raycast(double originX, double originY, double originZ,
+	double directionX, double directionY, double directionZ, RayHit* hit)
+{
+	if (hit != nullptr) *hit = RayHit();
+	if (m_nodes.empty()) return false;
+	const double origin[3] = { originX, originY, originZ };
+	const double direction[3] = { directionX, directionY, directionZ };
+	const double inverse[3] = { 1.0 / directionX, 1.0 / directionY, 1.0 / directionZ };
+	double best = std::numeric_limits<double>::infinity();
+	long bestId = 0;
+
+	std::vector<int> stack;
+	stack.reserve(m_depth.load() + 1);
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		double entry;
+		if (!rayBox(node.min, node.max, origin, inverse, best, entry)) continue;
+		if (node.count > 0)
+		{
+			for (int item = node.leftFirst; item < node.leftFirst + node.count; item++)
+			{
+				double distance;
+				if (intersect(item, origin, direction, distance) && distance < best)
+				{
+					best = distance;
+					bestId = m_ids[item];
+				}
+			}
+		}
+		else
+		{
+			int left = node.leftFirst, right = node.leftFirst + 1;
+			double el, er;
+			bool hl = rayBox(m_nodes[left].min, m_nodes[left].max, origin, inverse, best, el);
+			bool hr = rayBox(m_nodes[right].min, m_nodes[right].max, origin, inverse, best, er);
+			if (hl && hr)
+			{
+				if (el <= er) std::swap(left, right);
+				stack.push_back(left);
+				stack.push_back(right);
+			}
+			else if (hl) stack.push_back(left);
+			else if (hr) stack.push_back(right);
+		}
+	}
+	if (bestId == 0) return false;
+	if (hit != nullptr)
+	{
+		hit->surfaceId = bestId;
+		hit->distance = best;
+	}
+	return true;
+}
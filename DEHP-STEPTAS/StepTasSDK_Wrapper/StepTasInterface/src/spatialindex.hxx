@@ -0,0 +1,131 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="spatialindex.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Spatial index
+// Bounding volume hierarchy over the bounded surfaces, in model coordinates. The nodes are 32 bytes and
+// stored in one array, the two children of a node next to each other; the surfaces of a leaf are
+// contiguous. It is built with binned SAH splits, the large subtrees in parallel.
+// Triangles, rectangles and quadrilaterals are tested exactly. The curved primitives are represented by
+// conservative bounds: their defining points grown by their largest radius.
+
+#include <vector>
+#ifndef SWIG
+#include <atomic>
+#endif
+#include "interface.hxx"
+
+class WorkStealingPool;
+
+namespace sti
+{
+	class GeometryStore;
+
+	// result of a query, owned by the caller
+	class SurfaceSet
+	{
+	public:
+		int size();
+		long getSurfaceId(int i);
+		// size() entries
+		void copySurfaceIds(long* ids);
+
+#ifndef SWIG
+		std::vector<long> ids;
+#endif
+	};
+
+	class RayHit
+	{
+	public:
+		RayHit() : surfaceId(0), distance(0.0) {};
+		long surfaceId; // 0 when nothing is hit
+		double distance; // along the ray, in units of its direction length
+	};
+
+	class SpatialIndex
+	{
+	public:
+		int surfaceCount();
+		int nodeCount();
+		int depth();
+
+		// surfaces whose bounds overlap the box
+		SurfaceSet* findInBox(double minX, double minY, double minZ, double maxX, double maxY, double maxZ);
+		// surfaces whose bounds are closer than radius to the point
+		SurfaceSet* findNear(double x, double y, double z, double radius);
+		// surface closest to the point, 0 when the index is empty
+		long findNearest(double x, double y, double z);
+		// first surface hit by the ray from the origin along the direction, false when none is
+		bool raycast(double originX, double originY, double originZ,
+			double directionX, double directionY, double directionZ, RayHit* hit);
+
+#ifndef SWIG
+		// pool nullptr for a serial build
+		void build(GeometryStore& geometry, WorkStealingPool* pool);
+		bool isBuilt() const { return m_built; }
+	private:
+		struct Node
+		{
+			float min[3];
+			int leftFirst; // first child for an inner node, first item for a leaf
+			float max[3];
+			int count;     // 0 for an inner node
+		};
+		struct Bounds
+		{
+			float min[3];
+			float max[3];
+		};
+		// moved around by the build partitions, so the splits read memory in order
+		struct BuildItem
+		{
+			Bounds bounds;
+			float centroid[3];
+			int item;
+		};
+		struct Shape
+		{
+			NodeType type;
+			int pointCount; // corners of a planar surface, 0 for a curved one
+			double points[4][3];
+		};
+
+		void subdivide(int node, int first, int count, WorkStealingPool* pool, int depth);
+		void shapeOf(int item, Shape& shape);
+		double distanceTo(int item, const double point[3]);
+		bool intersect(int item, const double origin[3], const double direction[3], double& distance);
+
+		GeometryStore* m_geometry = nullptr;
+		std::vector<Node> m_nodes;
+		std::vector<Bounds> m_bounds;   // by item, in leaf order once built
+		std::vector<long> m_ids;
+		std::vector<NodeType> m_types;
+		std::vector<int> m_rows;        // in the primitive table of the type
+		std::vector<BuildItem> m_build;
+		std::atomic<int> m_used{ 0 };
+		std::atomic<int> m_depth{ 0 };
+		bool m_built = false;
+#endif
+	};
+}
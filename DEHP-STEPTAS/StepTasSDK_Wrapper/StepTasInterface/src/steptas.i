@@ -1,4 +1,4 @@
-%module steptasinterface
+%module(directors="1") steptasinterface
 #%rename(opEquals) operator==;
 #%rename(opAdd) operator+;
 #%rename(opAddEquals) operator+=;
@@ -7,22 +7,203 @@
 #%rename(opNot) operator!;
 #%rename(opOr) operator||;
 %{
+#include "facetable.hxx"
 #include "interface.hxx"
+#include "transform.hxx"
+#include "spatialindex.hxx"
+#include "massproperties.hxx"
+#include "tessellation.hxx"
+#include "conductorgraph.hxx"
+#include "geometrystore.hxx"
+#include "materialindex.hxx"
+#include "thermalnodeindex.hxx"
+#include "treediff.hxx"
+#include "filestatistics.hxx"
+#include "loadstatistics.hxx"
+#include "logger.hxx"
+#include "loadjob.hxx"
+#include "fileloader.hxx"
 #include "fileinterface.hxx"
 %}
 
 
-%typemap(csout,excode=SWIGEXCODE) sti::TasNode*,TasNode,TasNode*{
+// Nodes are only returned by pointer, they live in the FileData node arena: the C# proxy never owns them.
+// Every node proxy keeps a reference on the proxy it was obtained from, so the FileData owning
+// the arena cannot be collected while a node of its tree is still reachable from C#.
+%typemap(csout,excode=SWIGEXCODE) sti::TasNode*,TasNode*{
     System.IntPtr cPtr = $imcall;
-    $csclassname ret = ($csclassname) $modulePINVOKE.InstantiateConcreteNode(cPtr, $owner);$excode
+    $csclassname ret = ($csclassname) $modulePINVOKE.InstantiateConcreteNode(cPtr, false);$excode
+    if (ret != null) ret.arenaOwner = this;
     return ret;
 }
+%typemap(cscode) sti::TasNode %{
+  internal object arenaOwner;
+%}
+
+// The header is a member of the loaded file: a non-owning proxy that keeps the FileData alive
+%typemap(csout,excode=SWIGEXCODE) const sti::FileHeader&, const FileHeader&{
+    $csclassname ret = new $csclassname($imcall, false);$excode
+    ret.dataOwner = this;
+    return ret;
+}
+%typemap(cscode) sti::FileHeader %{
+  internal object dataOwner;
+%}
+
+// The stores, indexes and tables handed out by pointer are owned by the object they come from (the FileData,
+// or a store of it): each proxy keeps that object's proxy alive, so the native object outlives every proxy.
+// Raw buffers returned as IntPtr carry no reference, they are valid while their owner's proxy is reachable
+%define OWNED_PROXY(TYPE)
+%typemap(csout,excode=SWIGEXCODE) TYPE* {
+    System.IntPtr cPtr = $imcall;
+    $csclassname ret = (cPtr == System.IntPtr.Zero) ? null : new $csclassname(cPtr, $owner);$excode
+    if (ret != null) ret.dataOwner = this;
+    return ret;
+}
+%typemap(csvarout,excode=SWIGEXCODE2) TYPE* %{
+    get {
+      System.IntPtr cPtr = $imcall;
+      $csclassname ret = (cPtr == System.IntPtr.Zero) ? null : new $csclassname(cPtr, $owner);$excode
+      if (ret != null) ret.dataOwner = this;
+      return ret;
+    } %}
+%typemap(cscode) TYPE %{
+  internal object dataOwner;
+%}
+%enddef
+OWNED_PROXY(sti::NodeTable)
+OWNED_PROXY(sti::GeometryStore)
+OWNED_PROXY(sti::PrimitiveTable)
+OWNED_PROXY(sti::Transform)
+OWNED_PROXY(sti::FaceTable)
+OWNED_PROXY(sti::MaterialIndex)
+OWNED_PROXY(sti::ThermalNodeIndex)
+OWNED_PROXY(sti::ThermalNodeSet)
+OWNED_PROXY(sti::SpatialIndex)
+OWNED_PROXY(sti::MassProperties)
+OWNED_PROXY(sti::ConductorGraph)
+OWNED_PROXY(sti::FileStatistics)
+OWNED_PROXY(sti::LoadStatistics)
+OWNED_PROXY(sti::LoadCancellation)
+
+// A node created from C# would be deleted by the garbage collector while still linked in the arena tree
+%ignore sti::TasNode::addChild;
 
 %include "arrays_csharp.i"
 %include "std_string.i"
 %include "windows.i"
 %include "std_vector.i"
+%include "attribute.i"
+
+// The node strings are interned in the file StringPool, C# keeps the former read only properties
+%attributestring(sti::TasNode, std::string, name, getName);
+%attributestring(sti::TasNode, std::string, classType, getClassType);
+%attributestring(sti::TasNode, std::string, label, getLabel);
+%attributestring(sti::TasNode, std::string, description, getDescription);
+%attributestring(sti::Face, std::string, nrf_network_node, getNetworkNode);
+%attributestring(sti::Face, std::string, nrf_model, getModel);
+%attributestring(sti::BoundedSurface, std::string, side1_material_name, getSide1MaterialName);
+%attributestring(sti::BoundedSurface, std::string, side2_material_name, getSide2MaterialName);
+
+// NodeTable columns are copied straight into pinned C# arrays
+%apply long FIXED[] { long* ids }
+%apply int FIXED[] { int* parents, int* types, int* status, int* offsets }
+%apply unsigned char FIXED[] { unsigned char* blob }
+%csmethodmodifiers sti::NodeTable::copyIds "public unsafe";
+%csmethodmodifiers sti::NodeTable::copyParents "public unsafe";
+%csmethodmodifiers sti::NodeTable::copyNodeTypes "public unsafe";
+%csmethodmodifiers sti::NodeTable::copyStatus "public unsafe";
+%csmethodmodifiers sti::NodeTable::copyStringOffsets "public unsafe";
+%csmethodmodifiers sti::NodeTable::copyBlob "public unsafe";
+%apply int FIXED[] { int* networkNodes, int* models, int* classTypes }
+%csmethodmodifiers sti::FaceTable::copyFaceIds "public unsafe";
+%csmethodmodifiers sti::FaceTable::copyNetworkNodeIds "public unsafe";
+%csmethodmodifiers sti::FaceTable::copyModelIds "public unsafe";
+%csmethodmodifiers sti::FaceTable::copyClassTypeIds "public unsafe";
+%nodefaultctor sti::FaceTable;
+
+// Geometry columns: raw pointers are handed to C# as IntPtr (zero copy), copies go to pinned arrays
+%typemap(ctype) double* DATA_POINTER, long* DATA_POINTER, float* DATA_POINTER, unsigned int* DATA_POINTER "void*"
+%typemap(imtype) double* DATA_POINTER, long* DATA_POINTER, float* DATA_POINTER, unsigned int* DATA_POINTER "System.IntPtr"
+%typemap(cstype) double* DATA_POINTER, long* DATA_POINTER, float* DATA_POINTER, unsigned int* DATA_POINTER "System.IntPtr"
+%typemap(out) double* DATA_POINTER, long* DATA_POINTER, float* DATA_POINTER, unsigned int* DATA_POINTER %{ $result = (void*)$1; %}
+%typemap(csout, excode=SWIGEXCODE) double* DATA_POINTER, long* DATA_POINTER, float* DATA_POINTER, unsigned int* DATA_POINTER {
+    System.IntPtr ret = $imcall;$excode
+    return ret;
+}
+%apply double* DATA_POINTER { double* columnData, double* worldColumnData, double* areaData, double* massData }
+%apply long* DATA_POINTER { long* indexColumnData, long* surfaceIdData }
+%apply double FIXED[] { double* values }
+%apply long FIXED[] { long* values }
+%csmethodmodifiers sti::PrimitiveTable::copyColumn "public unsafe";
+%csmethodmodifiers sti::PrimitiveTable::copyIndexColumn "public unsafe";
+%csmethodmodifiers sti::PrimitiveTable::copySurfaceIds "public unsafe";
+%csmethodmodifiers sti::PrimitiveTable::copyWorldColumn "public unsafe";
+%nodefaultctor sti::NodeTable;
+%nodefaultctor sti::PrimitiveTable;
+%nodefaultctor sti::GeometryStore;
+%csmethodmodifiers sti::MaterialIndex::copyValues "public unsafe";
+%nodefaultctor sti::MaterialIndex;
+%nodefaultctor sti::ThermalNodeIndex;
+%nodefaultctor sti::ThermalNodeSet;
+%nodefaultctor sti::FileStatistics;
+%nodefaultctor sti::LoadStatistics;
+// progress reports are implemented in C#, the FileData of a finished job belongs to the caller
+%feature("director") sti::ProgressCallback;
+// native diagnostics are forwarded to NLog, see NativeLogSink
+%feature("director") sti::LogSink;
+%nodefaultctor sti::NativeLog;
+%newobject sti::LoadJob::takeResult;
+%newobject sti::FileLoader::takeResult;
+%newobject sti::SpatialIndex::findInBox;
+%newobject sti::SpatialIndex::findNear;
+%csmethodmodifiers sti::SurfaceSet::copySurfaceIds "public unsafe";
+%nodefaultctor sti::SpatialIndex;
+%csmethodmodifiers sti::MassProperties::copyAreas "public unsafe";
+%csmethodmodifiers sti::MassProperties::copyMasses "public unsafe";
+%csmethodmodifiers sti::MassProperties::copyNodeIds "public unsafe";
+%csmethodmodifiers sti::MassProperties::copyParents "public unsafe";
+%csmethodmodifiers sti::MassProperties::copyNodeAreas "public unsafe";
+%csmethodmodifiers sti::MassProperties::copyNodeMasses "public unsafe";
+%nodefaultctor sti::MassProperties;
+// the viewer uploads the tessellation buffers straight from their native pointers
+%apply float* DATA_POINTER { float* vertexData }
+%apply unsigned int* DATA_POINTER { unsigned int* indexData }
+%apply float FIXED[] { float* vertices }
+%apply unsigned int FIXED[] { unsigned int* indices }
+%apply int FIXED[] { int* triangles, int* counts }
+%newobject sti::FileData::tessellate;
+%csmethodmodifiers sti::Tessellation::copyVertices "public unsafe";
+%csmethodmodifiers sti::Tessellation::copyIndices "public unsafe";
+%csmethodmodifiers sti::Tessellation::copySurfaceIds "public unsafe";
+%csmethodmodifiers sti::Tessellation::copyVertexOffsets "public unsafe";
+%csmethodmodifiers sti::Tessellation::copyIndexOffsets "public unsafe";
+%csmethodmodifiers sti::Tessellation::copyFaceIds "public unsafe";
+%csmethodmodifiers sti::Tessellation::copyFaceFirstTriangles "public unsafe";
+%csmethodmodifiers sti::Tessellation::copyFaceTriangleCounts "public unsafe";
+%nodefaultctor sti::Tessellation;
+%csmethodmodifiers sti::ConductorGraph::copyOffsets "public unsafe";
+%csmethodmodifiers sti::ConductorGraph::copyNeighbours "public unsafe";
+%csmethodmodifiers sti::ConductorGraph::copyValues "public unsafe";
+%apply int FIXED[] { int* neighbours }
+%nodefaultctor sti::ConductorGraph;
+
+%include "facetable.hxx"
 %include "interface.hxx"
+%include "transform.hxx"
+%include "geometrystore.hxx"
+%include "materialindex.hxx"
+%include "thermalnodeindex.hxx"
+%include "spatialindex.hxx"
+%include "massproperties.hxx"
+%include "tessellation.hxx"
+%include "conductorgraph.hxx"
+%include "treediff.hxx"
+%include "filestatistics.hxx"
+%include "loadstatistics.hxx"
+%include "logger.hxx"
+%include "loadjob.hxx"
+%include "fileloader.hxx"
 
 
 
@@ -54,6 +235,24 @@
     case NodeType.QUADRILATERAL:
         ret=new Quadrilateral(cPtr,owner);
       break;
+    case NodeType.SPHERE:
+        ret=new Sphere(cPtr,owner);
+      break;
+    case NodeType.CONE:
+        ret=new Cone(cPtr,owner);
+      break;
+    case NodeType.CYLINDER:
+        ret=new Cylinder(cPtr,owner);
+      break;
+    case NodeType.DISC:
+        ret=new Disc(cPtr,owner);
+      break;
+    case NodeType.PARABOLOID:
+        ret=new Paraboloid(cPtr,owner);
+      break;
+    case NodeType.TRIANGLE:
+        ret=new Triangle(cPtr,owner);
+      break;
     default:
         System.Diagnostics.Debug.Assert(false,
         System.String.Format("Encountered type '{0}' that is not known to be a TasNode concrete class",
@@ -0,0 +1,80 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="stringpool.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stringpool.hxx"
+
+using namespace sti;
+
+const std::string& PooledString::emptyString()
+{
+	static const std::string empty;
+	return empty;
+}
+
+StringPool::StringPool() : m_shards(new Shard[ShardCount])
+{
+}
+
+StringPool::~StringPool()
+{
+}
+
+PooledString StringPool::intern(std::string_view text)
+{
+	if (text.empty()) return PooledString();
+	return get(internId(text));
+}
+
+int StringPool::internId(std::string_view text)
+{
+	size_t shardIndex = std::hash<std::string_view>()(text) % ShardCount;
+	Shard& shard = m_shards[shardIndex];
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto found = shard.index.find(text);
+	if (found != shard.index.end()) return found->second;
+
+	int id = (int)((shard.strings.size() << ShardBits) | shardIndex);
+	shard.strings.emplace_back(text);
+	shard.index.emplace(std::string_view(shard.strings.back()), id);
+	return id;
+}
+
+PooledString StringPool::get(int id) const
+{
+	if (id < 0) return PooledString();
+	Shard& shard = m_shards[id & (ShardCount - 1)];
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	size_t position = (size_t)id >> ShardBits;
+	if (position >= shard.strings.size()) return PooledString();
+	return PooledString(&shard.strings[position]);
+}
+
+size_t StringPool::count() const
+{
+	size_t total = 0;
+	for (size_t i = 0; i < ShardCount; i++)
+	{
+		std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+		total += m_shards[i].strings.size();
+	}
+	return total;
+}
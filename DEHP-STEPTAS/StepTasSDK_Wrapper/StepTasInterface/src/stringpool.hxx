@@ -0,0 +1,103 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="stringpool.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// String interning
+// The text fields of the nodes repeat a lot: every face of a model carries the same model name, the side
+// and face labels are constants, the class types are a few dozen SDK names. Each file interns them in one
+// StringPool and the nodes keep a PooledString, one pointer to the pooled copy. The pool lives as long as
+// the FileInterface, like the node arena. Interning is thread safe, the parallel build tasks share the pool.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace sti
+{
+	class PooledString
+	{
+	public:
+		PooledString() : m_text(&emptyString()) {}
+
+		const std::string& str() const { return *m_text; }
+		operator const std::string&() const { return *m_text; }
+		const char* c_str() const { return m_text->c_str(); }
+		size_t size() const { return m_text->size(); }
+		bool empty() const { return m_text->empty(); }
+
+		// strings of one pool are equal exactly when their pointers are
+		friend bool operator==(const PooledString& a, const PooledString& b) { return a.m_text == b.m_text || *a.m_text == *b.m_text; }
+		friend bool operator!=(const PooledString& a, const PooledString& b) { return !(a == b); }
+		friend bool operator==(const PooledString& a, const std::string& b) { return *a.m_text == b; }
+		friend bool operator!=(const PooledString& a, const std::string& b) { return *a.m_text != b; }
+		friend bool operator==(const PooledString& a, const char* b) { return *a.m_text == b; }
+		friend bool operator!=(const PooledString& a, const char* b) { return *a.m_text != b; }
+		friend std::ostream& operator<<(std::ostream& out, const PooledString& text) { return out << *text.m_text; }
+
+	private:
+		friend class StringPool;
+		explicit PooledString(const std::string* text) : m_text(text) {}
+		static const std::string& emptyString();
+
+		const std::string* m_text;
+	};
+
+	class StringPool
+	{
+	public:
+		StringPool();
+		~StringPool();
+
+		StringPool(const StringPool&) = delete;
+		StringPool& operator=(const StringPool&) = delete;
+
+		PooledString intern(std::string_view text);
+		// compact handle for the columnar tables, ids stay valid as long as the pool
+		int internId(std::string_view text);
+		PooledString get(int id) const;
+
+		// the pooled strings stay where they are, so the nodes of both pools remain valid
+		void swap(StringPool& other) { m_shards.swap(other.m_shards); }
+
+		size_t count() const;
+
+	private:
+		static const int ShardBits = 4;
+		static const size_t ShardCount = 1 << ShardBits;
+
+		// the map keys view the stored strings, lookups do not allocate.
+		// An id is the position in the shard followed by the shard number
+		struct Shard
+		{
+			std::mutex mutex;
+			std::deque<std::string> strings;
+			std::unordered_map<std::string_view, int> index;
+		};
+
+		std::unique_ptr<Shard[]> m_shards;
+	};
+}
@@ -0,0 +1,173 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="tasnode.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Tree nodes
+// Members of the node classes of interface.hxx. They are kept apart from FileData, which drives the SDK,
+// so the tree, its hashes and the diff build without it.
+
+#include "interface.hxx"
+
+using namespace sti;
+
+void TasNode::addChild(TasNode* child) {
+	
+	Children.push_back(child);
+	child->parent = this;
+}
+
+std::vector<TasNode*>& TasNode::children()
+{
+	if (pendingExpansion)
+	{
+		NodeExpander* expander = pendingExpansion;
+		pendingExpansion = nullptr;
+		expander->expandNode(this);
+	}
+	return Children;
+}
+
+int TasNode::childrenCount()
+{
+	return (int)children().size();
+}
+
+TasNode* TasNode::getChildNode(int idx)
+{
+	if (idx<0 || idx>=(int)children().size()) {
+		
+		return nullptr;
+	}
+	return Children[idx];
+}
+
+TasNode* TasNode::getParent()
+{
+	return parent;
+}
+
+const std::string& TasNode::getName() const
+{
+	return name;
+}
+
+const std::string& TasNode::getClassType() const
+{
+	return classType;
+}
+
+const std::string& TasNode::getLabel() const
+{
+	return label;
+}
+
+const std::string& TasNode::getDescription() const
+{
+	return description;
+}
+
+const std::string& Face::getNetworkNode() const
+{
+	return nrf_network_node;
+}
+
+const std::string& Face::getModel() const
+{
+	return nrf_model;
+}
+
+const std::string& BoundedSurface::getSide1MaterialName() const
+{
+	return side1_material_name;
+}
+
+const std::string& BoundedSurface::getSide2MaterialName() const
+{
+	return side2_material_name;
+}
+
+
+NodeType TasNode::getNodeType()
+{
+	return TASNODE;
+};
+
+FaceTable* TasNode::getFaceTable()
+{
+	return nullptr;
+}
+
+FaceTable* Side::getFaceTable()
+{
+	return &faces;
+}
+
+NodeType Face::getNodeType()
+{
+	return FACE;
+};
+
+NodeType BoundedSurface::getNodeType()
+{
+	return BOUNDEDSURFACE;
+};
+
+NodeType Rectangle::getNodeType()
+{
+	return RECTANGLE;
+};
+
+NodeType Quadrilateral::getNodeType()
+{
+	return QUADRILATERAL;
+};
+
+NodeType Sphere::getNodeType()
+{
+	return SPHERE;
+};
+
+NodeType Cone::getNodeType()
+{
+	return CONE;
+};
+
+NodeType Cylinder::getNodeType()
+{
+	return CYLINDER;
+};
+
+NodeType Disc::getNodeType()
+{
+	return DISC;
+};
+
+NodeType Paraboloid::getNodeType()
+{
+	return PARABOLOID;
+};
+
+NodeType Triangle::getNodeType()
+{
+	return TRIANGLE;
+};
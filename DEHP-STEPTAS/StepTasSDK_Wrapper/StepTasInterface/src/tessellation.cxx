@@ -0,0 +1,537 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="tessellation.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+#include "tessellation.hxx"
+#include "geometrystore.hxx"
+#include "logger.hxx"
+#include "threadpool.hxx"
+
+using namespace sti;
+
+namespace
+{
+	struct Vec
+	{
+		double x, y, z;
+	};
+
+	Vec operator+(const Vec& a, const Vec& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+	Vec operator-(const Vec& a, const Vec& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+	Vec operator*(double s, const Vec& a) { return { s * a.x, s * a.y, s * a.z }; }
+	double dot(const Vec& a, const Vec& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	Vec cross(const Vec& a, const Vec& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+
+	// a null vector stays null
+	Vec normalized(const Vec& a)
+	{
+		double length = std::sqrt(dot(a, a));
+		return (length > 0.0) ? (1.0 / length) * a : a;
+	}
+
+	// the columns of one primitive table, the points in model coordinates
+	struct TableColumns
+	{
+		const double* point[12];
+		const double* value[GEO_COLUMN_COUNT];
+	};
+
+	struct SurfaceJob
+	{
+		NodeType type;
+		int row;
+		int cells1;
+		int cells2;
+		bool meshed; // both counts come from the file
+	};
+
+	struct SurfaceSide
+	{
+		long surfaceId;
+		FaceTable* faces;
+	};
+
+	Vec pointOf(const TableColumns& columns, int index, int row)
+	{
+		return { columns.point[3 * index][row], columns.point[3 * index + 1][row], columns.point[3 * index + 2][row] };
+	}
+
+	// Frame of a curved primitive: w along the axis P1 -> P2, e1 towards P3 (angle 0), e2 = w x e1.
+	// When P3 is on the axis any direction orthogonal to it is taken.
+	//
+	void axisFrame(const Vec& p1, const Vec& p2, const Vec& p3, Vec& w, Vec& e1, Vec& e2)
+	{
+		w = normalized(p2 - p1);
+		if (dot(w, w) == 0.0) w = { 0.0, 0.0, 1.0 };
+		Vec reference = p3 - p1;
+		e1 = reference - dot(reference, w) * w;
+		if (dot(e1, e1) <= 1e-20 * dot(reference, reference) || dot(e1, e1) == 0.0)
+		{
+			e1 = (std::fabs(w.x) < 0.9) ? Vec{ 1.0, 0.0, 0.0 } : Vec{ 0.0, 1.0, 0.0 };
+			e1 = e1 - dot(e1, w) * w;
+		}
+		e1 = normalized(e1);
+		e2 = cross(w, e1);
+	}
+
+	float* putVertex(float* out, const Vec& p, const Vec& n)
+	{
+		out[0] = (float)p.x;
+		out[1] = (float)p.y;
+		out[2] = (float)p.z;
+		out[3] = (float)n.x;
+		out[4] = (float)n.y;
+		out[5] = (float)n.z;
+		return out + Tessellation::VertexStride;
+	}
+
+	// Planar primitives as bilinear patches over their corners (u along P1 -> P2). The triangle is a
+	// patch with its P1 edge collapsed, its first column of squares has one degenerate triangle each.
+	//
+	void writePlanar(const TableColumns& columns, NodeType type, int row, int nu, int nv, float* out)
+	{
+		Vec p1 = pointOf(columns, 0, row), p2 = pointOf(columns, 1, row), p3 = pointOf(columns, 2, row);
+		Vec c00 = p1, c10 = p2, c01, c11, normal;
+		if (type == QUADRILATERAL)
+		{
+			Vec p4 = pointOf(columns, 3, row);
+			c11 = p3;
+			c01 = p4;
+			normal = normalized(cross(p3 - p1, p4 - p2));
+		}
+		else
+		{
+			c01 = (type == TRIANGLE) ? p1 : p3;
+			c11 = (type == TRIANGLE) ? p3 : p2 + p3 - p1;
+			normal = normalized(cross(p2 - p1, p3 - p1));
+		}
+		for (int b = 0; b <= nv; b++)
+		{
+			double v = (double)b / nv;
+			Vec start = c00 + v * (c01 - c00), end = c10 + v * (c11 - c10);
+			for (int a = 0; a <= nu; a++)
+			{
+				out = putVertex(out, start + ((double)a / nu) * (end - start), normal);
+			}
+		}
+	}
+
+	// Curved primitives: u is the angle from StartAngle, v goes along the axis (the radius for a disc).
+	// The normals point the way the triangles turn: away from the axis, towards -w for a disc.
+	//
+	void writeCurved(const TableColumns& columns, NodeType type, int row, int nu, int nv, float* out, std::vector<double>& trig)
+	{
+		Vec p1 = pointOf(columns, 0, row), p2 = pointOf(columns, 1, row), p3 = pointOf(columns, 2, row);
+		Vec w, e1, e2;
+		axisFrame(p1, p2, p3, w, e1, e2);
+		Vec axis = p2 - p1;
+		double height = std::sqrt(dot(axis, axis));
+		const double* const* value = columns.value;
+
+		double start = degreesToRadians(value[GEO_START_ANGLE][row]);
+		double span = angularSpan(value[GEO_START_ANGLE][row], value[GEO_END_ANGLE][row]);
+		trig.resize(2 * (size_t)(nu + 1));
+		for (int a = 0; a <= nu; a++)
+		{
+			double angle = start + span * a / nu;
+			trig[2 * a] = std::cos(angle);
+			trig[2 * a + 1] = std::sin(angle);
+		}
+
+		double r1 = std::fabs(value[GEO_RADIUS1][row]);
+		double r2 = (value[GEO_RADIUS2] != nullptr) ? std::fabs(value[GEO_RADIUS2][row]) : 0.0;
+		for (int b = 0; b <= nv; b++)
+		{
+			double v = (double)b / nv;
+			// centre of the ring, its radius and the normal as radial and axial parts
+			Vec centre = p1;
+			double radius = r1, radialPart = 1.0, axialPart = 0.0;
+			switch (type)
+			{
+			case CYLINDER:
+				centre = p1 + v * axis;
+				break;
+			case CONE:
+				centre = p1 + v * axis;
+				radius = r1 + v * (r2 - r1);
+				radialPart = height;
+				axialPart = r1 - r2;
+				break;
+			case DISC:
+				radius = r1 + v * (r2 - r1);
+				radialPart = 0.0;
+				axialPart = (r2 >= r1) ? -1.0 : 1.0;
+				break;
+			case SPHERE:
+			{
+				double top = std::min(std::max(value[GEO_APEX_TRUNCATION][row], -r1), r1);
+				double bottom = std::min(std::max(value[GEO_BASE_TRUNCATION][row], -r1), r1);
+				double z = bottom + v * (top - bottom);
+				centre = p1 + z * w;
+				radius = std::sqrt(std::max(r1 * r1 - z * z, 0.0));
+				radialPart = radius;
+				axialPart = z;
+				break;
+			}
+			case PARABOLOID:
+			{
+				// z = h (r / R)^2 from the apex P1, a disc of radius R when h is 0
+				radialPart = 0.0;
+				axialPart = -1.0;
+				if (height > 0.0)
+				{
+					double z0 = std::min(std::max(value[GEO_APEX_TRUNCATION][row], 0.0), height);
+					double z = z0 + v * (height - z0);
+					centre = p1 + z * w;
+					radius = r1 * std::sqrt(z / height);
+					if (r1 > 0.0) radialPart = 2.0 * height * radius / (r1 * r1);
+				}
+				else
+				{
+					radius = v * r1;
+				}
+				break;
+			}
+			default:
+				break;
+			}
+
+			for (int a = 0; a <= nu; a++)
+			{
+				Vec radial = trig[2 * a] * e1 + trig[2 * a + 1] * e2;
+				out = putVertex(out, centre + radius * radial, normalized(radialPart * radial + axialPart * w));
+			}
+		}
+	}
+
+	// Two triangles per grid square. The squares of a cell are written together, so the triangles of
+	// cell i + j * cells1 are [(i + j * cells1) * 2 r^2, + 2 r^2) of the surface.
+	//
+	void writeIndices(int cells1, int cells2, int refinement, unsigned int base, unsigned int* out)
+	{
+		unsigned int stride = (unsigned int)(cells1 * refinement + 1);
+		for (int j = 0; j < cells2; j++)
+		{
+			for (int i = 0; i < cells1; i++)
+			{
+				for (int q = 0; q < refinement; q++)
+				{
+					unsigned int rowStart = base + (unsigned int)(j * refinement + q) * stride + (unsigned int)(i * refinement);
+					for (int p = 0; p < refinement; p++)
+					{
+						unsigned int v00 = rowStart + p, v10 = v00 + 1, v01 = v00 + stride, v11 = v01 + 1;
+						out[0] = v00; out[1] = v10; out[2] = v11;
+						out[3] = v00; out[4] = v11; out[5] = v01;
+						out += 6;
+					}
+				}
+			}
+		}
+	}
+}
+
+// The walk to the surfaces comes first, it reads the pending levels of a lazy tree and collects the
+// sides for the face map. Then the buffer ranges of every surface are laid out, and the surfaces are
+// written by chunks of consecutive surfaces.
+//
+void Tessellation::build(TasNode* root, GeometryStore& geometry, const TessellationOptions& options, WorkStealingPool* pool)
+{
+	const int refinement = options.useMeshing ? std::max(options.refinement, 1) : 1;
+	const int resolution = std::max(options.resolution, 1);
+
+	std::vector<SurfaceSide> sides;
+	std::vector<TasNode*> stack;
+	if (root != nullptr) stack.push_back(root);
+	while (!stack.empty())
+	{
+		TasNode* node = stack.back();
+		stack.pop_back();
+		if (isBoundedSurface(node->getNodeType()))
+		{
+			if (!options.useMeshing || !options.mapFaces) continue;
+			for (TasNode* child : node->Children)
+			{
+				FaceTable* faces = (child != nullptr) ? child->getFaceTable() : nullptr;
+				if (faces != nullptr) sides.push_back({ node->id, faces });
+			}
+			continue;
+		}
+		std::vector<TasNode*>& children = node->children();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			if (*it != nullptr) stack.push_back(*it);
+		}
+	}
+
+	geometry.computeWorldPoints();
+	TableColumns tables[GeometryStore::PrimitiveCount];
+	std::vector<SurfaceJob> jobs;
+	jobs.reserve(geometry.surfaceCount());
+	size_t vertices = 0, indices = 0;
+	std::vector<size_t> vertexOffsets, indexOffsets;
+	for (int index = 0; index < GeometryStore::PrimitiveCount; index++)
+	{
+		NodeType type = (NodeType)(GeometryStore::FirstPrimitive + index);
+		PrimitiveTable* table = geometry.getTable(type);
+		if (table->size() == 0) continue;
+		TableColumns& columns = tables[index];
+		for (int column = 0; column < GEO_COLUMN_COUNT; column++)
+		{
+			columns.value[column] = table->columnData((GeometryColumn)column);
+			if (column < 12) columns.point[column] = table->worldColumnData((GeometryColumn)column);
+		}
+		const long* meshing1 = table->indexColumnData(GEO_DIR1_MESHING);
+		const long* meshing2 = table->indexColumnData(GEO_DIR2_MESHING);
+		for (int row = 0; row < table->size(); row++)
+		{
+			SurfaceJob job;
+			job.type = type;
+			job.row = row;
+			job.cells1 = (options.useMeshing && meshing1[row] > 0) ? (int)meshing1[row] : resolution;
+			job.cells2 = (options.useMeshing && meshing2[row] > 0) ? (int)meshing2[row] : resolution;
+			job.meshed = options.useMeshing && meshing1[row] > 0 && meshing2[row] > 0;
+			size_t nu = (size_t)job.cells1 * refinement, nv = (size_t)job.cells2 * refinement;
+			jobs.push_back(job);
+			m_surfaces.emplace(table->getSurfaceId(row), (int)m_surface_ids.size());
+			m_surface_ids.push_back(table->getSurfaceId(row));
+			vertexOffsets.push_back(vertices);
+			indexOffsets.push_back(indices);
+			vertices += (nu + 1) * (nv + 1);
+			indices += 6 * nu * nv;
+		}
+	}
+	vertexOffsets.push_back(vertices);
+	indexOffsets.push_back(indices);
+
+	// the indices are 32 bit and the offsets are handed out as int
+	if (vertices > (size_t)INT_MAX || indices > (size_t)INT_MAX)
+	{
+		STI_LOG(LOG_ERROR, "tessellation: " << vertices << " vertices and " << indices
+			<< " indices do not fit in 32 bit buffers, lower the refinement or the resolution");
+		m_surface_ids.clear();
+		m_surfaces.clear();
+		return;
+	}
+	m_vertex_offsets.assign(vertexOffsets.begin(), vertexOffsets.end());
+	m_index_offsets.assign(indexOffsets.begin(), indexOffsets.end());
+	m_vertices.resize(vertices * VertexStride);
+	m_indices.resize(indices);
+
+	auto writeSurfaces = [this, &jobs, &tables, refinement](size_t first, size_t last)
+	{
+		std::vector<double> trig;
+		for (size_t surface = first; surface < last; surface++)
+		{
+			const SurfaceJob& job = jobs[surface];
+			const TableColumns& columns = tables[job.type - GeometryStore::FirstPrimitive];
+			int nu = job.cells1 * refinement, nv = job.cells2 * refinement;
+			float* out = m_vertices.data() + (size_t)m_vertex_offsets[surface] * VertexStride;
+			if (job.type == RECTANGLE || job.type == QUADRILATERAL || job.type == TRIANGLE)
+			{
+				writePlanar(columns, job.type, job.row, nu, nv, out);
+			}
+			else
+			{
+				writeCurved(columns, job.type, job.row, nu, nv, out, trig);
+			}
+			writeIndices(job.cells1, job.cells2, refinement, (unsigned int)m_vertex_offsets[surface],
+				m_indices.data() + m_index_offsets[surface]);
+		}
+	};
+
+	const size_t count = jobs.size();
+	const size_t chunk = (pool == nullptr) ? count
+		: std::max<size_t>(1, std::min<size_t>(256, count / (8 * (size_t)pool->threadCount())));
+	if (pool == nullptr || count <= chunk)
+	{
+		writeSurfaces(0, count);
+	}
+	else
+	{
+		TaskGroup group(*pool);
+		for (size_t first = 0; first < count; first += chunk)
+		{
+			size_t last = std::min(first + chunk, count);
+			group.run([&writeSurfaces, first, last] { writeSurfaces(first, last); });
+		}
+		group.wait();
+	}
+
+	for (const SurfaceSide& side : sides)
+	{
+		int surface = findSurface(side.surfaceId);
+		if (surface < 0) continue;
+		const SurfaceJob& job = jobs[surface];
+		int cells = job.cells1 * job.cells2;
+		if (!job.meshed || side.faces->size() != cells) continue;
+		int perCell = 2 * refinement * refinement;
+		int firstTriangle = m_index_offsets[surface] / 3;
+		for (int row = 0; row < cells; row++)
+		{
+			long faceId = side.faces->getFaceId(row);
+			if (faceId != 0) m_faces.emplace(faceId, (int)m_face_ids.size());
+			m_face_ids.push_back(faceId);
+			m_face_first.push_back(firstTriangle + row * perCell);
+			m_face_counts.push_back(perCell);
+		}
+	}
+}
+
+int Tessellation::vertexCount()
+{
+	return (int)(m_vertices.size() / VertexStride);
+}
+
+int Tessellation::indexCount()
+{
+	return (int)m_indices.size();
+}
+
+float* Tessellation::vertexData()
+{
+	return m_vertices.empty() ? nullptr : m_vertices.data();
+}
+
+unsigned int* Tessellation::indexData()
+{
+	return m_indices.empty() ? nullptr : m_indices.data();
+}
+
+void Tessellation::copyVertices(float* vertices)
+{
+	if (!m_vertices.empty() && vertices != nullptr)
+	{
+		std::memcpy(vertices, m_vertices.data(), m_vertices.size() * sizeof(float));
+	}
+}
+
+void Tessellation::copyIndices(unsigned int* indices)
+{
+	if (!m_indices.empty() && indices != nullptr)
+	{
+		std::memcpy(indices, m_indices.data(), m_indices.size() * sizeof(unsigned int));
+	}
+}
+
+int Tessellation::surfaceCount()
+{
+	return (int)m_surface_ids.size();
+}
+
+long Tessellation::getSurfaceId(int surface)
+{
+	return (surface < 0 || surface >= surfaceCount()) ? 0 : m_surface_ids[surface];
+}
+
+int Tessellation::findSurface(long surfaceId)
+{
+	auto it = m_surfaces.find(surfaceId);
+	return (it == m_surfaces.end()) ? -1 : it->second;
+}
+
+int Tessellation::getVertexOffset(int surface)
+{
+	return (surface < 0 || surface >= (int)m_vertex_offsets.size()) ? 0 : m_vertex_offsets[surface];
+}
+
+int Tessellation::getIndexOffset(int surface)
+{
+	return (surface < 0 || surface >= (int)m_index_offsets.size()) ? 0 : m_index_offsets[surface];
+}
+
+void Tessellation::copySurfaceIds(long* ids)
+{
+	if (!m_surface_ids.empty() && ids != nullptr)
+	{
+		std::memcpy(ids, m_surface_ids.data(), m_surface_ids.size() * sizeof(long));
+	}
+}
+
+void Tessellation::copyVertexOffsets(int* offsets)
+{
+	if (!m_vertex_offsets.empty() && offsets != nullptr)
+	{
+		std::memcpy(offsets, m_vertex_offsets.data(), m_vertex_offsets.size() * sizeof(int));
+	}
+}
+
+void Tessellation::copyIndexOffsets(int* offsets)
+{
+	if (!m_index_offsets.empty() && offsets != nullptr)
+	{
+		std::memcpy(offsets, m_index_offsets.data(), m_index_offsets.size() * sizeof(int));
+	}
+}
+
+int Tessellation::faceCount()
+{
+	return (int)m_face_ids.size();
+}
+
+int Tessellation::findFace(long faceId)
+{
+	auto it = m_faces.find(faceId);
+	return (it == m_faces.end()) ? -1 : it->second;
+}
+
+long Tessellation::getFaceId(int face)
+{
+	return (face < 0 || face >= faceCount()) ? 0 : m_face_ids[face];
+}
+
+int Tessellation::getFaceFirstTriangle(int face)
+{
+	return (face < 0 || face >= faceCount()) ? -1 : m_face_first[face];
+}
+
+int Tessellation::getFaceTriangleCount(int face)
+{
+	return (face < 0 || face >= faceCount()) ? 0 : m_face_counts[face];
+}
+
+void Tessellation::copyFaceIds(long* ids)
+{
+	if (!m_face_ids.empty() && ids != nullptr)
+	{
+		std::memcpy(ids, m_face_ids.data(), m_face_ids.size() * sizeof(long));
+	}
+}
+
+void Tessellation::copyFaceFirstTriangles(int* triangles)
+{
+	if (!m_face_first.empty() && triangles != nullptr)
+	{
+		std::memcpy(triangles, m_face_first.data(), m_face_first.size() * sizeof(int));
+	}
+}
+
+void Tessellation::copyFaceTriangleCounts(int* counts)
+{
+	if (!m_face_counts.empty() && counts != nullptr)
+	{
+		std::memcpy(counts, m_face_counts.data(), m_face_counts.size() * sizeof(int));
+	}
+}
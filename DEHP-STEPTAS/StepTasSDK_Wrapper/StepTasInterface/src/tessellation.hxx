@@ -0,0 +1,113 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="tessellation.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Tessellation
+// Triangles of every bounded surface in model coordinates, in one interleaved vertex buffer (position
+// then normal, as floats) and one 32 bit index buffer over the whole model, ready to be uploaded as is.
+// Each surface is a grid over its parameters: the two edges from P1 for the planar primitives, the angle
+// and the axis (or the radius for a disc) for the curved ones. The vertex and index counts are known from
+// the grid sizes, so the surfaces are written in parallel, each into its own range of the buffers.
+// With the meshing counts the grid has dir1_meshing x dir2_meshing cells, a direction without a count
+// gets resolution cells. The triangles of a cell are consecutive. Nothing the adapter reads ties a face
+// of a side to a cell, so the face map is opt-in: it assumes the faces are listed dir1 first, face row
+// i + j * dir1_meshing being cell (i, j).
+
+#include <unordered_map>
+#include <vector>
+#include "interface.hxx"
+
+class WorkStealingPool;
+
+namespace sti
+{
+	class GeometryStore;
+
+	class TessellationOptions
+	{
+	public:
+		TessellationOptions() : useMeshing(true), refinement(1), resolution(16), mapFaces(false) {};
+		// dir1_meshing x dir2_meshing cells per surface, each split in refinement x refinement
+		bool useMeshing;
+		int refinement;
+		// cells along a direction without a meshing count, or along both when useMeshing is false
+		int resolution;
+		// face map of the surfaces meshed in both directions, in the dir1 first face order
+		bool mapFaces;
+	};
+
+	// owned by the caller, the buffers stay valid as long as the Tessellation
+	class Tessellation
+	{
+	public:
+		static const int VertexStride = 6; // floats per vertex: x y z, then the unit normal
+
+		int vertexCount();
+		int indexCount(); // three per triangle, counter-clockwise around the normal
+		// zero copy access, nullptr when empty. The indices refer to the whole vertex buffer
+		float* vertexData();
+		unsigned int* indexData();
+		// vertexCount() * VertexStride and indexCount() entries
+		void copyVertices(float* vertices);
+		void copyIndices(unsigned int* indices);
+
+		// surfaces in buffer order
+		int surfaceCount();
+		long getSurfaceId(int surface);
+		int findSurface(long surfaceId); // -1 when the surface is not tessellated
+		// first vertex and first index of the surface, surfaceCount() gives the buffer sizes
+		int getVertexOffset(int surface);
+		int getIndexOffset(int surface);
+		void copySurfaceIds(long* ids); // surfaceCount() entries
+		void copyVertexOffsets(int* offsets); // surfaceCount() + 1 entries
+		void copyIndexOffsets(int* offsets);
+
+		// faces of both sides of the surfaces, when TessellationOptions.mapFaces is set.
+		// A side whose face count is not the cell count of its surface is left out
+		int faceCount();
+		int findFace(long faceId); // -1 when unknown
+		long getFaceId(int face);
+		int getFaceFirstTriangle(int face);
+		int getFaceTriangleCount(int face);
+		// faceCount() entries
+		void copyFaceIds(long* ids);
+		void copyFaceFirstTriangles(int* triangles);
+		void copyFaceTriangleCounts(int* counts);
+
+#ifndef SWIG
+		// reads the pending levels of a lazy tree. Serial when pool is null
+		void build(TasNode* root, GeometryStore& geometry, const TessellationOptions& options, WorkStealingPool* pool);
+	private:
+		std::vector<float> m_vertices;
+		std::vector<unsigned int> m_indices;
+		std::vector<long> m_surface_ids;
+		std::vector<int> m_vertex_offsets;
+		std::vector<int> m_index_offsets;
+		std::unordered_map<long, int> m_surfaces;
+		std::vector<long> m_face_ids;
+		std::vector<int> m_face_first;
+		std::vector<int> m_face_counts;
+		std::unordered_map<long, int> m_faces; // first face on duplicate ids
+#endif
+	};
+}
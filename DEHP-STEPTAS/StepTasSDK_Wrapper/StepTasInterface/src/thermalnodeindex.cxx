@@ -0,0 +1,262 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="thermalnodeindex.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+#include "thermalnodeindex.hxx"
+
+using namespace sti;
+
+int ThermalNodeSet::size()
+{
+	return (int)items.size();
+}
+
+int ThermalNodeSet::getNetworkNode(int i)
+{
+	if (i < 0 || i >= size()) return -1;
+	return items[i].networkNode;
+}
+
+std::string ThermalNodeSet::getNetworkNodeName(int i)
+{
+	return m_index->getNetworkNodeName(getNetworkNode(i));
+}
+
+std::string ThermalNodeSet::getModel(int i)
+{
+	return m_index->getNetworkNodeModel(getNetworkNode(i));
+}
+
+std::string ThermalNodeSet::getMeshedSurfaceName(int i)
+{
+	TasNode* surface = getMeshedSurface(i);
+	return surface == nullptr ? "" : surface->name.str();
+}
+
+TasNode* ThermalNodeSet::getMeshedSurface(int i)
+{
+	if (i < 0 || i >= size()) return nullptr;
+	return items[i].surface;
+}
+
+void ThermalNodeIndex::addFaces(Side* side, TasNode* surface)
+{
+	if (side->faces.size() == 0) return;
+	m_sides.push_back({ side, surface });
+}
+
+void ThermalNodeIndex::append(ThermalNodeIndex& other)
+{
+	m_sides.insert(m_sides.end(), other.m_sides.begin(), other.m_sides.end());
+	other.m_sides.clear();
+}
+
+void ThermalNodeIndex::finalize(TasNode* root)
+{
+	std::unordered_map<const TasNode*, TasNode*> registered; // side -> surface
+	for (const RegisteredSide& entry : m_sides)
+	{
+		registered.emplace(entry.side, entry.surface);
+	}
+	m_faces.clear();
+	m_ranges.clear();
+	m_sets.clear();
+
+	// pre-order walk, a node's range is closed when the walk leaves its subtree
+	std::vector<std::pair<TasNode*, bool>> stack;
+	if (root != nullptr) stack.push_back({ root, false });
+	while (!stack.empty())
+	{
+		TasNode* node = stack.back().first;
+		bool leaving = stack.back().second;
+		stack.pop_back();
+		if (leaving)
+		{
+			m_ranges[node].last = (int)m_faces.size();
+			continue;
+		}
+
+		m_ranges[node] = { (int)m_faces.size(), 0 };
+		auto registeredSide = registered.find(node);
+		if (registeredSide != registered.end())
+		{
+			// the faces come from the table, the Face nodes are not created for the index
+			Side* side = static_cast<Side*>(node);
+			FaceTable& table = side->faces;
+			bool materialized = side->pendingExpansion == nullptr && (int)side->Children.size() == table.size();
+			for (int row = 0; row < table.size(); row++)
+			{
+				int first = (int)m_faces.size();
+				if (!table.text(table.getNetworkNodeId(row)).empty())
+				{
+					m_faces.push_back({ side, row, registeredSide->second, -1 });
+				}
+				if (materialized) m_ranges[side->Children[row]] = { first, (int)m_faces.size() };
+			}
+			m_ranges[node].last = (int)m_faces.size();
+			continue;
+		}
+		stack.push_back({ node, true });
+
+		std::vector<TasNode*>& children = node->children();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			if (*it != nullptr) stack.push_back({ *it, false });
+		}
+	}
+
+	// network nodes are numbered in order of first appearance
+	m_names.clear();
+	m_models.clear();
+	m_network_nodes.clear();
+	for (Entry& entry : m_faces)
+	{
+		FaceTable& table = entry.side->faces;
+		const std::string& name = table.text(table.getNetworkNodeId(entry.row));
+		const std::string& model = table.text(table.getModelId(entry.row));
+		auto inserted = m_network_nodes.emplace(model + '\n' + name, (int)m_names.size());
+		if (inserted.second)
+		{
+			m_names.push_back(name);
+			m_models.push_back(model);
+		}
+		entry.networkNode = inserted.first->second;
+	}
+
+	// reverse direction, faces grouped by network node
+	m_node_offsets.assign(m_names.size() + 1, 0);
+	for (const Entry& entry : m_faces) m_node_offsets[entry.networkNode + 1]++;
+	for (size_t n = 0; n < m_names.size(); n++) m_node_offsets[n + 1] += m_node_offsets[n];
+	m_node_faces.resize(m_faces.size());
+	std::vector<int> cursor(m_node_offsets.begin(), m_node_offsets.end() - 1);
+	for (size_t i = 0; i < m_faces.size(); i++)
+	{
+		m_node_faces[cursor[m_faces[i].networkNode]++] = (int)i;
+	}
+	m_finalized = true;
+}
+
+int ThermalNodeIndex::networkNodeCount()
+{
+	return (int)m_names.size();
+}
+
+std::string ThermalNodeIndex::getNetworkNodeName(int networkNode)
+{
+	if (networkNode < 0 || networkNode >= networkNodeCount()) return "";
+	return m_names[networkNode];
+}
+
+std::string ThermalNodeIndex::getNetworkNodeModel(int networkNode)
+{
+	if (networkNode < 0 || networkNode >= networkNodeCount()) return "";
+	return m_models[networkNode];
+}
+
+int ThermalNodeIndex::findNetworkNode(const std::string& model, const std::string& name)
+{
+	auto it = m_network_nodes.find(model + '\n' + name);
+	return it == m_network_nodes.end() ? -1 : it->second;
+}
+
+int ThermalNodeIndex::faceCount(int networkNode)
+{
+	if (networkNode < 0 || networkNode >= networkNodeCount()) return 0;
+	return m_node_offsets[networkNode + 1] - m_node_offsets[networkNode];
+}
+
+TasNode* ThermalNodeIndex::getFace(int networkNode, int i)
+{
+	if (i < 0 || i >= faceCount(networkNode)) return nullptr;
+	return faceNode(m_faces[m_node_faces[m_node_offsets[networkNode] + i]]);
+}
+
+TasNode* ThermalNodeIndex::getFaceSurface(int networkNode, int i)
+{
+	if (i < 0 || i >= faceCount(networkNode)) return nullptr;
+	return m_faces[m_node_faces[m_node_offsets[networkNode] + i]].surface;
+}
+
+ThermalNodeSet* ThermalNodeIndex::getThermalNodes(TasNode* element)
+{
+	auto cached = m_sets.find(element);
+	if (cached != m_sets.end()) return cached->second.get();
+
+	std::unique_ptr<ThermalNodeSet> set(new ThermalNodeSet(this));
+	Range range;
+	auto known = m_ranges.find(element);
+	bool found = (known != m_ranges.end());
+	if (found)
+	{
+		range = known->second;
+	}
+	else
+	{
+		found = findFaceRange(element, range);
+	}
+	if (found)
+	{
+		std::set<std::pair<int, const TasNode*>> seen;
+		for (int i = range.first; i < range.last; i++)
+		{
+			const Entry& entry = m_faces[i];
+			// one item per network node and meshed surface, as the extraction lists them
+			if (seen.insert({ entry.networkNode, entry.surface }).second)
+			{
+				set->items.push_back({ entry.networkNode, entry.surface });
+			}
+		}
+	}
+	ThermalNodeSet* result = set.get();
+	m_sets.emplace(element, std::move(set));
+	return result;
+}
+
+// creates the Face nodes of the side on first use
+TasNode* ThermalNodeIndex::faceNode(const Entry& entry)
+{
+	std::vector<TasNode*>& faces = entry.side->children();
+	return entry.row < (int)faces.size() ? faces[entry.row] : nullptr;
+}
+
+// Face created after finalize: its entry is found in the range of its side.
+bool ThermalNodeIndex::findFaceRange(TasNode* face, Range& range)
+{
+	if (face == nullptr || face->getNodeType() != FACE || face->parent == nullptr) return false;
+	auto side = m_ranges.find(face->parent);
+	if (side == m_ranges.end()) return false;
+	std::vector<TasNode*>& siblings = face->parent->Children;
+	int row = (int)(std::find(siblings.begin(), siblings.end(), face) - siblings.begin());
+	range = { side->second.first, side->second.first };
+	for (int i = side->second.first; i < side->second.last; i++)
+	{
+		if (m_faces[i].row == row)
+		{
+			range = { i, i + 1 };
+			break;
+		}
+	}
+	return true;
+}
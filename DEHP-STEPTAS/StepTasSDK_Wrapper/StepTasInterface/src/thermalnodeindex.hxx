@@ -0,0 +1,127 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="thermalnodeindex.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Thermal node index
+// Links the faces to the thermal network nodes they are meshed with, in both directions:
+//  - element -> the distinct network nodes of the faces under it. The faces are numbered in pre-order, so
+//    every node of the tree covers one contiguous range of faces and the query is a range lookup;
+//    the deduplicated result is cached per element.
+//  - network node -> the faces (and their meshed bounded surfaces) carrying it, to map solver results back
+//    onto the geometry.
+// The sides are registered by the parser with their face tables, the ranges are computed once the tree is
+// complete. The faces are read from the tables, a Face node is only created when one is returned.
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "interface.hxx"
+
+namespace sti
+{
+	class ThermalNodeIndex;
+
+	// distinct (network node, meshed surface) pairs under an element
+	class ThermalNodeSet
+	{
+	public:
+		int size();
+		int getNetworkNode(int i); // network node number in the ThermalNodeIndex
+		std::string getNetworkNodeName(int i);
+		std::string getModel(int i);
+		std::string getMeshedSurfaceName(int i);
+		TasNode* getMeshedSurface(int i);
+
+#ifndef SWIG
+		struct Item
+		{
+			int networkNode;
+			TasNode* surface;
+		};
+		ThermalNodeSet(ThermalNodeIndex* index) : m_index(index) {}
+		std::vector<Item> items;
+	private:
+		ThermalNodeIndex* m_index;
+#endif
+	};
+
+	class ThermalNodeIndex
+	{
+	public:
+		int networkNodeCount();
+		std::string getNetworkNodeName(int networkNode);
+		std::string getNetworkNodeModel(int networkNode);
+		// -1 when unknown
+		int findNetworkNode(const std::string& model, const std::string& name);
+
+		// network node -> faces, in pre-order
+		int faceCount(int networkNode);
+		TasNode* getFace(int networkNode, int i);
+		TasNode* getFaceSurface(int networkNode, int i); // meshed bounded surface holding the face
+
+		// element -> network nodes, owned by the index
+		ThermalNodeSet* getThermalNodes(TasNode* element);
+
+#ifndef SWIG
+		// parser side, the surface is the meshed bounded surface node holding the side
+		void addFaces(Side* side, TasNode* surface);
+		// moves the faces registered by a parallel fragment
+		void append(ThermalNodeIndex& other);
+		// numbers the faces in pre-order, the tree must be complete
+		void finalize(TasNode* root);
+		bool isFinalized() const { return m_finalized; }
+	private:
+		struct Entry
+		{
+			Side* side;
+			int row;          // in the face table of the side
+			TasNode* surface;
+			int networkNode;
+		};
+		struct RegisteredSide
+		{
+			Side* side;
+			TasNode* surface;
+		};
+		struct Range
+		{
+			int first;
+			int last;
+		};
+
+		std::vector<RegisteredSide> m_sides;
+		std::vector<Entry> m_faces;          // pre-order, faces with a network node only
+		TasNode* faceNode(const Entry& entry);
+		bool findFaceRange(TasNode* face, Range& range);
+		std::vector<std::string> m_names;
+		std::vector<std::string> m_models;
+		std::unordered_map<std::string, int> m_network_nodes; // model + '\n' + name -> network node
+		std::vector<int> m_node_offsets;      // CSR: faces of network node n are m_node_faces[m_node_offsets[n] .. m_node_offsets[n+1]]
+		std::vector<int> m_node_faces;
+		std::unordered_map<const TasNode*, Range> m_ranges;
+		std::unordered_map<const TasNode*, std::unique_ptr<ThermalNodeSet>> m_sets;
+		bool m_finalized = false;
+#endif
+	};
+}
@@ -0,0 +1,206 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="threadpool.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+#include <chrono>
+
+#include "threadpool.hxx"
+
+namespace
+{
+	// index of the pool worker running on this thread, -1 outside of the workers
+	thread_local int t_workerIndex = -1;
+	thread_local const WorkStealingPool* t_workerPool = nullptr;
+}
+
+int WorkStealingPool::hardwareThreads()
+{
+	unsigned count = std::thread::hardware_concurrency();
+	return (count == 0) ? 1 : (int)count;
+}
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = hardwareThreads();
+	}
+	for (int i = 0; i < threadCount; i++)
+	{
+		m_queues.push_back(std::unique_ptr<Queue>(new Queue()));
+	}
+	for (int i = 0; i < threadCount; i++)
+	{
+		m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stop = true;
+	}
+	m_wakeUp.notify_all();
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void WorkStealingPool::submit(Task task)
+{
+	// a worker keeps the tasks it spawns, other threads spread them round robin
+	int target = (t_workerPool == this) ? t_workerIndex : (int)(m_nextQueue++ % m_queues.size());
+	{
+		std::lock_guard<std::mutex> lock(m_queues[target]->mutex);
+		m_queues[target]->tasks.push_back(std::move(task));
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_queued++;
+	}
+	m_wakeUp.notify_one();
+}
+
+// The end of the queue the task is taken from, or the task of the group nearest to it.
+//
+bool WorkStealingPool::take(Queue& queue, Task& task, bool back, const TaskGroup* group)
+{
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	std::deque<Task>& tasks = queue.tasks;
+	for (size_t i = 0; i < tasks.size(); i++)
+	{
+		size_t at = back ? tasks.size() - 1 - i : i;
+		if (group != nullptr && tasks[at].group != group) continue;
+		task = std::move(tasks[at]);
+		tasks.erase(tasks.begin() + at);
+		return true;
+	}
+	return false;
+}
+
+bool WorkStealingPool::popLocal(int self, Task& task, const TaskGroup* group)
+{
+	if (self < 0) return false;
+	return take(*m_queues[self], task, true, group);
+}
+
+bool WorkStealingPool::steal(int self, Task& task, const TaskGroup* group)
+{
+	int count = (int)m_queues.size();
+	int start = (self < 0) ? 0 : self + 1;
+	for (int i = 0; i < count; i++)
+	{
+		int victim = (start + i) % count;
+		if (victim == self) continue;
+		if (take(*m_queues[victim], task, false, group)) return true;
+	}
+	return false;
+}
+
+void WorkStealingPool::run(Task& task)
+{
+	m_queued--;
+	std::exception_ptr error;
+	try
+	{
+		task.work();
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	task.group->finished(error);
+}
+
+bool WorkStealingPool::tryRunOne(int self, const TaskGroup* group)
+{
+	Task task;
+	if (popLocal(self, task, group) || steal(self, task, group))
+	{
+		run(task);
+		return true;
+	}
+	return false;
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+	t_workerIndex = index;
+	t_workerPool = this;
+	while (true)
+	{
+		if (tryRunOne(index)) continue;
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_wakeUp.wait(lock, [this] { return m_stop || m_queued > 0; });
+		if (m_stop && m_queued == 0) return;
+	}
+}
+
+void TaskGroup::run(std::function<void()> work)
+{
+	m_pending++;
+	m_pool.submit({ std::move(work), this });
+}
+
+void TaskGroup::finished(std::exception_ptr error)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (error && !m_error)
+	{
+		m_error = error;
+	}
+	if (--m_pending == 0)
+	{
+		m_done.notify_all();
+	}
+}
+
+void TaskGroup::drain()
+{
+	int self = (t_workerPool == &m_pool) ? t_workerIndex : -1;
+	while (m_pending > 0)
+	{
+		if (m_pool.tryRunOne(self, this)) continue;
+
+		// nothing left to help with: the remaining tasks are running elsewhere
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait_for(lock, std::chrono::milliseconds(1), [this] { return m_pending == 0; });
+	}
+}
+
+void TaskGroup::wait()
+{
+	drain();
+
+	std::exception_ptr error;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::swap(error, m_error);
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="threadpool.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// Work stealing thread pool
+// Every worker owns a task deque: it pops its own tasks from the back (last in, first out, good locality
+// for tasks that spawn subtasks) and steals from the front of the other deques when it runs dry.
+// Tasks are grouped in TaskGroups; waiting on a group makes the calling thread help with the pending tasks
+// of that group, so a task may itself wait on a nested group without starving the pool. Only that group:
+// the waiting thread may hold a lock (the SDK lock of a load) that the task of another group would take.
+// This header is internal to steptasint, it is not exposed through SWIG.
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskGroup;
+
+class WorkStealingPool
+{
+public:
+	// threadCount <= 0 uses one worker per hardware thread
+	explicit WorkStealingPool(int threadCount = 0);
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	int threadCount() const { return (int)m_threads.size(); }
+
+	static int hardwareThreads();
+
+private:
+	friend class TaskGroup;
+
+	struct Task
+	{
+		std::function<void()> work;
+		TaskGroup* group;
+	};
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void submit(Task task);
+	// group set: only a task of that group is taken
+	bool tryRunOne(int self, const TaskGroup* group = nullptr);
+	bool popLocal(int self, Task& task, const TaskGroup* group);
+	bool steal(int self, Task& task, const TaskGroup* group);
+	static bool take(Queue& queue, Task& task, bool back, const TaskGroup* group);
+	void run(Task& task);
+	void workerLoop(int index);
+
+	std::vector<std::unique_ptr<Queue>> m_queues;
+	std::vector<std::thread> m_threads;
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wakeUp;
+	std::atomic<long> m_queued{ 0 };
+	std::atomic<unsigned> m_nextQueue{ 0 };
+	std::atomic<bool> m_stop{ false };
+};
+
+// A set of tasks that can be waited for together.
+class TaskGroup
+{
+public:
+	explicit TaskGroup(WorkStealingPool& pool) : m_pool(pool) {}
+	// Waits for the tasks still running but drops their exception: a destructor may run during unwinding.
+	~TaskGroup() { drain(); }
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	void run(std::function<void()> work);
+
+	// Blocks until every task of the group has run, running the queued ones meanwhile.
+	// The first exception thrown by a task is rethrown here.
+	void wait();
+
+private:
+	friend class WorkStealingPool;
+
+	void finished(std::exception_ptr error);
+	void drain();
+
+	WorkStealingPool& m_pool;
+	std::atomic<long> m_pending{ 0 };
+	std::mutex m_mutex;
+	std::condition_variable m_done;
+	std::exception_ptr m_error;
+};
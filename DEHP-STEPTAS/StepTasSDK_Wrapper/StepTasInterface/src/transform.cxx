@@ -0,0 +1,193 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="transform.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "transform.hxx"
+#include <cmath>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define STI_HAS_AVX2_KERNEL 1
+#endif
+
+using namespace sti;
+
+Transform::Transform()
+{
+	for (int i = 0; i < 16; i++) m[i] = (i % 5 == 0) ? 1.0 : 0.0;
+}
+
+double Transform::get(int row, int column) const
+{
+	if (row < 0 || row > 3 || column < 0 || column > 3) return 0.0;
+	return m[row * 4 + column];
+}
+
+bool Transform::isIdentity() const
+{
+	for (int i = 0; i < 16; i++)
+	{
+		if (m[i] != ((i % 5 == 0) ? 1.0 : 0.0)) return false;
+	}
+	return true;
+}
+
+Point3D Transform::apply(const Point3D& point) const
+{
+	Point3D out;
+	out.x = m[0] * point.x + m[1] * point.y + m[2] * point.z + m[3];
+	out.y = m[4] * point.x + m[5] * point.y + m[6] * point.z + m[7];
+	out.z = m[8] * point.x + m[9] * point.y + m[10] * point.z + m[11];
+	return out;
+}
+
+Direction Transform::applyToDirection(const Direction& direction) const
+{
+	Direction out;
+	out.x = m[0] * direction.x + m[1] * direction.y + m[2] * direction.z;
+	out.y = m[4] * direction.x + m[5] * direction.y + m[6] * direction.z;
+	out.z = m[8] * direction.x + m[9] * direction.y + m[10] * direction.z;
+	return out;
+}
+
+Transform Transform::translation(double x, double y, double z)
+{
+	Transform t;
+	t.m[3] = x;
+	t.m[7] = y;
+	t.m[11] = z;
+	return t;
+}
+
+// Rodrigues formula. A null axis gives the identity.
+//
+Transform Transform::rotation(const Direction& axis, double angle)
+{
+	Transform t;
+	double length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+	if (length == 0.0) return t;
+	double x = axis.x / length, y = axis.y / length, z = axis.z / length;
+	double c = std::cos(angle), s = std::sin(angle), v = 1.0 - c;
+	t.m[0] = x * x * v + c;     t.m[1] = x * y * v - z * s; t.m[2] = x * z * v + y * s;
+	t.m[4] = y * x * v + z * s; t.m[5] = y * y * v + c;     t.m[6] = y * z * v - x * s;
+	t.m[8] = z * x * v - y * s; t.m[9] = z * y * v + x * s; t.m[10] = z * z * v + c;
+	return t;
+}
+
+Transform Transform::operator*(const Transform& other) const
+{
+	Transform t;
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 4; column++)
+		{
+			t.m[row * 4 + column] = m[row * 4] * other.m[column] + m[row * 4 + 1] * other.m[4 + column]
+				+ m[row * 4 + 2] * other.m[8 + column] + m[row * 4 + 3] * other.m[12 + column];
+		}
+	}
+	return t;
+}
+
+namespace
+{
+	void transformPointsScalar(const Transform& t, const double* x, const double* y, const double* z,
+		double* outX, double* outY, double* outZ, size_t begin, size_t end)
+	{
+		const double* m = t.m;
+		for (size_t i = begin; i < end; i++)
+		{
+			double px = x[i], py = y[i], pz = z[i];
+			outX[i] = m[0] * px + m[1] * py + m[2] * pz + m[3];
+			outY[i] = m[4] * px + m[5] * py + m[6] * pz + m[7];
+			outZ[i] = m[8] * px + m[9] * py + m[10] * pz + m[11];
+		}
+	}
+
+#ifdef STI_HAS_AVX2_KERNEL
+	bool hasAvx2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return false;
+		__cpuidex(info, 7, 0);
+		bool avx2 = (info[1] & (1 << 5)) != 0;
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		// the OS must save the YMM registers
+		return avx2 && osxsave && (_xgetbv(0) & 6) == 6;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	// four points per iteration, the rows of the matrix are broadcast once
+	//
+#if !defined(_MSC_VER)
+	__attribute__((target("avx2")))
+#endif
+	size_t transformPointsAvx2(const Transform& t, const double* x, const double* y, const double* z,
+		double* outX, double* outY, double* outZ, size_t n)
+	{
+		const double* m = t.m;
+		const __m256d m0 = _mm256_set1_pd(m[0]), m1 = _mm256_set1_pd(m[1]), m2 = _mm256_set1_pd(m[2]), m3 = _mm256_set1_pd(m[3]);
+		const __m256d m4 = _mm256_set1_pd(m[4]), m5 = _mm256_set1_pd(m[5]), m6 = _mm256_set1_pd(m[6]), m7 = _mm256_set1_pd(m[7]);
+		const __m256d m8 = _mm256_set1_pd(m[8]), m9 = _mm256_set1_pd(m[9]), m10 = _mm256_set1_pd(m[10]), m11 = _mm256_set1_pd(m[11]);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256d px = _mm256_loadu_pd(x + i);
+			__m256d py = _mm256_loadu_pd(y + i);
+			__m256d pz = _mm256_loadu_pd(z + i);
+			__m256d rx = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m0, px), _mm256_mul_pd(m1, py)), _mm256_add_pd(_mm256_mul_pd(m2, pz), m3));
+			__m256d ry = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m4, px), _mm256_mul_pd(m5, py)), _mm256_add_pd(_mm256_mul_pd(m6, pz), m7));
+			__m256d rz = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m8, px), _mm256_mul_pd(m9, py)), _mm256_add_pd(_mm256_mul_pd(m10, pz), m11));
+			_mm256_storeu_pd(outX + i, rx);
+			_mm256_storeu_pd(outY + i, ry);
+			_mm256_storeu_pd(outZ + i, rz);
+		}
+		return i;
+	}
+
+#endif
+}
+
+bool sti::hasAvx2Kernels()
+{
+#ifdef STI_HAS_AVX2_KERNEL
+	static const bool supported = hasAvx2();
+	return supported;
+#else
+	return false;
+#endif
+}
+
+void sti::transformPoints(const Transform& t, const double* x, const double* y, const double* z,
+	double* outX, double* outY, double* outZ, size_t n)
+{
+	size_t done = 0;
+#ifdef STI_HAS_AVX2_KERNEL
+	if (hasAvx2Kernels()) done = transformPointsAvx2(t, x, y, z, outX, outY, outZ, n);
+#endif
+	transformPointsScalar(t, x, y, z, outX, outY, outZ, done, n);
+}
@@ -0,0 +1,66 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="transform.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Transformations
+// A 4x4 row major matrix taking local coordinates to model (world) coordinates. The transformation entities
+// of the file are turned into matrices once per entity, composed with those of the enclosing compounds and
+// kept in the node arena: every Geometry node points to the matrix of its position in the model, nullptr
+// when it is not transformed.
+// transformPoints applies one matrix to columns of coordinates, four points per AVX2 instruction when the
+// processor has it.
+
+#include <cstddef>
+#include "interface.hxx"
+
+namespace sti
+{
+	class Transform
+	{
+	public:
+		Transform();
+
+		double get(int row, int column) const;
+		bool isIdentity() const;
+		Point3D apply(const Point3D& point) const;
+		Direction applyToDirection(const Direction& direction) const; // the translation is left out
+
+#ifndef SWIG
+		static Transform translation(double x, double y, double z);
+		// right handed rotation of angle radians around an axis through the origin, the axis needs not be normalized
+		static Transform rotation(const Direction& axis, double angle);
+
+		Transform operator*(const Transform& other) const;
+
+		double m[16];
+#endif
+	};
+
+#ifndef SWIG
+	// out = t * in for n points given as coordinate columns. The output columns may be the input ones
+	void transformPoints(const Transform& t, const double* x, const double* y, const double* z,
+		double* outX, double* outY, double* outZ, size_t n);
+	// the processor and the OS run the AVX2 kernels, checked on the first call
+	bool hasAvx2Kernels();
+#endif
+}
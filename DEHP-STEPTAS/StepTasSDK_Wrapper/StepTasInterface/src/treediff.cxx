@@ -0,0 +1,311 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="treediff.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "nodehash.hxx"
+#include "treediff.hxx"
+
+using namespace sti;
+
+namespace sti
+{
+	struct DiffWalker
+	{
+		const NodeHashes& firstHashes;
+		const NodeHashes& secondHashes;
+		TreeDiff& diff;
+		std::vector<TasNode*> deleted;
+		std::vector<TasNode*> added;
+
+		static uint64_t pairingKey(TasNode* node)
+		{
+			HashBuilder key;
+			key.add((uint64_t)node->getNodeType());
+			key.add(node->name);
+			key.add(node->classType);
+			return key.value();
+		}
+
+		// the marks of an earlier diff. Only the nodes already built are visited, a node built later starts Unchanged
+		static void resetStatus(TasNode* root)
+		{
+			std::vector<TasNode*> stack(1, root);
+			while (!stack.empty())
+			{
+				TasNode* node = stack.back();
+				stack.pop_back();
+				node->status = Unchanged;
+				for (TasNode* child : node->Children)
+				{
+					if (child != nullptr) stack.push_back(child);
+				}
+			}
+		}
+
+		// pairs the children of two paired nodes, the unpaired ones are kept for the move detection
+		void pairChildren(TasNode* first, TasNode* second, std::vector<std::pair<TasNode*, TasNode*>>& pairs)
+		{
+			std::vector<TasNode*>& firstChildren = first->children();
+			std::vector<TasNode*>& secondChildren = second->children();
+
+			// usual case: same children in the same order
+			bool aligned = firstChildren.size() == secondChildren.size();
+			for (size_t i = 0; aligned && i < firstChildren.size(); i++)
+			{
+				aligned = firstChildren[i] != nullptr && secondChildren[i] != nullptr
+					&& pairingKey(firstChildren[i]) == pairingKey(secondChildren[i]);
+			}
+			if (aligned)
+			{
+				for (size_t i = 0; i < firstChildren.size(); i++)
+				{
+					pairs.push_back({ firstChildren[i], secondChildren[i] });
+				}
+				return;
+			}
+
+			std::unordered_map<uint64_t, std::vector<TasNode*>> candidates;
+			for (auto it = secondChildren.rbegin(); it != secondChildren.rend(); ++it)
+			{
+				if (*it != nullptr) candidates[pairingKey(*it)].push_back(*it); // reversed, back() is the first one
+			}
+			for (TasNode* child : firstChildren)
+			{
+				if (child == nullptr) continue;
+				auto it = candidates.find(pairingKey(child));
+				if (it == candidates.end() || it->second.empty())
+				{
+					deleted.push_back(child);
+					continue;
+				}
+				pairs.push_back({ child, it->second.back() });
+				it->second.pop_back();
+			}
+			for (TasNode* child : secondChildren)
+			{
+				if (child == nullptr) continue;
+				auto it = candidates.find(pairingKey(child));
+				if (it != candidates.end() && !it->second.empty() && it->second.back() == child)
+				{
+					it->second.pop_back();
+					added.push_back(child);
+				}
+			}
+		}
+
+		void walk(TasNode* first, TasNode* second)
+		{
+			std::vector<std::pair<TasNode*, TasNode*>> stack;
+			stack.push_back({ first, second });
+			while (!stack.empty())
+			{
+				std::pair<TasNode*, TasNode*> pair = stack.back();
+				stack.pop_back();
+				NodeHashes::Hashes firstHash, secondHash;
+				if (!firstHashes.find(pair.first, firstHash) || !secondHashes.find(pair.second, secondHash)) continue;
+
+				if (firstHash.subtree == secondHash.subtree)
+				{
+					diff.m_identical++;
+					continue;
+				}
+				if (firstHash.content != secondHash.content)
+				{
+					diff.m_entries.push_back({ DIFF_MODIFIED, pair.first, pair.second });
+					pair.first->status = Modified;
+					pair.second->status = Modified;
+				}
+
+				std::vector<std::pair<TasNode*, TasNode*>> pairs;
+				pairChildren(pair.first, pair.second, pairs);
+				for (auto it = pairs.rbegin(); it != pairs.rend(); ++it)
+				{
+					stack.push_back(*it);
+				}
+			}
+		}
+
+		static uint64_t subtreeHash(const NodeHashes& hashes, TasNode* node)
+		{
+			NodeHashes::Hashes found;
+			return hashes.find(node, found) ? found.subtree : 0;
+		}
+
+		// the faces of an unpaired side are not created, they take the status of their side when they are.
+		// Those already created are marked here
+		static bool walkChildren(TasNode* node, DataStatus status)
+		{
+			if (node->getFaceTable() == nullptr) return true;
+			for (TasNode* face : node->Children)
+			{
+				if (face != nullptr) face->status = status;
+			}
+			return false;
+		}
+
+		// an added subtree, or a part of it, identical to a deleted subtree (or a part of it) is a move
+		void resolveMoves()
+		{
+			std::unordered_map<uint64_t, std::vector<TasNode*>> deletedByHash;
+			std::unordered_map<TasNode*, TasNode*> deletedParents; // nullptr for the deleted roots
+			for (auto root = deleted.rbegin(); root != deleted.rend(); ++root)
+			{
+				std::vector<TasNode*> stack(1, *root);
+				deletedParents[*root] = nullptr;
+				while (!stack.empty())
+				{
+					TasNode* node = stack.back();
+					stack.pop_back();
+					deletedByHash[subtreeHash(firstHashes, node)].push_back(node);
+					if (node->getFaceTable() != nullptr) continue;
+					for (TasNode* child : node->children())
+					{
+						if (child == nullptr) continue;
+						deletedParents[child] = node;
+						stack.push_back(child);
+					}
+				}
+			}
+			for (auto& bucket : deletedByHash)
+			{
+				std::reverse(bucket.second.begin(), bucket.second.end()); // back() is the first one in pre-order
+			}
+
+			// a deleted node can move once, and not when a node above or below it has moved: the candidates
+			// inside a moved subtree and on the path from it to its deleted root are taken with it
+			std::unordered_set<TasNode*> moved;
+			std::unordered_set<TasNode*> taken;
+			auto take = [&](TasNode* from)
+			{
+				for (TasNode* above = from; above != nullptr && taken.insert(above).second; above = deletedParents[above]) {}
+				std::vector<TasNode*> stack;
+				if (from->getFaceTable() == nullptr) stack.assign(from->Children.begin(), from->Children.end());
+				while (!stack.empty())
+				{
+					TasNode* node = stack.back();
+					stack.pop_back();
+					if (node == nullptr || !taken.insert(node).second) continue;
+					if (node->getFaceTable() == nullptr) stack.insert(stack.end(), node->Children.begin(), node->Children.end());
+				}
+			};
+			for (TasNode* root : added)
+			{
+				std::vector<TasNode*> stack(1, root);
+				while (!stack.empty())
+				{
+					TasNode* node = stack.back();
+					stack.pop_back();
+					auto it = deletedByHash.find(subtreeHash(secondHashes, node));
+					if (it != deletedByHash.end())
+					{
+						while (!it->second.empty() && taken.count(it->second.back()) != 0) it->second.pop_back();
+					}
+					if (it != deletedByHash.end() && !it->second.empty())
+					{
+						TasNode* from = it->second.back();
+						it->second.pop_back();
+						take(from);
+						moved.insert(from);
+						diff.m_entries.push_back({ DIFF_MOVED, from, node });
+						from->status = Moved;
+						node->status = Moved;
+						continue;
+					}
+					if (node == root)
+					{
+						diff.m_entries.push_back({ DIFF_ADDED, nullptr, node });
+					}
+					node->status = Added;
+					if (!walkChildren(node, Added)) continue;
+					for (TasNode* child : node->children())
+					{
+						if (child != nullptr) stack.push_back(child);
+					}
+				}
+			}
+
+			for (TasNode* root : deleted)
+			{
+				if (moved.count(root) != 0) continue;
+				diff.m_entries.push_back({ DIFF_DELETED, root, nullptr });
+				std::vector<TasNode*> stack(1, root);
+				while (!stack.empty())
+				{
+					TasNode* node = stack.back();
+					stack.pop_back();
+					if (moved.count(node) != 0) continue;
+					node->status = Deleted;
+					if (!walkChildren(node, Deleted)) continue;
+					for (TasNode* child : node->children())
+					{
+						if (child != nullptr) stack.push_back(child);
+					}
+				}
+			}
+		}
+	};
+}
+
+TreeDiff TreeDiff::compute(TasNode* first, const NodeHashes& firstHashes, TasNode* second, const NodeHashes& secondHashes)
+{
+	TreeDiff diff;
+	if (first == nullptr || second == nullptr) return diff;
+
+	DiffWalker::resetStatus(first);
+	DiffWalker::resetStatus(second);
+	DiffWalker walker{ firstHashes, secondHashes, diff, {}, {} };
+	walker.walk(first, second);
+	walker.resolveMoves();
+	return diff;
+}
+
+int TreeDiff::size()
+{
+	return (int)m_entries.size();
+}
+
+DiffKind TreeDiff::getKind(int i)
+{
+	if (i < 0 || i >= size()) return DIFF_MODIFIED;
+	return m_entries[i].kind;
+}
+
+TasNode* TreeDiff::getFirst(int i)
+{
+	if (i < 0 || i >= size()) return nullptr;
+	return m_entries[i].first;
+}
+
+TasNode* TreeDiff::getSecond(int i)
+{
+	if (i < 0 || i >= size()) return nullptr;
+	return m_entries[i].second;
+}
+
+int TreeDiff::identicalSubtrees()
+{
+	return m_identical;
+}
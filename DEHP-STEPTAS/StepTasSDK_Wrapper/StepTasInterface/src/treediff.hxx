@@ -0,0 +1,72 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="treediff.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+// DEHP STEP-TAS Adapter
+// Tree diff
+// Compares the node trees of two files top-down using the subtree hashes: a pair of subtrees with the same
+// hash is identical and skipped without looking inside, so the work follows the size of the change rather than
+// the size of the model. Children are paired by type, name and class type (in order for repeated keys).
+// The result is a compact edit script of subtree roots; an unpaired subtree deleted from one place and added
+// at another with the same hash is reported once as moved. The DataStatus of the nodes is set accordingly.
+
+#include <vector>
+#include "interface.hxx"
+
+class NodeHashes;
+
+namespace sti
+{
+	enum DiffKind
+	{
+		DIFF_ADDED,    // subtree only in the second file
+		DIFF_DELETED,  // subtree only in the first file
+		DIFF_MODIFIED, // paired node whose own content changed, its children are compared separately
+		DIFF_MOVED     // identical subtree found under another parent
+	};
+
+	// The nodes belong to the FileData they come from, the script is valid while both are alive
+	class TreeDiff
+	{
+	public:
+		int size();
+		DiffKind getKind(int i);
+		TasNode* getFirst(int i);  // nullptr for an added subtree
+		TasNode* getSecond(int i); // nullptr for a deleted subtree
+		// number of paired subtrees skipped because their hashes matched
+		int identicalSubtrees();
+
+#ifndef SWIG
+		struct Entry
+		{
+			DiffKind kind;
+			TasNode* first;
+			TasNode* second;
+		};
+		static TreeDiff compute(TasNode* first, const NodeHashes& firstHashes, TasNode* second, const NodeHashes& secondHashes);
+	private:
+		std::vector<Entry> m_entries;
+		int m_identical = 0;
+		friend struct DiffWalker;
+#endif
+	};
+}
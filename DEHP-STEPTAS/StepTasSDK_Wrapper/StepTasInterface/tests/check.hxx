@@ -0,0 +1,71 @@
+#pragma once
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="check.hxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Test checks
+// Every test is a program run by ctest. A failed CHECK prints its expression and line and the test goes
+// on, main returns testResult(): 0 when every check passed.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace sti
+{
+	namespace test
+	{
+		inline int& failureCount()
+		{
+			static int failures = 0;
+			return failures;
+		}
+
+		inline bool check(bool condition, const char* expression, const char* file, int line)
+		{
+			if (!condition)
+			{
+				std::printf("%s:%d: check failed: %s\n", file, line, expression);
+				failureCount()++;
+			}
+			return condition;
+		}
+
+		// relative to the expected value, absolute below 1
+		inline bool near(double value, double expected, double tolerance)
+		{
+			return std::fabs(value - expected) <= tolerance * std::max(1.0, std::fabs(expected));
+		}
+	}
+}
+
+#define CHECK(condition) sti::test::check((condition), #condition, __FILE__, __LINE__)
+#define CHECK_NEAR(value, expected, tolerance) \
+	sti::test::check(sti::test::near((value), (expected), (tolerance)), #value " ~ " #expected, __FILE__, __LINE__)
+
+inline int testResult()
+{
+	int failures = sti::test::failureCount();
+	if (failures != 0) std::printf("%d check(s) failed\n", failures);
+	return failures == 0 ? 0 : 1;
+}
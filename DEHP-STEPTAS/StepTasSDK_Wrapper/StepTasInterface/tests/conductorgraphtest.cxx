@@ -0,0 +1,161 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="conductorgraphtest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Conductor graph tests
+// The compressed rows of a small hand checked graph, then of a random one against an adjacency map.
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.hxx"
+#include "conductorgraph.hxx"
+
+using namespace sti;
+
+namespace
+{
+	const double NoValue = std::numeric_limits<double>::quiet_NaN();
+
+	void testSmallGraph()
+	{
+		ConductorGraph graph;
+		int a = graph.addNode("M", "A");
+		int b = graph.addNode("M", "B");
+		int c = graph.addNode("M", "C");
+		int other = graph.addNode("N", "A");
+		CHECK(graph.addNode("M", "B") == b);
+		CHECK(graph.nodeCount() == 4);
+		CHECK(graph.findNode("N", "A") == other);
+		CHECK(graph.findNode("M", "D") == -1);
+		CHECK(graph.getNodeName(c) == "C" && graph.getNodeModel(c) == "M");
+
+		graph.addConductor(c, a, 1.5);     // 0
+		graph.addConductor(a, b, 2.0);     // 1
+		graph.addConductor(b, a, 0.5);     // 2
+		graph.addConductor(a, a, 4.0);     // 3, one edge
+		graph.addConductor(b, c, NoValue); // 4
+		graph.addConductor(a, 99, 1.0);    // unknown node, ignored
+		graph.finalize();
+
+		CHECK(graph.conductorCount() == 5);
+		CHECK(graph.getConductorFrom(4) == b && graph.getConductorTo(4) == c);
+		CHECK(std::isnan(graph.getConductorValue(4)));
+		CHECK(graph.edgeCount() == 9);
+
+		std::vector<int> offsets(graph.nodeCount() + 1), neighbours(graph.edgeCount());
+		std::vector<double> values(graph.edgeCount());
+		graph.copyOffsets(offsets.data());
+		graph.copyNeighbours(neighbours.data());
+		graph.copyValues(values.data());
+		CHECK((offsets == std::vector<int>{ 0, 4, 7, 9, 9 }));
+		// sorted by neighbour, then by conductor
+		CHECK((neighbours == std::vector<int>{ a, b, b, c, a, a, c, a, b }));
+		CHECK(graph.getEdgeConductor(1) == 1 && graph.getEdgeConductor(2) == 2);
+		CHECK(values[0] == 4.0 && values[3] == 1.5);
+		CHECK(std::isnan(values[6]));
+
+		CHECK(graph.degree(a) == 4 && graph.firstEdge(b) == 4 && graph.degree(other) == 0);
+		CHECK(graph.getCoupling(a, b) == 2.5);
+		CHECK(graph.getCoupling(b, a) == 2.5);
+		CHECK(graph.getCoupling(b, c) == 0.0);
+		CHECK(graph.getCoupling(a, other) == 0.0);
+		CHECK(graph.getTotalCoupling(a) == 8.0);
+		CHECK(graph.getTotalCoupling(c) == 1.5);
+	}
+
+	void testRandomGraph()
+	{
+		const int Nodes = 2000, Conductors = 10000;
+		std::mt19937 random(7);
+		ConductorGraph graph;
+		for (int node = 0; node < Nodes; node++)
+		{
+			graph.addNode(node % 3 ? "M" : "", "N" + std::to_string(node));
+		}
+
+		std::map<std::pair<int, int>, double> coupling;
+		std::vector<double> total(Nodes, 0.0);
+		std::vector<int> degree(Nodes, 0);
+		for (int conductor = 0; conductor < Conductors; conductor++)
+		{
+			int from = random() % Nodes;
+			int to = (conductor % 50 == 0) ? from : (int)(random() % Nodes);
+			double value = (conductor % 7 == 0) ? NoValue : (random() % 1000) / 10.0;
+			graph.addConductor(from, to, value);
+			double counted = std::isnan(value) ? 0.0 : value;
+			coupling[{ from, to }] += counted;
+			total[from] += counted;
+			degree[from]++;
+			if (from != to)
+			{
+				coupling[{ to, from }] += counted;
+				total[to] += counted;
+				degree[to]++;
+			}
+		}
+		graph.finalize();
+
+		int badRows = 0;
+		for (int node = 0; node < Nodes; node++)
+		{
+			int first = graph.firstEdge(node), last = first + graph.degree(node);
+			bool good = graph.degree(node) == degree[node] && test::near(graph.getTotalCoupling(node), total[node], 1e-9);
+			for (int edge = first; edge < last; edge++)
+			{
+				int conductor = graph.getEdgeConductor(edge);
+				int from = graph.getConductorFrom(conductor), to = graph.getConductorTo(conductor);
+				good = good && (from == node || to == node) && graph.getNeighbour(edge) == (from == node ? to : from);
+				if (edge > first)
+				{
+					int previous = graph.getNeighbour(edge - 1);
+					good = good && (previous < graph.getNeighbour(edge)
+						|| (previous == graph.getNeighbour(edge) && graph.getEdgeConductor(edge - 1) < conductor));
+				}
+			}
+			if (!good) badRows++;
+		}
+		CHECK(badRows == 0);
+
+		int badPairs = 0;
+		for (const auto& pair : coupling)
+		{
+			if (!test::near(graph.getCoupling(pair.first.first, pair.first.second), pair.second, 1e-9)) badPairs++;
+		}
+		CHECK(badPairs == 0);
+		CHECK(graph.findNode("M", "N1") == 1);
+		CHECK(graph.findNode("", "N1") == -1);
+	}
+}
+
+int main()
+{
+	testSmallGraph();
+	testRandomGraph();
+	return testResult();
+}
@@ -0,0 +1,187 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="facetabletest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Face table tests
+// The columns and strings of a table, its move to another string pool, and the face rows of the node
+// table against the Face nodes created from the same table: same ids, same statuses.
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "check.hxx"
+#include "interface.hxx"
+#include "nodearena.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// creates the Face nodes of a side like FileInterface::materializeFaces
+	class FaceExpander : public NodeExpander
+	{
+	public:
+		explicit FaceExpander(NodeArena& arena) : m_arena(arena) {}
+
+		void expandNode(TasNode* node) override
+		{
+			Side* side = static_cast<Side*>(node);
+			for (int row = 0; row < side->faces.size(); row++)
+			{
+				Face* face = m_arena.create<Face>();
+				side->addChild(face);
+				face->name = side->faces.text(side->faces.getNetworkNodeId(row));
+				face->classType = side->faces.text(side->faces.getClassTypeId(row));
+				face->id = side->faces.getFaceId(row);
+				face->status = side->faceStatus();
+			}
+		}
+
+	private:
+		NodeArena& m_arena;
+	};
+
+	void fill(FaceTable& table, StringPool& strings)
+	{
+		table.setStrings(&strings);
+		table.add(11, strings.internId("N1"), strings.internId("model"), strings.internId("MGM_FACE"));
+		table.add(12, -1, -1, strings.internId("MGM_FACE"));
+		table.add(-4, strings.internId("N2"), -1, strings.internId("MGM_FACE"));
+	}
+
+	void testColumns()
+	{
+		StringPool strings;
+		FaceTable table;
+		fill(table, strings);
+		CHECK(table.size() == 3);
+		CHECK(table.getFaceId(0) == 11 && table.getFaceId(2) == -4);
+		CHECK(table.getNetworkNode(0) == "N1" && table.getModel(0) == "model" && table.getClassType(1) == "MGM_FACE");
+		CHECK(table.hasNetworkNode(0) && !table.hasNetworkNode(1));
+		CHECK(table.getNetworkNodeId(1) == -1 && table.getString(-1).empty() && table.getModel(2).empty());
+
+		std::vector<long> ids(3);
+		std::vector<int> models(3);
+		table.copyFaceIds(ids.data());
+		table.copyModelIds(models.data());
+		CHECK((ids == std::vector<long>{ 11, 12, -4 }));
+		CHECK(models[0] == strings.internId("model") && models[1] == -1 && models[2] == -1);
+
+		table.faceId(1) = -9;
+		CHECK(table.getFaceId(1) == -9);
+
+		// without a pool every string is empty
+		FaceTable bare;
+		bare.add(1, 0, 0, 0);
+		CHECK(bare.getNetworkNode(0).empty());
+	}
+
+	// a table built with the pool of a parallel fragment moves to the pool of the file
+	void testMoveStrings()
+	{
+		StringPool file;
+		file.intern("unrelated");
+		std::unordered_map<int, int> ids;
+		{
+			StringPool fragment;
+			FaceTable first;
+			FaceTable second;
+			fill(first, fragment);
+			fill(second, fragment);
+			first.moveStrings(&file, ids);
+			second.moveStrings(&file, ids);
+			CHECK(first.strings() == &file && second.strings() == &file);
+			CHECK(first.getNetworkNodeId(0) == second.getNetworkNodeId(0));
+			CHECK(first.getNetworkNodeId(0) == file.internId("N1"));
+			CHECK(first.getClassTypeId(2) == file.internId("MGM_FACE"));
+			CHECK(ids.size() == 4);
+			CHECK(second.getModel(0) == "model" && second.getNetworkNode(2) == "N2");
+			CHECK(second.getNetworkNodeId(1) == -1 && second.getModelId(2) == -1);
+		}
+	}
+
+	void testFaceStatus()
+	{
+		NodeArena arena;
+		Side* side = arena.create<Side>();
+		const DataStatus statuses[] = { Unchanged, Modified, Added, Deleted, Moved };
+		const DataStatus faces[] = { Unchanged, Unchanged, Added, Deleted, Moved };
+		for (int i = 0; i < 5; i++)
+		{
+			side->status = statuses[i];
+			CHECK(side->faceStatus() == faces[i]);
+		}
+	}
+
+	void testNodeTableRows(DataStatus sideStatus)
+	{
+		NodeArena arena;
+		StringPool strings;
+		FaceExpander expander(arena);
+		TasNode* root = arena.create<TasNode>();
+		root->id = -1;
+		Side* side = arena.create<Side>();
+		side->id = -2;
+		side->status = sideStatus;
+		root->addChild(side);
+		fill(side->faces, strings);
+		side->pendingExpansion = &expander;
+
+		NodeTable table;
+		table.build(root);
+		CHECK(table.size() == 5);
+		CHECK(side->Children.empty());
+		std::vector<long> ids(table.size());
+		std::vector<int> status(table.size());
+		std::vector<int> types(table.size());
+		std::vector<int> parents(table.size());
+		table.copyIds(ids.data());
+		table.copyStatus(status.data());
+		table.copyNodeTypes(types.data());
+		table.copyParents(parents.data());
+
+		// the face rows and the Face nodes read the same rules
+		for (int row = 2; row < 5; row++)
+		{
+			TasNode* face = table.getNode(row);
+			CHECK(face != nullptr && types[row] == FACE && parents[row] == 1);
+			CHECK(face->id == ids[row]);
+			CHECK(face->status == status[row]);
+			CHECK(status[row] == side->faceStatus());
+		}
+		CHECK(side->Children.size() == 3);
+		CHECK(ids[4] == -4);
+	}
+}
+
+int main()
+{
+	testColumns();
+	testMoveStrings();
+	testFaceStatus();
+	testNodeTableRows(Unchanged);
+	testNodeTableRows(Added);
+	testNodeTableRows(Modified);
+	return testResult();
+}
@@ -0,0 +1,215 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="geometrystoretest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Geometry store tests
+// Rows of every primitive type filled from the nodes, the columns each type uses, zero copy and copied
+// columns, the world coordinates of transformed rows, and the merge of a parallel fragment store.
+
+#include <vector>
+
+#include "check.hxx"
+#include "geometrystore.hxx"
+#include "nodearena.hxx"
+#include "transform.hxx"
+
+using namespace sti;
+
+namespace
+{
+	Point3D point(double x, double y, double z)
+	{
+		Point3D p;
+		p.x = x;
+		p.y = y;
+		p.z = z;
+		return p;
+	}
+
+	template <class T>
+	T* surface(NodeArena& arena, long id)
+	{
+		T* node = arena.create<T>();
+		node->id = id;
+		node->P1 = point(id, 0, 0);
+		node->P2 = point(id, 1, 0);
+		node->P3 = point(id, 0, 1);
+		node->side1_thickness = 0.5;
+		node->side2_material = 900 + id;
+		node->dir1_meshing = 3;
+		return node;
+	}
+
+	void testRows()
+	{
+		NodeArena arena;
+		GeometryStore store;
+		Sphere* sphere = surface<Sphere>(arena, 1);
+		sphere->Radius = 2.0;
+		sphere->StartAngle = 10.0;
+		sphere->EndAngle = 350.0;
+		sphere->ApexTruncation = 1.5;
+		Quadrilateral* quad = surface<Quadrilateral>(arena, 2);
+		quad->P4 = point(2, 1, 1);
+		Disc* disc = surface<Disc>(arena, 3);
+		disc->InnerRadius = 1.0;
+		disc->OuterRadius = 4.0;
+		store.addSurface(sphere);
+		store.addSurface(quad);
+		store.addSurface(disc);
+		store.addSurface(sphere);
+		// a plain bounded surface has no table
+		BoundedSurface* plain = arena.create<BoundedSurface>();
+		plain->id = 4;
+		store.addSurface(plain);
+
+		CHECK(store.surfaceCount() == 3);
+		CHECK(store.findSurfaceType(1) == SPHERE && store.findSurfaceType(4) == TASNODE);
+		CHECK(store.findSurfaceRow(3) == 0 && store.findSurfaceRow(4) == -1);
+		CHECK(store.getTable(TASNODE) == nullptr && store.getTable(FACE) == nullptr);
+
+		PrimitiveTable* spheres = store.getTable(SPHERE);
+		CHECK(spheres->size() == 1 && spheres->getSurfaceId(0) == 1 && spheres->findRow(1) == 0);
+		CHECK(spheres->getValue(GEO_RADIUS1, 0) == 2.0 && spheres->getValue(GEO_END_ANGLE, 0) == 350.0);
+		CHECK(spheres->getValue(GEO_APEX_TRUNCATION, 0) == 1.5 && spheres->getValue(GEO_P2Y, 0) == 1.0);
+		CHECK(spheres->getValue(GEO_SIDE1_THICKNESS, 0) == 0.5);
+		CHECK(spheres->getIndexValue(GEO_SIDE2_MATERIAL, 0) == 901 && spheres->getIndexValue(GEO_DIR1_MESHING, 0) == 3);
+		CHECK(!spheres->hasColumn(GEO_P4X) && !spheres->hasColumn(GEO_RADIUS2));
+		CHECK(spheres->columnData(GEO_RADIUS2) == nullptr && spheres->getValue(GEO_P4X, 0) == 0.0);
+
+		PrimitiveTable* quads = store.getTable(QUADRILATERAL);
+		CHECK(quads->hasColumn(GEO_P4Z) && !quads->hasColumn(GEO_RADIUS1));
+		CHECK(quads->getValue(GEO_P4X, 0) == 2.0 && quads->getValue(GEO_P4Z, 0) == 1.0);
+
+		PrimitiveTable* discs = store.getTable(DISC);
+		CHECK(discs->getValue(GEO_RADIUS1, 0) == 1.0 && discs->getValue(GEO_RADIUS2, 0) == 4.0);
+		CHECK(!discs->hasColumn(GEO_APEX_TRUNCATION));
+
+		// out of range reads
+		CHECK(spheres->getValue(GEO_RADIUS1, 1) == 0.0 && spheres->getSurfaceId(-1) == 0 && spheres->findRow(2) == -1);
+		CHECK(store.getTable(CONE)->size() == 0 && store.getTable(CONE)->surfaceIdData() == nullptr);
+	}
+
+	void testColumns()
+	{
+		NodeArena arena;
+		GeometryStore store;
+		for (long id = 10; id < 20; id++)
+		{
+			store.addSurface(surface<Triangle>(arena, id));
+		}
+		PrimitiveTable* table = store.getTable(TRIANGLE);
+		CHECK(table->size() == 10);
+
+		const double* x = table->columnData(GEO_P1X);
+		const long* ids = table->surfaceIdData();
+		std::vector<double> copy(table->size());
+		std::vector<long> copiedIds(table->size());
+		std::vector<long> materials(table->size());
+		table->copyColumn(GEO_P1X, copy.data());
+		table->copySurfaceIds(copiedIds.data());
+		table->copyIndexColumn(GEO_SIDE2_MATERIAL, materials.data());
+		bool same = true;
+		for (int row = 0; row < table->size(); row++)
+		{
+			same = same && x[row] == 10 + row && copy[row] == x[row] && ids[row] == 10 + row && copiedIds[row] == ids[row];
+			same = same && materials[row] == 910 + row;
+		}
+		CHECK(same);
+	}
+
+	void testWorld()
+	{
+		NodeArena arena;
+		GeometryStore store;
+		Transform shift = Transform::translation(100, 0, 0);
+		for (long id = 1; id <= 6; id++)
+		{
+			Rectangle* rectangle = surface<Rectangle>(arena, id);
+			// runs of rows sharing their transformation
+			if (id >= 3 && id <= 4) rectangle->transformation = &shift;
+			store.addSurface(rectangle);
+		}
+		store.computeWorldPoints();
+		PrimitiveTable* table = store.getTable(RECTANGLE);
+		const double* x = table->worldColumnData(GEO_P1X);
+		CHECK(x != nullptr && x[0] == 1.0 && x[2] == 103.0 && x[3] == 104.0 && x[4] == 5.0);
+		CHECK(table->getWorldValue(GEO_P2Y, 2) == 1.0 && table->getWorldValue(GEO_P3Z, 3) == 1.0);
+		CHECK(table->getTransform(2) == &shift && table->getTransform(0) == nullptr);
+		CHECK(table->worldColumnData(GEO_SIDE1_THICKNESS) == nullptr && table->getWorldValue(GEO_P4X, 0) == 0.0);
+
+		std::vector<double> copy(table->size());
+		table->copyWorldColumn(GEO_P1X, copy.data());
+		CHECK(copy[3] == 104.0);
+
+		// a row added later is in the next world columns
+		Rectangle* late = surface<Rectangle>(arena, 7);
+		late->transformation = &shift;
+		store.addSurface(late);
+		CHECK(table->getWorldValue(GEO_P1X, 6) == 107.0);
+	}
+
+	// the rows of a parallel fragment come after those of the file, surfaces already there are skipped
+	void testAppend()
+	{
+		NodeArena arena;
+		GeometryStore file;
+		GeometryStore fragment;
+		file.addSurface(surface<Cylinder>(arena, 1));
+		Cylinder* duplicate = surface<Cylinder>(arena, 1);
+		duplicate->Radius = 9.0;
+		fragment.addSurface(duplicate);
+		Cylinder* cylinder = surface<Cylinder>(arena, 2);
+		cylinder->Radius = 3.0;
+		fragment.addSurface(cylinder);
+		fragment.addSurface(surface<Cone>(arena, 5));
+
+		file.append(fragment);
+		CHECK(file.surfaceCount() == 3);
+		PrimitiveTable* cylinders = file.getTable(CYLINDER);
+		CHECK(cylinders->size() == 2 && cylinders->getValue(GEO_RADIUS1, 0) == 0.0);
+		CHECK(cylinders->findRow(2) == 1 && cylinders->getValue(GEO_RADIUS1, 1) == 3.0);
+		CHECK(file.findSurfaceType(5) == CONE && file.findSurfaceRow(5) == 0);
+	}
+
+	void testAngularSpan()
+	{
+		const double pi = 3.14159265358979323846;
+		CHECK_NEAR(angularSpan(0, 90), pi / 2, 1e-12);
+		CHECK_NEAR(angularSpan(270, 90), pi, 1e-12);
+		CHECK_NEAR(angularSpan(0, 360), 2 * pi, 1e-12);
+		CHECK_NEAR(angularSpan(0, 720), 2 * pi, 1e-12);
+		CHECK(angularSpan(30, 30) == 0.0);
+		CHECK(angularSpan(0, 0) == 0.0);
+	}
+}
+
+int main()
+{
+	testRows();
+	testColumns();
+	testWorld();
+	testAppend();
+	testAngularSpan();
+	return testResult();
+}
@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="loggertest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+
+// DEHP STEP-TAS Adapter
+// Native log tests
+// The run time level filter (a dropped message is not even formatted), the messages of one thread written
+// in order, every message of several threads written or counted as dropped, and a sink that flushes.
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hxx"
+#include "logger.hxx"
+
+using namespace sti;
+
+namespace
+{
+	class CollectingSink : public LogSink
+	{
+	public:
+		void write(LogLevel level, const std::string& message) override
+		{
+			// returns at once when called from the writer thread
+			if (flushInside) NativeLog::flush();
+			std::lock_guard<std::mutex> lock(mutex);
+			levels.push_back(level);
+			messages.push_back(message);
+		}
+
+		std::mutex mutex;
+		std::vector<LogLevel> levels;
+		std::vector<std::string> messages;
+		bool flushInside = false;
+	};
+
+	int formatted = 0;
+
+	int format(int value)
+	{
+		formatted++;
+		return value;
+	}
+
+	void testLevel()
+	{
+		CollectingSink sink;
+		NativeLog::setSink(&sink);
+		NativeLog::setLevel(LOG_WARNING);
+		CHECK(NativeLog::getLevel() == LOG_WARNING);
+
+		formatted = 0;
+		STI_LOG(LOG_DEBUG, "debug " << format(1));
+		STI_LOG(LOG_WARNING, "warning " << format(2));
+		STI_LOG(LOG_ERROR, "error " << format(3));
+		NativeLog::flush();
+		CHECK(formatted == 2);
+		CHECK(sink.messages.size() == 2);
+		CHECK(sink.messages[0] == "warning 2" && sink.levels[0] == LOG_WARNING);
+		CHECK(sink.messages[1] == "error 3" && sink.levels[1] == LOG_ERROR);
+
+		// LOG_OFF drops everything
+		NativeLog::setLevel(LOG_OFF);
+		STI_LOG(LOG_ERROR, "error " << format(4));
+		NativeLog::flush();
+		CHECK(formatted == 2 && sink.messages.size() == 2);
+
+		NativeLog::setLevel(LOG_INFO);
+		NativeLog::setSink(nullptr);
+	}
+
+	void testThreads()
+	{
+		CollectingSink sink;
+		sink.flushInside = true;
+		NativeLog::setSink(&sink);
+		long dropped = NativeLog::droppedCount();
+
+		const int Threads = 4, Messages = 2000;
+		std::vector<std::thread> threads;
+		for (int t = 0; t < Threads; t++)
+		{
+			threads.emplace_back([t] {
+				for (int i = 0; i < Messages; i++) STI_LOG(LOG_INFO, t << " " << i);
+			});
+		}
+		for (std::thread& thread : threads) thread.join();
+		NativeLog::flush();
+		NativeLog::setSink(nullptr);
+
+		// the writer reports the dropped messages in a warning of its own
+		long written = 0;
+		bool reported = false;
+		std::vector<int> last(Threads, -1);
+		bool ordered = true;
+		for (size_t m = 0; m < sink.messages.size(); m++)
+		{
+			const std::string& message = sink.messages[m];
+			if (sink.levels[m] == LOG_WARNING)
+			{
+				reported = true;
+				continue;
+			}
+			written++;
+			// the messages of one thread keep their order
+			int t = std::stoi(message);
+			int i = std::stoi(message.substr(message.find(' ') + 1));
+			ordered = ordered && i > last[t];
+			last[t] = i;
+		}
+		CHECK(ordered);
+		long lost = NativeLog::droppedCount() - dropped;
+		CHECK(written + lost == Threads * Messages);
+		CHECK(lost == 0 || reported);
+	}
+}
+
+int main()
+{
+	testLevel();
+	testThreads();
+	return testResult();
+}
@@ -0,0 +1,288 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="masspropertiestest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Mass properties tests
+// The area of every primitive type against its closed form, on enough rows for the AVX2 lanes and the
+// scalar tail, and the side masses from the material densities.
+
+#include <cmath>
+#include <functional>
+
+#include "check.hxx"
+#include "geometrystore.hxx"
+#include "massproperties.hxx"
+#include "materialindex.hxx"
+#include "nodearena.hxx"
+
+using namespace sti;
+
+namespace
+{
+	const double Pi = 3.14159265358979323846;
+
+	Point3D point(double x, double y, double z)
+	{
+		Point3D p;
+		p.x = x;
+		p.y = y;
+		p.z = z;
+		return p;
+	}
+
+	// fills one row of the table, the expected area is a function of the scale s
+	typedef std::function<void(PrimitiveTable&, int row, double s)> RowMaker;
+
+	struct AreaCase
+	{
+		NodeType type;
+		RowMaker make;
+		std::function<double(double s)> area;
+	};
+
+	// Rows 0-7 go through the AVX2 kernel when the processor has it, row 8 through the scalar one.
+	// Rows 0 and 8 hold the same surface, the two kernels must agree exactly
+	void checkAreas(const AreaCase& areaCase)
+	{
+		const int Rows = 9;
+		GeometryStore geometry;
+		PrimitiveTable& table = *geometry.getTable(areaCase.type);
+		for (int row = 0; row < Rows; row++)
+		{
+			table.addRow(1000 + row);
+			areaCase.make(table, row, 1.0 + row % 4);
+		}
+
+		NodeArena arena;
+		MaterialIndex materials;
+		MassProperties mass;
+		mass.build(arena.create<TasNode>(), geometry, materials);
+		const double* area = mass.areaData(areaCase.type);
+		CHECK(area != nullptr);
+		if (area == nullptr) return;
+		for (int row = 0; row < Rows; row++)
+		{
+			CHECK_NEAR(area[row], areaCase.area(1.0 + row % 4), 1e-12);
+		}
+		CHECK(area[0] == area[8]);
+	}
+
+	void setAngles(PrimitiveTable& table, int row, double start, double end)
+	{
+		table.set(GEO_START_ANGLE, row, start);
+		table.set(GEO_END_ANGLE, row, end);
+	}
+
+	void testClosedForms()
+	{
+		checkAreas({ RECTANGLE,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(0, row, point(1, 2, 3));
+				t.setPoint(1, row, point(1 + 2 * s, 2, 3));
+				t.setPoint(2, row, point(1, 2, 3 + 3 * s));
+			},
+			[](double s) { return 6 * s * s; } });
+		checkAreas({ TRIANGLE,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(0, row, point(0, 0, 0));
+				t.setPoint(1, row, point(2 * s, 0, 0));
+				t.setPoint(2, row, point(s, 3 * s, 0));
+			},
+			[](double s) { return 3 * s * s; } });
+		checkAreas({ QUADRILATERAL,
+			[](PrimitiveTable& t, int row, double s) {
+				// a trapezoid: (2s + 4s) / 2 * 3s
+				t.setPoint(0, row, point(0, 0, 0));
+				t.setPoint(1, row, point(4 * s, 0, 0));
+				t.setPoint(2, row, point(3 * s, 3 * s, 0));
+				t.setPoint(3, row, point(s, 3 * s, 0));
+			},
+			[](double s) { return 9 * s * s; } });
+		checkAreas({ CYLINDER,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, 2 * s));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS1, row, s);
+				setAngles(t, row, 0, 360);
+			},
+			[](double s) { return 2 * Pi * s * 2 * s; } });
+		checkAreas({ CONE,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, s));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS1, row, s);
+				setAngles(t, row, 0, 360);
+			},
+			[](double s) { return Pi * s * s * std::sqrt(2.0); } });
+		checkAreas({ DISC,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, 1));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS1, row, s);
+				t.set(GEO_RADIUS2, row, 2 * s);
+				setAngles(t, row, 90, 270);
+			},
+			[](double s) { return 0.5 * Pi * (4 * s * s - s * s); } });
+		checkAreas({ SPHERE,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, 1));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS1, row, s);
+				t.set(GEO_BASE_TRUNCATION, row, -2 * s); // clamped to the sphere
+				t.set(GEO_APEX_TRUNCATION, row, s);
+				setAngles(t, row, 0, 360);
+			},
+			[](double s) { return 4 * Pi * s * s; } });
+		checkAreas({ PARABOLOID,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, s));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS1, row, s);
+				setAngles(t, row, 0, 360);
+			},
+			// pi R / (6 h^2) ((R^2 + 4 h^2)^3/2 - R^3) with R = h = s
+			[](double s) { return Pi * s * s / 6 * (5 * std::sqrt(5.0) - 1); } });
+	}
+
+	// partial surfaces, a single row each
+	void testTruncations()
+	{
+		GeometryStore geometry;
+		PrimitiveTable& sphere = *geometry.getTable(SPHERE);
+		sphere.addRow(1);
+		sphere.set(GEO_RADIUS1, 0, 2);
+		sphere.set(GEO_BASE_TRUNCATION, 0, 0);
+		sphere.set(GEO_APEX_TRUNCATION, 0, 2);
+		setAngles(sphere, 0, 0, 90);
+
+		PrimitiveTable& paraboloid = *geometry.getTable(PARABOLOID);
+		paraboloid.addRow(2);
+		paraboloid.setPoint(1, 0, point(0, 0, 1));
+		paraboloid.set(GEO_RADIUS1, 0, 1);
+		paraboloid.set(GEO_APEX_TRUNCATION, 0, 0.5);
+		setAngles(paraboloid, 0, 0, 360);
+
+		PrimitiveTable& cylinder = *geometry.getTable(CYLINDER);
+		cylinder.addRow(3);
+		cylinder.setPoint(1, 0, point(0, 0, 1));
+		cylinder.set(GEO_RADIUS1, 0, -1); // the sign of a radius is ignored
+		setAngles(cylinder, 0, 270, 90); // wraps around: half a turn
+
+		NodeArena arena;
+		MaterialIndex materials;
+		MassProperties mass;
+		mass.build(arena.create<TasNode>(), geometry, materials);
+		// a quarter of the upper hemisphere
+		CHECK_NEAR(mass.areaData(SPHERE)[0], 0.25 * 2 * Pi * 2 * 2, 1e-12);
+		// between the heights 0.5 and 1: pi R^4 / (6 h^2) (u1^3/2 - u0^3/2), u = 1 + 4 h z / R^2
+		CHECK_NEAR(mass.areaData(PARABOLOID)[0], Pi / 6 * (5 * std::sqrt(5.0) - 3 * std::sqrt(3.0)), 1e-12);
+		CHECK_NEAR(mass.areaData(CYLINDER)[0], Pi, 1e-12);
+		CHECK(mass.areaData(CONE) == nullptr);
+	}
+
+	// an end before the start wraps around, an end equal to the start is empty, in both kernels
+	void testSpans()
+	{
+		checkAreas({ CYLINDER,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, 1));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS1, row, s);
+				setAngles(t, row, 300, 60);
+			},
+			[](double s) { return Pi / 3 * 2 * s; } });
+		checkAreas({ CONE,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, s));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS1, row, s);
+				setAngles(t, row, 45, 45);
+			},
+			[](double) { return 0.0; } });
+		checkAreas({ DISC,
+			[](PrimitiveTable& t, int row, double s) {
+				t.setPoint(1, row, point(0, 0, 1));
+				t.setPoint(2, row, point(1, 0, 0));
+				t.set(GEO_RADIUS2, row, s);
+				setAngles(t, row, -90, 0);
+			},
+			[](double s) { return 0.25 * Pi * s * s; } });
+	}
+
+	void testMasses()
+	{
+		MaterialIndex materials;
+		materials.reset({ "aluminium", "paint" }, { "default" });
+		materials.set(0, 0, MQ_MASS_DENSITY, 2700.0);
+		materials.setStepId(71, 0);
+		materials.setStepId(72, 1); // no density
+
+		NodeArena arena;
+		GeometryStore geometry;
+		TasNode* root = arena.create<TasNode>();
+		root->id = 1;
+		for (int row = 0; row < 6; row++)
+		{
+			Rectangle* surface = arena.create<Rectangle>();
+			surface->id = 10 + row;
+			surface->P2 = point(2, 0, 0);
+			surface->P3 = point(0, 0.5, 0);
+			surface->side1_thickness = 0.001 * (row + 1);
+			surface->side1_material = 71;
+			if (row == 5)
+			{
+				// a thickness without a density
+				surface->side2_thickness = 0.002;
+				surface->side2_material = 72;
+			}
+			root->addChild(surface);
+			geometry.addSurface(surface);
+		}
+		MassProperties mass;
+		mass.build(root, geometry, materials);
+
+		double total = 0.0;
+		for (int row = 0; row < 6; row++)
+		{
+			double expected = 1.0 * 0.001 * (row + 1) * 2700.0;
+			CHECK_NEAR(mass.getSurfaceMass(10 + row), expected, 1e-12);
+			CHECK_NEAR(mass.getSurfaceArea(10 + row), 1.0, 1e-12);
+			total += expected;
+		}
+		CHECK(mass.nodeCount() == 7);
+		CHECK(mass.getSurfaceCount(1) == 6);
+		CHECK_NEAR(mass.getArea(1), 6.0, 1e-12);
+		CHECK_NEAR(mass.getMass(1), total, 1e-12);
+		CHECK(mass.getMissingDensityCount(1) == 1);
+		CHECK(mass.getMissingDensityCount(14) == 0);
+	}
+}
+
+int main()
+{
+	testClosedForms();
+	testTruncations();
+	testSpans();
+	testMasses();
+	return testResult();
+}
@@ -0,0 +1,111 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="materialindextest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+
+// DEHP STEP-TAS Adapter
+// Material index tests
+// Lookups by id, STEP id and environment name, missing values as NaN, the last environment defining a
+// quantity, and the bounds of every accessor.
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "check.hxx"
+#include "materialindex.hxx"
+
+using namespace sti;
+
+namespace
+{
+	void testLookups()
+	{
+		MaterialIndex index;
+		index.reset({ "aluminium", "kapton", "aluminium" }, { "ground", "orbit" });
+		CHECK(index.materialCount() == 3 && index.environmentCount() == 2);
+		// the first row wins for a repeated id
+		CHECK(index.findMaterial("aluminium") == 0 && index.findMaterial("kapton") == 1);
+		CHECK(index.findMaterial("steel") == -1);
+		CHECK(index.findEnvironment("orbit") == 1 && index.findEnvironment("space") == -1);
+		CHECK(index.getMaterialId(1) == "kapton" && index.getMaterialId(3).empty());
+		CHECK(index.getEnvironmentName(0) == "ground" && index.getEnvironmentName(-1).empty());
+
+		index.setStepId(42, 1);
+		index.setStepId(43, 7); // no such row
+		CHECK(index.findMaterialByStepId(42) == 1);
+		CHECK(index.findMaterialByStepId(43) == -1);
+		CHECK(index.stepRows().size() == 1);
+
+		// a reset forgets the STEP ids
+		index.reset({ "kapton" }, { "ground" });
+		CHECK(index.findMaterialByStepId(42) == -1 && index.findMaterial("kapton") == 0);
+	}
+
+	void testValues()
+	{
+		MaterialIndex index;
+		index.reset({ "aluminium", "kapton" }, { "ground", "orbit", "eol" });
+		CHECK(!index.hasValue(0, 0, MQ_MASS_DENSITY) && std::isnan(index.getValue(0, 0, MQ_MASS_DENSITY)));
+
+		index.set(0, 0, MQ_MASS_DENSITY, 2700.0);
+		index.set(0, 1, MQ_SOLAR_ABSORPTANCE, 0.3);
+		index.set(0, 0, MQ_SOLAR_ABSORPTANCE, 0.2);
+		index.set(1, 2, MQ_THERMAL_CONDUCTIVITY, 0.12);
+		// out of range, ignored
+		index.set(2, 0, MQ_MASS_DENSITY, 1.0);
+		index.set(0, 3, MQ_MASS_DENSITY, 1.0);
+		index.set(0, 0, MQ_COUNT, 1.0);
+
+		CHECK(index.getValue(0, 0, MQ_MASS_DENSITY) == 2700.0 && index.hasValue(0, 0, MQ_MASS_DENSITY));
+		CHECK(!index.hasValue(1, 0, MQ_MASS_DENSITY));
+		CHECK(std::isnan(index.getValue(2, 0, MQ_MASS_DENSITY)) && std::isnan(index.getValue(0, 0, MQ_COUNT)));
+		// the last environment that defines the quantity
+		CHECK(index.getLastValue(0, MQ_SOLAR_ABSORPTANCE) == 0.3);
+		CHECK(index.getLastValue(0, MQ_MASS_DENSITY) == 2700.0);
+		CHECK(index.getLastValue(1, MQ_THERMAL_CONDUCTIVITY) == 0.12);
+		CHECK(std::isnan(index.getLastValue(1, MQ_INFRARED_EMITTANCE)));
+
+		std::vector<double> values(index.environmentCount());
+		index.copyValues(0, MQ_SOLAR_ABSORPTANCE, values.data());
+		CHECK(values[0] == 0.2 && values[1] == 0.3 && std::isnan(values[2]));
+	}
+
+	void testQuantityNames()
+	{
+		CHECK(std::strcmp(MaterialIndex::quantityName(MQ_MASS_DENSITY), "mass_density") == 0);
+		CHECK(std::strcmp(MaterialIndex::quantityName(MQ_INFRARED_EMITTANCE), "infra_red_emittance") == 0);
+		CHECK(std::strcmp(MaterialIndex::quantityName(MQ_COUNT), "") == 0);
+		for (int quantity = 0; quantity < MQ_COUNT; quantity++)
+		{
+			CHECK(std::strlen(MaterialIndex::quantityName((MaterialQuantity)quantity)) > 0);
+		}
+	}
+}
+
+int main()
+{
+	testLookups();
+	testValues();
+	testQuantityNames();
+	return testResult();
+}
@@ -0,0 +1,161 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodearenatest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Node arena tests
+// Value initialization and alignment of the objects, block use, destruction in reverse creation order
+// on clear and on destruction, and the hand over of the objects of a fragment arena.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "check.hxx"
+#include "interface.hxx"
+#include "nodearena.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// records the order in which the objects are destroyed
+	std::vector<int> destroyed;
+
+	struct Tracked
+	{
+		explicit Tracked(int number) : number(number) {}
+		~Tracked() { destroyed.push_back(number); }
+		int number;
+		std::string text = "a string long enough to be allocated on the heap";
+	};
+
+	struct alignas(32) Wide
+	{
+		double values[4];
+	};
+
+	void testInitialization()
+	{
+		NodeArena arena;
+		TasNode* node = arena.create<TasNode>();
+		CHECK(node->id == 0 && node->entity == 0 && node->status == Unchanged);
+		CHECK(node->parent == nullptr && node->pendingExpansion == nullptr && node->Children.empty());
+		Cylinder* cylinder = arena.create<Cylinder>();
+		CHECK(cylinder->Radius == 0.0 && cylinder->P2.z == 0.0 && cylinder->side1_thickness == 0.0);
+		CHECK(arena.objectCount() == 2);
+
+		// after an odd sized object, whatever the offset in the block
+		for (int i = 0; i < 10; i++)
+		{
+			arena.create<char>('x');
+			Wide* wide = arena.create<Wide>();
+			CHECK(reinterpret_cast<uintptr_t>(wide) % alignof(Wide) == 0);
+			CHECK(wide->values[3] == 0.0);
+		}
+	}
+
+	void testBlocks()
+	{
+		NodeArena arena(1024);
+		for (int i = 0; i < 100; i++) arena.create<double>(1.0);
+		CHECK(arena.blockCount() == 1);
+		for (int i = 0; i < 100; i++) arena.create<double>(1.0);
+		CHECK(arena.blockCount() == 2);
+
+		// an object larger than the blocks gets a block of its own
+		struct Large
+		{
+			char bytes[4096];
+		};
+		Large* large = arena.create<Large>();
+		CHECK(large != nullptr && large->bytes[4095] == 0);
+		CHECK(arena.blockCount() == 3);
+		CHECK(arena.bytesReserved() >= 2 * 1024 + 4096);
+
+		// the reserved bytes take the next objects without a new block
+		arena.reserve(50 * sizeof(double));
+		size_t blocks = arena.blockCount();
+		for (int i = 0; i < 50; i++) arena.create<double>(2.0);
+		CHECK(arena.blockCount() == blocks);
+
+		arena.clear();
+		CHECK(arena.objectCount() == 0 && arena.blockCount() == 0 && arena.bytesReserved() == 0);
+	}
+
+	void testDestruction()
+	{
+		destroyed.clear();
+		{
+			NodeArena arena;
+			for (int i = 0; i < 3; i++) arena.create<Tracked>(i);
+			arena.create<double>(0.0); // trivially destructible, not recorded
+			CHECK(destroyed.empty());
+		}
+		CHECK((destroyed == std::vector<int>{ 2, 1, 0 }));
+
+		destroyed.clear();
+		NodeArena arena;
+		arena.create<Tracked>(7);
+		arena.clear();
+		CHECK((destroyed == std::vector<int>{ 7 }));
+		arena.clear();
+		CHECK(destroyed.size() == 1);
+	}
+
+	// a parallel task builds a fragment in its own arena, the owner takes it over
+	void testAdopt()
+	{
+		destroyed.clear();
+		{
+			NodeArena owner(256);
+			Tracked* first = owner.create<Tracked>(1);
+			std::vector<Tracked*> adopted;
+			{
+				NodeArena fragment(256);
+				for (int i = 10; i < 20; i++) adopted.push_back(fragment.create<Tracked>(i));
+				owner.adopt(fragment);
+				CHECK(fragment.objectCount() == 0 && fragment.blockCount() == 0);
+				owner.adopt(owner);
+			}
+			CHECK(destroyed.empty());
+			CHECK(owner.objectCount() == 11);
+			CHECK(first->number == 1 && adopted[9]->number == 19);
+
+			// the owner keeps filling its own block
+			size_t blocks = owner.blockCount();
+			owner.create<char>('x');
+			CHECK(owner.blockCount() == blocks);
+		}
+		CHECK(destroyed.size() == 11);
+		CHECK(destroyed.front() == 19 && destroyed.back() == 1);
+	}
+}
+
+int main()
+{
+	testInitialization();
+	testBlocks();
+	testDestruction();
+	testAdopt();
+	return testResult();
+}
@@ -0,0 +1,150 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodeindextest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Node index tests
+// Lookups by id and by name path: unnamed nodes transparent, empty path components, the first node in
+// pre-order for a duplicate, and the faces of a pending side found without creating them first.
+
+#include "check.hxx"
+#include "interface.hxx"
+#include "nodearena.hxx"
+#include "nodeindex.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// creates the Face nodes of a side like FileInterface::materializeFaces
+	class FaceExpander : public NodeExpander
+	{
+	public:
+		explicit FaceExpander(NodeArena& arena) : m_arena(arena) {}
+
+		void expandNode(TasNode* node) override
+		{
+			Side* side = static_cast<Side*>(node);
+			for (int row = 0; row < side->faces.size(); row++)
+			{
+				Face* face = m_arena.create<Face>();
+				side->addChild(face);
+				face->id = side->faces.getFaceId(row);
+				face->name = side->faces.text(side->faces.getNetworkNodeId(row));
+			}
+		}
+
+	private:
+		NodeArena& m_arena;
+	};
+
+	struct Tree
+	{
+		NodeArena arena;
+		StringPool strings;
+		FaceExpander expander{ arena };
+		TasNode* root;
+		TasNode* model;
+		TasNode* unnamed;
+		TasNode* panel;
+		TasNode* duplicate;
+		Side* side;
+
+		// root / model / (unnamed) / panel / Side 1 / faces N1, N2; a second panel after the first
+		Tree()
+		{
+			root = node<TasNode>(-1, "", nullptr);
+			model = node<TasNode>(10, "model", root);
+			unnamed = node<TasNode>(11, "", model);
+			panel = node<BoundedSurface>(12, "panel", unnamed);
+			side = node<Side>(13, "Side 1", panel);
+			duplicate = node<BoundedSurface>(14, "panel", model);
+			side->faces.setStrings(&strings);
+			side->faces.add(100, strings.internId("N1"), -1, -1);
+			side->faces.add(101, strings.internId("N2"), -1, -1);
+			side->faces.add(102, -1, -1, -1);
+			side->pendingExpansion = &expander;
+		}
+
+		template <class T>
+		T* node(long id, const char* name, TasNode* parent)
+		{
+			T* created = arena.create<T>();
+			created->id = id;
+			created->name = strings.intern(name);
+			if (parent != nullptr) parent->addChild(created);
+			return created;
+		}
+	};
+
+	void testIds()
+	{
+		Tree tree;
+		NodeIndex index;
+		CHECK(!index.isBuilt());
+		index.build(tree.root);
+		CHECK(index.isBuilt());
+		CHECK(index.findById(-1) == tree.root && index.findById(12) == tree.panel && index.findById(11) == tree.unnamed);
+		CHECK(index.findById(999) == nullptr);
+		// the faces are indexed from the table, the lookup creates them
+		CHECK(tree.side->Children.empty());
+		TasNode* face = index.findById(101);
+		CHECK(face != nullptr && face->id == 101 && face->name == "N2");
+		CHECK(tree.side->Children.size() == 3);
+		CHECK(index.findById(102) == tree.side->Children[2]);
+
+		index.clear();
+		CHECK(!index.isBuilt() && index.findById(12) == nullptr);
+	}
+
+	void testPaths()
+	{
+		Tree tree;
+		NodeIndex index;
+		index.build(tree.root);
+		// the unnamed level does not appear in the path, the first panel in pre-order wins
+		CHECK(index.resolvePath("model/panel") == tree.panel);
+		CHECK(index.resolvePath("/model//panel/") == tree.panel);
+		CHECK(index.resolvePath("model/panel/Side 1") == tree.side);
+		CHECK(index.resolvePath("model/panel/Side 1/N1") == tree.side->children()[0]);
+		CHECK(index.resolvePath("model") == tree.model);
+		CHECK(index.resolvePath("panel") == nullptr);
+		CHECK(index.resolvePath("model/missing") == nullptr);
+		CHECK(index.resolvePath("model/panel/Side 1/N3") == nullptr);
+		CHECK(index.resolvePath("") == nullptr);
+	}
+
+	void testEmpty()
+	{
+		NodeIndex index;
+		index.build(nullptr);
+		CHECK(index.findById(0) == nullptr && index.resolvePath("a") == nullptr);
+	}
+}
+
+int main()
+{
+	testIds();
+	testPaths();
+	testEmpty();
+	return testResult();
+}
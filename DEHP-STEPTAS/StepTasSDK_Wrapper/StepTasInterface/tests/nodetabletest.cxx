@@ -0,0 +1,194 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="nodetabletest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Node table tests
+// Pre-order rows with their parents, types and UTF-8 strings, a lazy level read by the build, the face
+// rows of a pending side, and the status column refreshed after the tree is marked.
+
+#include <string>
+#include <vector>
+
+#include "check.hxx"
+#include "interface.hxx"
+#include "nodearena.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// reads a pending level like FileInterface::expandNode: a compound gets one sphere, a side its faces
+	class Expander : public NodeExpander
+	{
+	public:
+		Expander(NodeArena& arena, StringPool& strings) : m_arena(arena), m_strings(strings) {}
+
+		void expandNode(TasNode* node) override
+		{
+			m_expanded++;
+			if (Side* side = dynamic_cast<Side*>(node))
+			{
+				for (int row = 0; row < side->faces.size(); row++)
+				{
+					Face* face = m_arena.create<Face>();
+					side->addChild(face);
+					face->id = side->faces.getFaceId(row);
+					face->status = side->faceStatus();
+				}
+				return;
+			}
+			Sphere* sphere = m_arena.create<Sphere>();
+			sphere->id = 40;
+			sphere->name = m_strings.intern("lazy");
+			node->addChild(sphere);
+		}
+
+		int expanded() const { return m_expanded; }
+
+	private:
+		NodeArena& m_arena;
+		StringPool& m_strings;
+		int m_expanded = 0;
+	};
+
+	struct Tree
+	{
+		NodeArena arena;
+		StringPool strings;
+		Expander expander{ arena, strings };
+		TasNode* root;
+		TasNode* compound;
+		BoundedSurface* surface;
+		Side* side;
+
+		Tree()
+		{
+			root = node<TasNode>(1, "root", nullptr);
+			compound = node<TasNode>(2, "compound", root);
+			surface = node<BoundedSurface>(3, "caf\xE9", root);
+			surface->label = strings.intern("label");
+			surface->classType = strings.intern("MGM_SURFACE");
+			surface->description = strings.intern("text");
+			side = node<Side>(4, "Side 1", surface);
+			side->faces.setStrings(&strings);
+			side->faces.add(50, strings.internId("N1"), -1, strings.internId("MGM_FACE"));
+			side->faces.add(51, -1, -1, strings.internId("MGM_FACE"));
+			side->pendingExpansion = &expander;
+			compound->pendingExpansion = &expander;
+		}
+
+		template <class T>
+		T* node(long id, const char* name, TasNode* parent)
+		{
+			T* created = arena.create<T>();
+			created->id = id;
+			created->name = strings.intern(name);
+			if (parent != nullptr) parent->addChild(created);
+			return created;
+		}
+	};
+
+	std::string field(NodeTable& table, int row, NodeTableField f)
+	{
+		std::vector<int> offsets(table.size() * FIELD_COUNT + 1);
+		std::vector<unsigned char> blob(table.blobSize());
+		table.copyStringOffsets(offsets.data());
+		table.copyBlob(blob.data());
+		int at = row * FIELD_COUNT + f;
+		return std::string(blob.begin() + offsets[at], blob.begin() + offsets[at + 1]);
+	}
+
+	void testRows()
+	{
+		Tree tree;
+		NodeTable table;
+		table.build(tree.root);
+
+		// root, compound, its lazy sphere, surface, side, two faces
+		CHECK(table.size() == 7);
+		CHECK(tree.expander.expanded() == 1);
+		CHECK(tree.side->Children.empty());
+
+		std::vector<long> ids(table.size());
+		std::vector<int> parents(table.size());
+		std::vector<int> types(table.size());
+		table.copyIds(ids.data());
+		table.copyParents(parents.data());
+		table.copyNodeTypes(types.data());
+		CHECK((ids == std::vector<long>{ 1, 2, 40, 3, 4, 50, 51 }));
+		CHECK((parents == std::vector<int>{ -1, 0, 1, 0, 3, 4, 4 }));
+		CHECK((types == std::vector<int>{ TASNODE, TASNODE, SPHERE, BOUNDEDSURFACE, TASNODE, FACE, FACE }));
+
+		CHECK(field(table, 2, FIELD_NAME) == "lazy");
+		CHECK(field(table, 3, FIELD_NAME) == "caf\xC3\xA9");
+		CHECK(field(table, 3, FIELD_LABEL) == "label");
+		CHECK(field(table, 3, FIELD_CLASSTYPE) == "MGM_SURFACE");
+		CHECK(field(table, 3, FIELD_DESCRIPTION) == "text");
+		CHECK(field(table, 5, FIELD_NAME) == "N1" && field(table, 5, FIELD_LABEL) == "Node on Face");
+		CHECK(field(table, 6, FIELD_NAME).empty() && field(table, 6, FIELD_CLASSTYPE) == "MGM_FACE");
+
+		CHECK(table.getNode(3) == tree.surface);
+		CHECK(table.getNode(-1) == nullptr && table.getNode(7) == nullptr);
+		// a face row creates the Face nodes of its side
+		TasNode* face = table.getNode(6);
+		CHECK(face != nullptr && face->id == 51 && tree.side->Children.size() == 2);
+
+		table.build(nullptr);
+		CHECK(table.size() == 0 && table.blobSize() == 0);
+	}
+
+	std::vector<int> statuses(NodeTable& table)
+	{
+		std::vector<int> status(table.size());
+		table.copyStatus(status.data());
+		return status;
+	}
+
+	void testRefreshStatus()
+	{
+		Tree tree;
+		NodeTable table;
+		table.build(tree.root);
+		CHECK((statuses(table) == std::vector<int>{ 0, 0, 0, 0, 0, 0, 0 }));
+
+		// marked after the build, faces not created
+		tree.surface->status = Modified;
+		tree.side->status = Added;
+		table.refreshStatus();
+		CHECK((statuses(table) == std::vector<int>{ Unchanged, Unchanged, Unchanged, Modified, Added, Added, Added }));
+
+		// the created faces keep their own status
+		tree.side->status = Modified;
+		table.getNode(5);
+		tree.side->Children[1]->status = Deleted;
+		table.refreshStatus();
+		CHECK((statuses(table) == std::vector<int>{ Unchanged, Unchanged, Unchanged, Modified, Modified, Unchanged, Deleted }));
+	}
+}
+
+int main()
+{
+	testRows();
+	testRefreshStatus();
+	return testResult();
+}
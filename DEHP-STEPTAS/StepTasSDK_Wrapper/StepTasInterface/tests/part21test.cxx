@@ -0,0 +1,131 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="part21test.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Part 21 tests
+// The header reader and the entity scanner on small file images: text that looks like a DATA section
+// inside the header strings, named DATA sections, '=' inside strings, and enough instances to cross the
+// SIMD block boundaries at every offset.
+
+#include <cstring>
+#include <string>
+
+#include "check.hxx"
+#include "part21.hxx"
+
+using namespace sti;
+
+namespace
+{
+	const unsigned char* bytes(const std::string& text)
+	{
+		return (const unsigned char*)text.data();
+	}
+
+	const std::string Header =
+		"ISO-10303-21;\n"
+		"HEADER;\n"
+		"FILE_DESCRIPTION(('x DATA; #1=BAR(1); y','second'),'2;1');\n"
+		"FILE_NAME('a.stp','2020-01-01T00:00:00',('me','you'),('org'),'pp','sys','auth');\n"
+		"FILE_SCHEMA(('TAS'));\n"
+		"ENDSEC;\n";
+
+	void testHeader()
+	{
+		std::string file = Header + "DATA;\n#1=FOO(1);\nENDSEC;\nEND-ISO-10303-21;\n";
+		FileHeader header;
+		CHECK(readPart21Header(bytes(file), file.size(), header));
+		CHECK(header.name == "a.stp");
+		CHECK(header.timeStamp == "2020-01-01T00:00:00");
+		// lists one item per line
+		CHECK(header.author == "me\nyou\n");
+		CHECK(header.organization == "org\n");
+		CHECK(header.preprocessorVersion == "pp");
+		CHECK(header.originatingSystem == "sys");
+		CHECK(header.authorization == "auth");
+		CHECK(header.description == "x DATA; #1=BAR(1); y\nsecond\n");
+		CHECK(header.schema == "TAS\n");
+
+		std::string truncated = "ISO-10303-21;\nHEADER;\nFILE_NAME('b.stp'";
+		FileHeader partial;
+		CHECK(!readPart21Header(bytes(truncated), truncated.size(), partial));
+		std::string empty;
+		CHECK(!readPart21Header(bytes(empty), 0, partial));
+	}
+
+	void testScan()
+	{
+		std::string file = Header
+			+ "DATA;\n"
+			"#1=FOO(1);\n"
+			"#2=FOO(#1);\n"
+			"#3=(A()B());\n"
+			"#4=Foo('a=b');\n"
+			"#5 = BAR ( 'x' ) ;\n"
+			"ENDSEC;\n"
+			"END-ISO-10303-21;\n";
+		FileStatistics statistics;
+		CHECK(scanPart21Entities(bytes(file), file.size(), statistics));
+		CHECK(statistics.fileSize() == (long long)file.size());
+		// the complex instance is only in the total, BAR of the header is not counted
+		CHECK(statistics.entityCount() == 5);
+		CHECK(statistics.typeCount() == 2);
+		CHECK(statistics.getTypeName(0) == "BAR" && statistics.getTypeCount(0) == 1);
+		CHECK(statistics.countOf("foo") == 3);
+		CHECK(statistics.countOf("B") == 0);
+
+		std::string named = "ISO-10303-21;\nHEADER;\nFILE_DESCRIPTION(('x'),'2;1');\nENDSEC;\n"
+			"DATA('d',('TAS'));\n#1=FOO(1);\nENDSEC;\n";
+		FileStatistics namedStatistics;
+		CHECK(scanPart21Entities(bytes(named), named.size(), namedStatistics));
+		CHECK(namedStatistics.countOf("FOO") == 1);
+
+		std::string noData = "ISO-10303-21;\nHEADER;\nENDSEC;\nEND-ISO-10303-21;\n";
+		FileStatistics noStatistics;
+		CHECK(!scanPart21Entities(bytes(noData), noData.size(), noStatistics));
+	}
+
+	void testBlocks()
+	{
+		std::string file = "ISO-10303-21;\nHEADER;\nFILE_DESCRIPTION((''),'2;1');\nENDSEC;\nDATA;\n";
+		for (int id = 1; id <= 1000; id++)
+		{
+			file += "#" + std::to_string(id) + "=" + (id % 3 ? "MGM_FACE" : "NRF_NODE") + "(" + std::string(id % 37, ' ')
+				+ "'=#" + std::to_string(id) + "');\n";
+		}
+		file += "ENDSEC;\n";
+		FileStatistics statistics;
+		CHECK(scanPart21Entities(bytes(file), file.size(), statistics));
+		CHECK(statistics.entityCount() == 1000);
+		CHECK(statistics.countOf("MGM_FACE") == 667);
+		CHECK(statistics.countOf("NRF_NODE") == 333);
+	}
+}
+
+int main()
+{
+	testHeader();
+	testScan();
+	testBlocks();
+	return testResult();
+}
@@ -0,0 +1,189 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="spatialindextest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Spatial index tests
+// Every query against a brute force pass over the surfaces. The surfaces are axis aligned rectangles on
+// an integer grid, so their bounds are exact in float and the brute force needs no tolerance; the query
+// coordinates are off the grid to keep away from ties. The large set is built in parallel.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "check.hxx"
+#include "geometrystore.hxx"
+#include "nodearena.hxx"
+#include "spatialindex.hxx"
+#include "threadpool.hxx"
+
+using namespace sti;
+
+namespace
+{
+	struct Box
+	{
+		long id;
+		double min[3];
+		double max[3];
+	};
+
+	// squared distance from the point to the box, 0 inside
+	double boxDistance2(const Box& box, const double point[3])
+	{
+		double d2 = 0.0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double d = std::max(std::max(box.min[axis] - point[axis], point[axis] - box.max[axis]), 0.0);
+			d2 += d * d;
+		}
+		return d2;
+	}
+
+	std::vector<long> sortedIds(SurfaceSet* set)
+	{
+		std::vector<long> ids(set->size());
+		if (!ids.empty()) set->copySurfaceIds(ids.data());
+		std::sort(ids.begin(), ids.end());
+		delete set;
+		return ids;
+	}
+
+	void testQueries(int count, WorkStealingPool* pool)
+	{
+		std::mt19937 random(count);
+		auto uniform = [&](int low, int high) { return std::uniform_int_distribution<int>(low, high)(random); };
+
+		NodeArena arena;
+		GeometryStore geometry;
+		std::vector<Box> boxes;
+		for (int i = 0; i < count; i++)
+		{
+			Rectangle* rectangle = arena.create<Rectangle>();
+			rectangle->id = i + 1;
+			double x = uniform(0, 99), y = uniform(0, 99), z = uniform(0, 99);
+			double width = uniform(1, 4), height = uniform(1, 4);
+			rectangle->P1.x = x;
+			rectangle->P1.y = y;
+			rectangle->P1.z = z;
+			rectangle->P2 = rectangle->P1;
+			rectangle->P2.x = x + width;
+			rectangle->P3 = rectangle->P1;
+			rectangle->P3.y = y + height;
+			geometry.addSurface(rectangle);
+			boxes.push_back({ rectangle->id, { x, y, z }, { x + width, y + height, z } });
+		}
+
+		SpatialIndex index;
+		index.build(geometry, pool);
+		CHECK(index.isBuilt());
+		CHECK(index.surfaceCount() == count);
+
+		auto offGrid = [&](int low, int high) { return uniform(low, high) + 0.25; };
+		for (int query = 0; query < 200; query++)
+		{
+			double min[3], max[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = offGrid(-5, 100);
+				max[axis] = min[axis] + uniform(0, 20) + 0.5;
+			}
+			std::vector<long> expected;
+			for (const Box& box : boxes)
+			{
+				bool overlaps = true;
+				for (int axis = 0; axis < 3; axis++)
+				{
+					overlaps = overlaps && box.min[axis] <= max[axis] && box.max[axis] >= min[axis];
+				}
+				if (overlaps) expected.push_back(box.id);
+			}
+			CHECK(sortedIds(index.findInBox(min[0], min[1], min[2], max[0], max[1], max[2])) == expected);
+
+			const double point[3] = { offGrid(-5, 105), offGrid(-5, 105), offGrid(-5, 105) };
+			double radius = uniform(1, 8) + 0.3;
+			expected.clear();
+			double nearest = std::numeric_limits<double>::infinity();
+			for (const Box& box : boxes)
+			{
+				double d2 = boxDistance2(box, point);
+				if (d2 <= radius * radius) expected.push_back(box.id);
+				nearest = std::min(nearest, d2);
+			}
+			CHECK(sortedIds(index.findNear(point[0], point[1], point[2], radius)) == expected);
+
+			// the rectangles are their own bounds, compare the distances: several can be the nearest
+			long found = index.findNearest(point[0], point[1], point[2]);
+			CHECK(found > 0 && found <= count);
+			if (found > 0 && found <= count)
+			{
+				CHECK(test::near(boxDistance2(boxes[found - 1], point), nearest, 1e-9));
+			}
+
+			// straight down from above: the highest rectangle under the point
+			double hitZ = -1.0;
+			long hitId = 0;
+			for (const Box& box : boxes)
+			{
+				bool under = box.min[0] <= point[0] && point[0] <= box.max[0] && box.min[1] <= point[1] && point[1] <= box.max[1];
+				if (under && box.min[2] > hitZ)
+				{
+					hitZ = box.min[2];
+					hitId = box.id;
+				}
+			}
+			RayHit hit;
+			bool hasHit = index.raycast(point[0], point[1], 200.0, 0.0, 0.0, -1.0, &hit);
+			CHECK(hasHit == (hitId != 0));
+			if (hasHit && hitId != 0)
+			{
+				CHECK_NEAR(hit.distance, 200.0 - hitZ, 1e-9);
+				CHECK(boxes[hit.surfaceId - 1].min[2] == hitZ);
+			}
+		}
+	}
+
+	void testEmpty()
+	{
+		GeometryStore geometry;
+		SpatialIndex index;
+		index.build(geometry, nullptr);
+		CHECK(index.surfaceCount() == 0);
+		CHECK(index.findNearest(0, 0, 0) == 0);
+		CHECK(sortedIds(index.findInBox(-1, -1, -1, 1, 1, 1)).empty());
+		RayHit hit;
+		CHECK(!index.raycast(0, 0, 0, 1, 0, 0, &hit));
+		CHECK(hit.surfaceId == 0);
+	}
+}
+
+int main()
+{
+	testEmpty();
+	testQueries(300, nullptr);
+	WorkStealingPool pool(4);
+	testQueries(20000, &pool);
+	return testResult();
+}
@@ -0,0 +1,110 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="stringpooltest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// String pool tests
+// One copy per text, ids that round trip, handles that survive a swap, and the same ids whatever the
+// thread interning a text first.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hxx"
+#include "stringpool.hxx"
+
+using namespace sti;
+
+namespace
+{
+	void testInterning()
+	{
+		StringPool pool;
+		PooledString first = pool.intern("Node on Face");
+		PooledString second = pool.intern(std::string("Node on ") + "Face");
+		CHECK(first == second);
+		CHECK(first.c_str() == second.c_str());
+		CHECK(first == "Node on Face" && first != "Node");
+		CHECK(pool.count() == 1);
+
+		int id = pool.internId("Mgm_face");
+		CHECK(pool.internId("Mgm_face") == id);
+		CHECK(pool.get(id) == "Mgm_face");
+		CHECK(pool.get(id).c_str() == pool.intern("Mgm_face").c_str());
+		CHECK(pool.count() == 2);
+
+		// the empty text is not stored, unknown ids give it
+		PooledString empty;
+		CHECK(empty.empty() && empty.str().empty());
+		CHECK(pool.intern("").empty());
+		CHECK(pool.get(-1).empty());
+		CHECK(pool.get(id + (1 << 20)).empty());
+		CHECK(pool.count() == 2);
+
+		StringPool other;
+		pool.swap(other);
+		CHECK(pool.count() == 0 && other.count() == 2);
+		CHECK(first == "Node on Face");
+		CHECK(other.intern("Node on Face").c_str() == first.c_str());
+	}
+
+	void testThreads()
+	{
+		const int Threads = 8, Texts = 2048;
+		StringPool pool;
+		std::vector<std::vector<int>> ids(Threads, std::vector<int>(Texts));
+		std::vector<std::thread> threads;
+		for (int thread = 0; thread < Threads; thread++)
+		{
+			threads.emplace_back([&pool, &ids, thread]
+				{
+					// every thread in its own order, the odd factors are prime to Texts
+					for (int i = 0; i < Texts; i++)
+					{
+						int text = (i * (2 * thread + 1)) % Texts;
+						ids[thread][text] = pool.internId("text " + std::to_string(text));
+					}
+				});
+		}
+		for (std::thread& thread : threads) thread.join();
+
+		CHECK(pool.count() == (size_t)Texts);
+		int mismatches = 0;
+		for (int text = 0; text < Texts; text++)
+		{
+			for (int thread = 1; thread < Threads; thread++)
+			{
+				if (ids[thread][text] != ids[0][text]) mismatches++;
+			}
+			if (pool.get(ids[0][text]) != "text " + std::to_string(text)) mismatches++;
+		}
+		CHECK(mismatches == 0);
+	}
+}
+
+int main()
+{
+	testInterning();
+	testThreads();
+	return testResult();
+}
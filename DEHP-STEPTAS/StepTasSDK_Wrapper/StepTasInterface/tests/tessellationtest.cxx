@@ -0,0 +1,289 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="tessellationtest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+
+// DEHP STEP-TAS Adapter
+// Tessellation tests
+// Buffer sizes from the meshing counts and the refinement, triangles that turn around the vertex normals
+// and cover the surface area, curved vertices on their primitive, the same buffers from the serial and the
+// parallel build, and the face map in the dir1 first cell order.
+
+#include <cmath>
+#include <cstring>
+
+#include "check.hxx"
+#include "geometrystore.hxx"
+#include "nodearena.hxx"
+#include "stringpool.hxx"
+#include "tessellation.hxx"
+#include "threadpool.hxx"
+
+using namespace sti;
+
+namespace
+{
+	const double Pi = 3.14159265358979323846;
+
+	Point3D point(double x, double y, double z)
+	{
+		Point3D p;
+		p.x = x;
+		p.y = y;
+		p.z = z;
+		return p;
+	}
+
+	struct Model
+	{
+		NodeArena arena;
+		GeometryStore geometry;
+		TasNode* root;
+
+		Model() : root(arena.create<TasNode>()) {}
+
+		template <class T>
+		T* add(long id)
+		{
+			T* surface = arena.create<T>();
+			surface->id = id;
+			root->addChild(surface);
+			return surface;
+		}
+
+		// the store copies the surfaces, once they are filled
+		void fillGeometry()
+		{
+			for (TasNode* surface : root->Children) geometry.addSurface(static_cast<BoundedSurface*>(surface));
+		}
+	};
+
+	const float* vertex(Tessellation& mesh, unsigned int index)
+	{
+		return mesh.vertexData() + (size_t)index * Tessellation::VertexStride;
+	}
+
+	// sum of the triangle areas of a surface; every triangle turns counter-clockwise around its vertex normals
+	double surfaceArea(Tessellation& mesh, int surface, bool& oriented)
+	{
+		double area = 0.0;
+		int last = (surface + 1 < mesh.surfaceCount()) ? mesh.getIndexOffset(surface + 1) : mesh.indexCount();
+		for (int i = mesh.getIndexOffset(surface); i < last; i += 3)
+		{
+			const float* a = vertex(mesh, mesh.indexData()[i]);
+			const float* b = vertex(mesh, mesh.indexData()[i + 1]);
+			const float* c = vertex(mesh, mesh.indexData()[i + 2]);
+			double u[3], v[3], n[3];
+			for (int k = 0; k < 3; k++)
+			{
+				u[k] = b[k] - a[k];
+				v[k] = c[k] - a[k];
+			}
+			n[0] = u[1] * v[2] - u[2] * v[1];
+			n[1] = u[2] * v[0] - u[0] * v[2];
+			n[2] = u[0] * v[1] - u[1] * v[0];
+			double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			area += 0.5 * length;
+			if (length > 1e-9 && n[0] * a[3] + n[1] * a[4] + n[2] * a[5] <= 0.0) oriented = false;
+		}
+		return area;
+	}
+
+	void testPlanar()
+	{
+		Model model;
+		Rectangle* rectangle = model.add<Rectangle>(1);
+		rectangle->P2 = point(2, 0, 0);
+		rectangle->P3 = point(0, 3, 0);
+		rectangle->dir1_meshing = 2;
+		rectangle->dir2_meshing = 3;
+		Triangle* triangle = model.add<Triangle>(2);
+		triangle->P1 = point(0, 0, 1);
+		triangle->P2 = point(4, 0, 1);
+		triangle->P3 = point(0, 0, 2);
+
+		TessellationOptions options;
+		options.refinement = 2;
+		model.fillGeometry();
+		options.resolution = 5;
+		Tessellation mesh;
+		mesh.build(model.root, model.geometry, options, nullptr);
+		CHECK(mesh.surfaceCount() == 2);
+		int r = mesh.findSurface(1), t = mesh.findSurface(2);
+		CHECK(r >= 0 && t >= 0 && mesh.findSurface(3) == -1);
+		// (2 x 3 cells) x (2 x 2 squares) for the rectangle, (5 x 5) x (2 x 2) for the triangle
+		CHECK(mesh.vertexCount() == 5 * 7 + 11 * 11);
+		CHECK(mesh.indexCount() == 6 * (24 + 100));
+		CHECK(mesh.getVertexOffset(r) == 0 && mesh.getIndexOffset(t) == 6 * 24);
+
+		bool oriented = true;
+		CHECK_NEAR(surfaceArea(mesh, r, oriented), 6.0, 1e-6);
+		CHECK_NEAR(surfaceArea(mesh, t, oriented), 2.0, 1e-6);
+		CHECK(oriented);
+		// the rectangle normal is +z, the triangle one -y
+		CHECK(vertex(mesh, 0)[5] == 1.0f);
+		CHECK(vertex(mesh, mesh.getVertexOffset(t))[4] == -1.0f);
+
+		// without the meshing both directions use the resolution
+		options.useMeshing = false;
+		Tessellation coarse;
+		coarse.build(model.root, model.geometry, options, nullptr);
+		CHECK(coarse.indexCount() == 2 * 6 * 25);
+	}
+
+	void testCurved()
+	{
+		Model model;
+		Cylinder* cylinder = model.add<Cylinder>(1);
+		cylinder->P2 = point(0, 0, 2);
+		cylinder->P3 = point(1, 0, 0);
+		cylinder->Radius = 1.5;
+		cylinder->EndAngle = 360.0;
+		Sphere* sphere = model.add<Sphere>(2);
+		sphere->P1 = point(5, 0, 0);
+		sphere->P2 = point(5, 0, 1);
+		sphere->P3 = point(6, 0, 0);
+		sphere->Radius = 2.0;
+		sphere->BaseTruncation = -2.0;
+		sphere->ApexTruncation = 2.0;
+		sphere->StartAngle = 90.0;
+		sphere->EndAngle = 180.0;
+
+		TessellationOptions options;
+		model.fillGeometry();
+		options.resolution = 256;
+		Tessellation mesh;
+		mesh.build(model.root, model.geometry, options, nullptr);
+
+		int c = mesh.findSurface(1), s = mesh.findSurface(2);
+		bool onSurface = true;
+		for (int i = mesh.getVertexOffset(c); i < mesh.getVertexOffset(c) + (257 * 257); i++)
+		{
+			const float* v = vertex(mesh, i);
+			double radius = std::sqrt(v[0] * v[0] + v[1] * v[1]);
+			onSurface = onSurface && std::fabs(radius - 1.5) < 1e-5 && v[2] >= -1e-6 && v[2] <= 2 + 1e-6;
+			// the normal points away from the axis
+			onSurface = onSurface && std::fabs(v[3] * v[0] + v[4] * v[1] - radius) < 1e-4;
+		}
+		CHECK(onSurface);
+		// the first vertex is at angle 0, towards P3
+		CHECK_NEAR(vertex(mesh, mesh.getVertexOffset(c))[0], 1.5, 1e-6);
+
+		bool oriented = true;
+		CHECK_NEAR(surfaceArea(mesh, c, oriented), 2 * Pi * 1.5 * 2, 1e-3);
+		// a quarter of the sphere, between the angles 90 and 180: x <= 5, y >= 0
+		CHECK_NEAR(surfaceArea(mesh, s, oriented), Pi * 2 * 2, 1e-3);
+		CHECK(oriented);
+		for (int i = mesh.getVertexOffset(s); i < mesh.getVertexOffset(s) + (257 * 257); i++)
+		{
+			const float* v = vertex(mesh, i);
+			onSurface = onSurface && v[0] <= 5 + 1e-5 && v[1] >= -1e-5;
+		}
+		CHECK(onSurface);
+	}
+
+	void testParallel()
+	{
+		Model model;
+		for (int i = 0; i < 500; i++)
+		{
+			Cone* cone = model.add<Cone>(10 + i);
+			cone->P1 = point(i, 0, 0);
+			cone->P2 = point(i, 0, 1);
+			cone->P3 = point(i + 1, 0, 0);
+			cone->Radius1 = 1.0;
+			cone->Radius2 = 0.5;
+			cone->StartAngle = i % 360;
+			cone->EndAngle = (i * 7) % 360;
+			cone->dir1_meshing = 1 + i % 4;
+		}
+
+		TessellationOptions options;
+		model.fillGeometry();
+		options.resolution = 6;
+		Tessellation serial, parallel;
+		serial.build(model.root, model.geometry, options, nullptr);
+		WorkStealingPool pool(4);
+		parallel.build(model.root, model.geometry, options, &pool);
+		CHECK(serial.vertexCount() == parallel.vertexCount() && serial.indexCount() == parallel.indexCount());
+		CHECK(std::memcmp(serial.vertexData(), parallel.vertexData(),
+			sizeof(float) * Tessellation::VertexStride * serial.vertexCount()) == 0);
+		CHECK(std::memcmp(serial.indexData(), parallel.indexData(), sizeof(unsigned int) * serial.indexCount()) == 0);
+	}
+
+	void testFaceMap()
+	{
+		Model model;
+		StringPool strings;
+		Quadrilateral* quad = model.add<Quadrilateral>(1);
+		quad->P2 = point(3, 0, 0);
+		quad->P3 = point(3, 2, 0);
+		quad->P4 = point(0, 2, 0);
+		quad->dir1_meshing = 3;
+		quad->dir2_meshing = 2;
+		Side* side = model.arena.create<Side>();
+		side->faces.setStrings(&strings);
+		for (int face = 0; face < 6; face++) side->faces.add(100 + face, -1, -1, -1);
+		quad->addChild(side);
+		// a face count that is not the cell count is left out
+		Side* other = model.arena.create<Side>();
+		other->faces.add(200, -1, -1, -1);
+		quad->addChild(other);
+
+		TessellationOptions options;
+		model.fillGeometry();
+		options.refinement = 2;
+		Tessellation unmapped;
+		unmapped.build(model.root, model.geometry, options, nullptr);
+		CHECK(unmapped.faceCount() == 0);
+
+		options.mapFaces = true;
+		Tessellation mesh;
+		mesh.build(model.root, model.geometry, options, nullptr);
+		CHECK(mesh.faceCount() == 6);
+		CHECK(mesh.findFace(200) == -1);
+		// face 104 is the cell (1, 1) of a 3 x 2 grid, eight triangles per cell
+		int face = mesh.findFace(104);
+		CHECK(face == 4 && mesh.getFaceId(face) == 104);
+		CHECK(mesh.getFaceFirstTriangle(face) == 4 * 8 && mesh.getFaceTriangleCount(face) == 8);
+		// its triangles lie in the cell [1, 2] x [1, 2]
+		bool inCell = true;
+		for (int triangle = mesh.getFaceFirstTriangle(face); triangle < mesh.getFaceFirstTriangle(face) + 8; triangle++)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				const float* v = vertex(mesh, mesh.indexData()[3 * triangle + k]);
+				inCell = inCell && v[0] >= 1 - 1e-6 && v[0] <= 2 + 1e-6 && v[1] >= 1 - 1e-6 && v[1] <= 2 + 1e-6;
+			}
+		}
+		CHECK(inCell);
+	}
+}
+
+int main()
+{
+	testPlanar();
+	testCurved();
+	testParallel();
+	testFaceMap();
+	return testResult();
+}
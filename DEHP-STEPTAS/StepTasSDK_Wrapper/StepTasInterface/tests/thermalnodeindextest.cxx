@@ -0,0 +1,176 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="thermalnodeindextest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+
+// DEHP STEP-TAS Adapter
+// Thermal node index tests
+// Network nodes numbered in order of first appearance, the faces of each network node, the distinct
+// network nodes under an element from its face range, faces created after the index was finalized, and the
+// sides registered by a parallel fragment.
+
+#include <utility>
+#include <vector>
+
+#include "check.hxx"
+#include "interface.hxx"
+#include "nodearena.hxx"
+#include "stringpool.hxx"
+#include "thermalnodeindex.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// creates the Face nodes of a side like FileInterface::materializeFaces
+	class FaceExpander : public NodeExpander
+	{
+	public:
+		explicit FaceExpander(NodeArena& arena) : m_arena(arena) {}
+
+		void expandNode(TasNode* node) override
+		{
+			Side* side = static_cast<Side*>(node);
+			for (int row = 0; row < side->faces.size(); row++)
+			{
+				Face* face = m_arena.create<Face>();
+				side->addChild(face);
+				face->name = side->faces.text(side->faces.getNetworkNodeId(row));
+				face->id = side->faces.getFaceId(row);
+			}
+		}
+
+	private:
+		NodeArena& m_arena;
+	};
+
+	struct Model
+	{
+		NodeArena arena;
+		StringPool strings;
+		FaceExpander expander{ arena };
+		TasNode* root = arena.create<TasNode>();
+
+		TasNode* compound(const char* name)
+		{
+			TasNode* node = arena.create<TasNode>();
+			node->name = strings.intern(name);
+			root->addChild(node);
+			return node;
+		}
+
+		// a meshed surface under parent with one side; each face is a (model, network node) pair, an
+		// empty name for a face without a network node
+		Side* side(TasNode* parent, const char* name, std::vector<std::pair<const char*, const char*>> faces)
+		{
+			Rectangle* surface = arena.create<Rectangle>();
+			surface->name = strings.intern(name);
+			parent->addChild(surface);
+			Side* side = arena.create<Side>();
+			surface->addChild(side);
+			side->faces.setStrings(&strings);
+			for (auto& face : faces)
+			{
+				bool hasNode = face.second[0] != '\0';
+				side->faces.add(0, hasNode ? strings.internId(face.second) : -1, hasNode ? strings.internId(face.first) : -1,
+					strings.internId("MGM_FACE"));
+			}
+			side->pendingExpansion = &expander;
+			return side;
+		}
+	};
+
+	void testIndex()
+	{
+		Model model;
+		TasNode* a = model.compound("A");
+		TasNode* b = model.compound("B");
+		Side* s1 = model.side(a, "S1", { { "m", "N1" }, { "m", "N2" }, { "", "" } });
+		Side* s2 = model.side(a, "S2", { { "m", "N1" }, { "other", "N1" } });
+		Side* s3 = model.side(b, "S3", { { "m", "N2" } });
+		Side* empty = model.side(b, "S4", {});
+
+		ThermalNodeIndex index;
+		index.addFaces(s1, s1->parent);
+		index.addFaces(s2, s2->parent);
+		index.addFaces(empty, empty->parent);
+		// a parallel fragment registers its sides in its own index
+		ThermalNodeIndex fragment;
+		fragment.addFaces(s3, s3->parent);
+		index.append(fragment);
+		CHECK(!index.isFinalized());
+		index.finalize(model.root);
+		CHECK(index.isFinalized());
+
+		CHECK(index.networkNodeCount() == 3);
+		CHECK(index.getNetworkNodeName(0) == "N1" && index.getNetworkNodeModel(0) == "m");
+		CHECK(index.getNetworkNodeModel(2) == "other" && index.getNetworkNodeName(3).empty());
+		CHECK(index.findNetworkNode("m", "N2") == 1 && index.findNetworkNode("x", "N1") == -1);
+
+		CHECK(index.faceCount(0) == 2 && index.faceCount(1) == 2 && index.faceCount(2) == 1 && index.faceCount(5) == 0);
+		CHECK(index.getFaceSurface(0, 1) == s2->parent && index.getFaceSurface(1, 1) == s3->parent);
+		// the face nodes are only created when a face is returned
+		CHECK(s3->Children.empty());
+		TasNode* face = index.getFace(1, 1);
+		CHECK(face != nullptr && face->parent == s3 && face->name.str() == "N2");
+		CHECK(index.getFace(1, 2) == nullptr);
+
+		ThermalNodeSet* nodes = index.getThermalNodes(a);
+		CHECK(nodes->size() == 4);
+		CHECK(nodes->getNetworkNodeName(1) == "N2" && nodes->getMeshedSurfaceName(1) == "S1");
+		CHECK(nodes->getModel(3) == "other" && nodes->getMeshedSurface(3) == s2->parent);
+		CHECK(nodes->getNetworkNode(4) == -1 && nodes->getMeshedSurface(-1) == nullptr);
+		CHECK(index.getThermalNodes(a) == nodes);
+		CHECK(index.getThermalNodes(b)->size() == 1);
+		CHECK(index.getThermalNodes(model.root)->size() == 5);
+		CHECK(index.getThermalNodes(s1)->size() == 2);
+	}
+
+	// faces created after finalize are found back in the range of their side
+	void testLateFaces()
+	{
+		Model model;
+		TasNode* a = model.compound("A");
+		Side* side = model.side(a, "S1", { { "m", "N1" }, { "", "" }, { "m", "N2" } });
+		ThermalNodeIndex index;
+		index.addFaces(side, side->parent);
+		index.finalize(model.root);
+
+		std::vector<TasNode*>& faces = side->children();
+		CHECK(faces.size() == 3);
+		ThermalNodeSet* last = index.getThermalNodes(faces[2]);
+		CHECK(last->size() == 1 && last->getNetworkNodeName(0) == "N2");
+		CHECK(index.getThermalNodes(faces[1])->size() == 0);
+		CHECK(index.getThermalNodes(faces[0])->getNetworkNode(0) == 0);
+
+		// an element outside the tree has no network node
+		TasNode* outside = model.arena.create<TasNode>();
+		CHECK(index.getThermalNodes(outside)->size() == 0);
+	}
+}
+
+int main()
+{
+	testIndex();
+	testLateFaces();
+	return testResult();
+}
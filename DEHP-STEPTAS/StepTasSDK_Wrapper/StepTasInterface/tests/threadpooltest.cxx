@@ -0,0 +1,176 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="threadpooltest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Thread pool tests
+// Every task of a group runs before wait returns, nested groups waited from inside a task, the first
+// exception of a group rethrown by wait, a group destroyed during unwinding, and a wait that leaves the
+// tasks of other groups alone.
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.hxx"
+#include "threadpool.hxx"
+
+namespace
+{
+	void testRun()
+	{
+		WorkStealingPool pool(4);
+		CHECK(pool.threadCount() == 4);
+
+		std::vector<int> values(10000, 0);
+		TaskGroup group(pool);
+		for (int i = 0; i < (int)values.size(); i++)
+		{
+			group.run([&values, i] { values[i] = i * 2; });
+		}
+		group.wait();
+		bool all = true;
+		for (int i = 0; i < (int)values.size(); i++) all = all && values[i] == i * 2;
+		CHECK(all);
+
+		// the group can be used again
+		std::atomic<int> count{ 0 };
+		for (int i = 0; i < 100; i++) group.run([&count] { count++; });
+		group.wait();
+		CHECK(count == 100);
+
+		// waiting on an empty group returns at once
+		TaskGroup empty(pool);
+		empty.wait();
+	}
+
+	// each task waits on a group of its own, which must not starve a small pool
+	void testNested()
+	{
+		WorkStealingPool pool(2);
+		std::atomic<int> leaves{ 0 };
+		TaskGroup outer(pool);
+		for (int i = 0; i < 16; i++)
+		{
+			outer.run([&pool, &leaves] {
+				TaskGroup inner(pool);
+				for (int j = 0; j < 16; j++) inner.run([&leaves] { leaves++; });
+				inner.wait();
+			});
+		}
+		outer.wait();
+		CHECK(leaves == 256);
+	}
+
+	void testError()
+	{
+		WorkStealingPool pool(3);
+		std::atomic<int> count{ 0 };
+		TaskGroup group(pool);
+		for (int i = 0; i < 50; i++)
+		{
+			group.run([&count, i] {
+				count++;
+				if (i % 10 == 3) throw std::runtime_error("task");
+			});
+		}
+		bool thrown = false;
+		try
+		{
+			group.wait();
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+		CHECK(thrown);
+		// the other tasks still ran, and the error is only reported once
+		CHECK(count == 50);
+		group.wait();
+	}
+
+	// the destructor only drains: a task error during unwinding must not terminate
+	void testUnwinding()
+	{
+		WorkStealingPool pool(2);
+		std::atomic<int> count{ 0 };
+		bool caught = false;
+		try
+		{
+			TaskGroup group(pool);
+			for (int i = 0; i < 20; i++)
+			{
+				group.run([&count] {
+					count++;
+					throw std::runtime_error("task");
+				});
+			}
+			throw std::logic_error("caller");
+		}
+		catch (const std::logic_error&)
+		{
+			caught = true;
+		}
+		CHECK(caught);
+		CHECK(count == 20);
+	}
+
+	// the only worker is held busy, so the waiting thread runs its own tasks and must skip the other group
+	void testGroupOnly()
+	{
+		WorkStealingPool pool(1);
+		std::atomic<bool> started{ false };
+		std::atomic<bool> release{ false };
+		TaskGroup blocker(pool);
+		blocker.run([&started, &release] {
+			started = true;
+			while (!release) std::this_thread::yield();
+		});
+		while (!started) std::this_thread::yield();
+
+		std::atomic<bool> otherRan{ false };
+		TaskGroup other(pool);
+		other.run([&otherRan] { otherRan = true; });
+		std::atomic<int> count{ 0 };
+		TaskGroup own(pool);
+		for (int i = 0; i < 10; i++) own.run([&count] { count++; });
+		own.wait();
+		CHECK(count == 10);
+		CHECK(!otherRan);
+
+		release = true;
+		blocker.wait();
+		other.wait();
+		CHECK(otherRan);
+	}
+}
+
+int main()
+{
+	testRun();
+	testNested();
+	testError();
+	testUnwinding();
+	testGroupOnly();
+	return testResult();
+}
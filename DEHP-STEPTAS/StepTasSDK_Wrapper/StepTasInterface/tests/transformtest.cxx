@@ -0,0 +1,128 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="transformtest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Transformation tests
+// Composition order of the matrices and transformPoints against Transform::apply, on point counts that
+// leave a scalar tail after the AVX2 kernel.
+
+#include <cmath>
+#include <vector>
+
+#include "check.hxx"
+#include "transform.hxx"
+
+using namespace sti;
+
+namespace
+{
+	const double Pi = 3.14159265358979323846;
+
+	Direction direction(double x, double y, double z)
+	{
+		Direction d;
+		d.x = x;
+		d.y = y;
+		d.z = z;
+		return d;
+	}
+
+	Point3D point(double x, double y, double z)
+	{
+		Point3D p;
+		p.x = x;
+		p.y = y;
+		p.z = z;
+		return p;
+	}
+
+	bool samePoint(const Point3D& a, const Point3D& b)
+	{
+		return test::near(a.x, b.x, 1e-12) && test::near(a.y, b.y, 1e-12) && test::near(a.z, b.z, 1e-12);
+	}
+
+	void testMatrices()
+	{
+		const Transform identity;
+		CHECK(identity.isIdentity());
+		CHECK(identity.get(2, 2) == 1.0);
+		CHECK(identity.get(4, 0) == 0.0);
+		CHECK(identity.get(0, -1) == 0.0);
+
+		const Transform translation = Transform::translation(1, 2, 3);
+		CHECK(!translation.isIdentity());
+		CHECK(translation.get(0, 3) == 1.0 && translation.get(1, 3) == 2.0 && translation.get(2, 3) == 3.0);
+		CHECK(samePoint(translation.apply(point(1, 1, 1)), point(2, 3, 4)));
+		// directions are not translated
+		Direction moved = translation.applyToDirection(direction(1, 0, 0));
+		CHECK(moved.x == 1.0 && moved.y == 0.0 && moved.z == 0.0);
+
+		// right handed, the axis needs not be normalized
+		const Transform rotation = Transform::rotation(direction(0, 0, 5), Pi / 2);
+		CHECK(samePoint(rotation.apply(point(1, 0, 0)), point(0, 1, 0)));
+		CHECK(samePoint(rotation.apply(point(0, 1, 7)), point(-1, 0, 7)));
+		CHECK(Transform::rotation(direction(0, 0, 0), 1.0).isIdentity());
+
+		// t * r rotates first
+		CHECK(samePoint((translation * rotation).apply(point(1, 0, 0)), point(1, 3, 3)));
+		CHECK(samePoint((rotation * translation).apply(point(1, 0, 0)), point(-2, 2, 3)));
+
+		const Transform third = Transform::rotation(direction(1, 1, 1), 2 * Pi / 3);
+		CHECK(samePoint(third.apply(point(1, 0, 0)), point(0, 1, 0)));
+		CHECK(samePoint((third * third * third).apply(point(0.3, -2, 5)), point(0.3, -2, 5)));
+	}
+
+	void testPoints()
+	{
+		const Transform t = Transform::translation(-1, 0.5, 2) * Transform::rotation(direction(1, 2, 3), 0.7);
+		for (size_t n : { 0, 1, 3, 4, 7, 8, 33 })
+		{
+			std::vector<double> x(n), y(n), z(n), outX(n), outY(n), outZ(n);
+			for (size_t i = 0; i < n; i++)
+			{
+				x[i] = 0.5 * i;
+				y[i] = 1.0 - 0.25 * i;
+				z[i] = (double)(i * i % 7);
+			}
+			transformPoints(t, x.data(), y.data(), z.data(), outX.data(), outY.data(), outZ.data(), n);
+			for (size_t i = 0; i < n; i++)
+			{
+				CHECK(samePoint(point(outX[i], outY[i], outZ[i]), t.apply(point(x[i], y[i], z[i]))));
+			}
+
+			// in place
+			transformPoints(t, x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), n);
+			for (size_t i = 0; i < n; i++)
+			{
+				CHECK(x[i] == outX[i] && y[i] == outY[i] && z[i] == outZ[i]);
+			}
+		}
+	}
+}
+
+int main()
+{
+	testMatrices();
+	testPoints();
+	return testResult();
+}
@@ -0,0 +1,219 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="treedifftest.cxx" company="Open Engineering S.A.">
+//    Copyright (c) 2026 Open Engineering S.A.
+//
+//    This file is part of DEHP STEP-TAS (STEP 3D CAD) adapter project.
+//
+//    The DEHP STEP-TAS is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU Lesser General Public
+//    License as published by the Free Software Foundation; either
+//    version 3 of the License, or (at your option) any later version.
+//
+//    The DEHP STEP-TAS is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Lesser General Public License for more details.
+//
+//    You should have received a copy of the GNU Lesser General Public License
+//    along with this program; if not, write to the Free Software Foundation,
+//    Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+// </copyright>
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// DEHP STEP-TAS Adapter
+// Tree diff tests
+// Edit scripts of small trees: identical and modified nodes, a subtree moved whole, a move found inside
+// a deleted subtree, the statuses left by an earlier diff, and sides compared without creating their faces.
+
+#include <initializer_list>
+
+#include "check.hxx"
+#include "geometrystore.hxx"
+#include "nodearena.hxx"
+#include "nodehash.hxx"
+#include "stringpool.hxx"
+#include "treediff.hxx"
+
+using namespace sti;
+
+namespace
+{
+	// the nodes, strings and hashes of one file
+	class Tree
+	{
+	public:
+		TasNode* node(const char* name, std::initializer_list<TasNode*> children = {})
+		{
+			TasNode* node = m_arena.create<TasNode>();
+			node->id = ++m_ids;
+			node->name = m_strings.intern(name);
+			for (TasNode* child : children) node->addChild(child);
+			return node;
+		}
+
+		Side* side(std::initializer_list<const char*> networkNodes)
+		{
+			Side* side = m_arena.create<Side>();
+			side->id = ++m_ids;
+			side->name = m_strings.intern("Side 1");
+			side->faces.setStrings(&m_strings);
+			for (const char* networkNode : networkNodes)
+			{
+				side->faces.add(++m_ids, m_strings.internId(networkNode), m_strings.internId("M"), m_strings.internId("Mgm_face"));
+			}
+			return side;
+		}
+
+		PooledString text(const char* value)
+		{
+			return m_strings.intern(value);
+		}
+
+		const NodeHashes& hashes(TasNode* root)
+		{
+			m_hashes.build(root, m_geometry);
+			return m_hashes;
+		}
+
+	private:
+		NodeArena m_arena;
+		StringPool m_strings;
+		GeometryStore m_geometry;
+		NodeHashes m_hashes;
+		long m_ids = 0;
+	};
+
+	TreeDiff diff(Tree& first, TasNode* firstRoot, Tree& second, TasNode* secondRoot)
+	{
+		return TreeDiff::compute(firstRoot, first.hashes(firstRoot), secondRoot, second.hashes(secondRoot));
+	}
+
+	int countKind(TreeDiff& script, DiffKind kind)
+	{
+		int count = 0;
+		for (int i = 0; i < script.size(); i++)
+		{
+			if (script.getKind(i) == kind) count++;
+		}
+		return count;
+	}
+
+	void testIdentical()
+	{
+		Tree first, second;
+		TasNode* a = first.node("root", { first.node("A", { first.node("c") }), first.node("B") });
+		TasNode* b = second.node("root", { second.node("A", { second.node("c") }), second.node("B") });
+		TreeDiff script = diff(first, a, second, b);
+		CHECK(script.size() == 0);
+		CHECK(script.identicalSubtrees() == 1);
+	}
+
+	void testModified()
+	{
+		Tree first, second;
+		TasNode* changed = first.node("A");
+		changed->description = first.text("old");
+		TasNode* a = first.node("root", { changed, first.node("B") });
+		TasNode* changedAgain = second.node("A");
+		changedAgain->description = second.text("new");
+		TasNode* b = second.node("root", { changedAgain, second.node("B") });
+
+		TreeDiff script = diff(first, a, second, b);
+		CHECK(script.size() == 1);
+		CHECK(script.getKind(0) == DIFF_MODIFIED);
+		CHECK(script.getFirst(0) == changed && script.getSecond(0) == changedAgain);
+		CHECK(changed->status == Modified && changedAgain->status == Modified);
+		// the roots only differ below, B is skipped
+		CHECK(a->status == Unchanged && b->status == Unchanged);
+		CHECK(script.identicalSubtrees() == 1);
+	}
+
+	// D and its child move from A to B: one move, nothing inside D is reported
+	void testWholeMove()
+	{
+		Tree first, second;
+		TasNode* c = first.node("c");
+		TasNode* d = first.node("D", { c });
+		TasNode* a = first.node("root", { first.node("A", { d }), first.node("B") });
+		TasNode* c2 = second.node("c");
+		TasNode* d2 = second.node("D", { c2 });
+		TasNode* b = second.node("root", { second.node("A"), second.node("B", { d2 }) });
+
+		TreeDiff script = diff(first, a, second, b);
+		CHECK(script.size() == 1);
+		CHECK(script.getKind(0) == DIFF_MOVED);
+		CHECK(script.getFirst(0) == d && script.getSecond(0) == d2);
+		CHECK(d->status == Moved && d2->status == Moved);
+		CHECK(c->status == Unchanged && c2->status == Unchanged);
+	}
+
+	// c is found again under the added P before D itself could move to Q: D is deleted without c, and
+	// D2 cannot take D any more, the path from c to its deleted root goes with the move
+	void testMoveInsideDeleted()
+	{
+		Tree first, second;
+		TasNode* c = first.node("c");
+		TasNode* d = first.node("D", { c });
+		TasNode* a = first.node("root", { d, first.node("x") });
+		TasNode* c1 = second.node("c");
+		TasNode* p = second.node("P", { c1 });
+		TasNode* c2 = second.node("c");
+		TasNode* d2 = second.node("D", { c2 });
+		TasNode* q = second.node("Q", { d2 });
+		TasNode* b = second.node("root", { p, q, second.node("x") });
+
+		// marks of an earlier diff
+		a->status = Modified;
+		c2->status = Deleted;
+
+		TreeDiff script = diff(first, a, second, b);
+		CHECK(script.size() == 4);
+		CHECK(countKind(script, DIFF_MOVED) == 1);
+		CHECK(countKind(script, DIFF_ADDED) == 2);
+		CHECK(countKind(script, DIFF_DELETED) == 1);
+		for (int i = 0; i < script.size(); i++)
+		{
+			if (script.getKind(i) == DIFF_MOVED) CHECK(script.getFirst(i) == c && script.getSecond(i) == c1);
+			if (script.getKind(i) == DIFF_DELETED) CHECK(script.getFirst(i) == d);
+			if (script.getKind(i) == DIFF_ADDED) CHECK(script.getSecond(i) == p || script.getSecond(i) == q);
+		}
+		CHECK(a->status == Unchanged && b->status == Unchanged);
+		CHECK(d->status == Deleted && c->status == Moved);
+		CHECK(p->status == Added && c1->status == Moved);
+		CHECK(q->status == Added && d2->status == Added && c2->status == Added);
+	}
+
+	// the sides are compared on their face tables, no Face node is created
+	void testSides()
+	{
+		Tree first, second;
+		Side* side = first.side({ "N1", "N2" });
+		Side* deletedSide = first.side({ "N3" });
+		TasNode* a = first.node("root", { first.node("A", { side }), first.node("B", { deletedSide }) });
+		Side* movedSide = second.side({ "N1", "N2" });
+		Side* changedSide = second.side({ "N1", "N4" });
+		TasNode* b = second.node("root", { second.node("A"), second.node("B"), second.node("C", { movedSide }),
+			second.node("D", { changedSide }) });
+
+		TreeDiff script = diff(first, a, second, b);
+		CHECK(countKind(script, DIFF_MOVED) == 1);
+		CHECK(countKind(script, DIFF_DELETED) == 1);
+		CHECK(countKind(script, DIFF_ADDED) == 2);
+		CHECK(side->status == Moved && movedSide->status == Moved);
+		CHECK(deletedSide->status == Deleted);
+		CHECK(changedSide->status == Added);
+		CHECK(side->Children.empty() && deletedSide->Children.empty());
+		CHECK(movedSide->Children.empty() && changedSide->Children.empty());
+	}
+}
+
+int main()
+{
+	testIdentical();
+	testModified();
+	testWholeMove();
+	testMoveInsideDeleted();
+	testSides();
+	return testResult();
+}